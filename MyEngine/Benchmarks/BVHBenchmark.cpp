@@ -0,0 +1,198 @@
+//
+//  BVHBenchmark.cpp
+//  MyEngine
+//
+//  Created by Priyanshu Kaushik on 19/10/2026.
+//
+
+#include "Benchmark.h"
+#include "Math/BVH.h"
+#include <glm/gtc/matrix_transform.hpp>
+#include <cmath>
+#include <random>
+#include <vector>
+
+// Scene BVH queries against a linear scan over the same boxes. Tree results are refined with
+// the exact boxes, the way the renderer and the editor use them (leaves hold fattened boxes).
+
+namespace {
+
+constexpr float WORLD_SIZE = 2000.0f;
+constexpr int FRUSTUM_QUERIES = 64;
+constexpr int BOX_QUERIES = 1000;
+constexpr int RAY_QUERIES = 1000;
+constexpr int NEAREST_QUERIES = 1000;
+
+struct Scene
+{
+    std::vector<AABB> boxes;    // Indexed by entity
+    BVH tree;
+};
+
+void BuildScene(Scene& scene, int count, std::mt19937& rng)
+{
+    std::uniform_real_distribution<float> position(-0.5f * WORLD_SIZE, 0.5f * WORLD_SIZE);
+    std::uniform_real_distribution<float> size(0.5f, 4.0f);
+
+    scene.boxes.resize(count);
+    scene.tree.Clear();
+    for (int i = 0; i < count; i++)
+    {
+        glm::vec3 center(position(rng), 0.1f * position(rng), position(rng));
+        glm::vec3 half(size(rng), size(rng), size(rng));
+        scene.boxes[i] = AABB(center - half, center + half);
+        scene.tree.Insert((Entity)i, scene.boxes[i]);
+    }
+    scene.tree.Rebuild();
+}
+
+void RunScene(int count)
+{
+    std::mt19937 rng(1234);
+    Scene scene;
+    BuildScene(scene, count, rng);
+    const std::vector<AABB>& boxes = scene.boxes;
+
+    char title[64];
+    std::snprintf(title, sizeof(title), "BVH, %d entities", count);
+    Bench::Header(title, "linear");
+
+    std::uniform_real_distribution<float> position(-0.5f * WORLD_SIZE, 0.5f * WORLD_SIZE);
+    std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+    auto randomDirection = [&]() {
+        glm::vec3 direction(unit(rng), 0.2f * unit(rng), unit(rng));
+        return glm::length(direction) > 1e-3f ? glm::normalize(direction) : glm::vec3(1.0f, 0.0f, 0.0f);
+    };
+
+    // FRUSTUM
+    std::vector<Frustum> frustums;
+    for (int i = 0; i < FRUSTUM_QUERIES; i++)
+    {
+        glm::vec3 eye(position(rng), 10.0f, position(rng));
+        glm::mat4 view = glm::lookAt(eye, eye + randomDirection(), glm::vec3(0.0f, 1.0f, 0.0f));
+        frustums.emplace_back(glm::perspective(glm::radians(60.0f), 16.0f / 9.0f, 0.1f, 300.0f) * view);
+    }
+
+    size_t treeVisible = 0, linearVisible = 0;
+    std::vector<Entity> inside, partial;
+    double tree = Bench::Time([&]() {
+        treeVisible = 0;
+        for (const Frustum& frustum : frustums)
+        {
+            inside.clear();
+            partial.clear();
+            scene.tree.QueryFrustum(frustum, inside, &partial);
+            treeVisible += inside.size();
+            for (Entity entity : partial) treeVisible += frustum.IntersectsAABB(boxes[entity]);
+        }
+    });
+    double linear = Bench::Time([&]() {
+        linearVisible = 0;
+        for (const Frustum& frustum : frustums)
+            for (const AABB& box : boxes) linearVisible += frustum.IntersectsAABB(box);
+    });
+    Bench::Report("frustum", tree, linear);
+
+    // AABB
+    std::vector<AABB> queries;
+    for (int i = 0; i < BOX_QUERIES; i++)
+    {
+        glm::vec3 center(position(rng), 0.1f * position(rng), position(rng));
+        queries.emplace_back(center - glm::vec3(20.0f), center + glm::vec3(20.0f));
+    }
+
+    size_t treeOverlaps = 0, linearOverlaps = 0;
+    std::vector<Entity> candidates;
+    tree = Bench::Time([&]() {
+        treeOverlaps = 0;
+        for (const AABB& query : queries)
+        {
+            candidates.clear();
+            scene.tree.QueryAABB(query, candidates);
+            for (Entity entity : candidates) treeOverlaps += boxes[entity].Overlaps(query);
+        }
+    });
+    linear = Bench::Time([&]() {
+        linearOverlaps = 0;
+        for (const AABB& query : queries)
+            for (const AABB& box : boxes) linearOverlaps += box.Overlaps(query);
+    });
+    Bench::Report("aabb", tree, linear);
+
+    // RAY
+    struct Ray { glm::vec3 origin, direction; };
+    std::vector<Ray> rays;
+    for (int i = 0; i < RAY_QUERIES; i++) rays.push_back({ glm::vec3(position(rng), 5.0f, position(rng)), randomDirection() });
+    const float rayLength = 500.0f;
+
+    std::vector<Entity> treeHits(rays.size()), linearHits(rays.size());
+    tree = Bench::Time([&]() {
+        for (size_t i = 0; i < rays.size(); i++)
+        {
+            glm::vec3 invDir = 1.0f / rays[i].direction;
+            BVH::RayHit hit;
+            bool found = scene.tree.Raycast(rays[i].origin, rays[i].direction, rayLength, hit, [&](Entity entity, float& distance) {
+                return boxes[entity].IntersectsRay(rays[i].origin, invDir, rayLength, distance);
+            });
+            treeHits[i] = found ? hit.entity : UINT32_MAX;
+        }
+    });
+    linear = Bench::Time([&]() {
+        for (size_t i = 0; i < rays.size(); i++)
+        {
+            glm::vec3 invDir = 1.0f / rays[i].direction;
+            float closest = rayLength, distance;
+            linearHits[i] = UINT32_MAX;
+            for (size_t b = 0; b < boxes.size(); b++)
+            {
+                if (!boxes[b].IntersectsRay(rays[i].origin, invDir, closest, distance) || distance > closest) continue;
+                closest = distance;
+                linearHits[i] = (Entity)b;
+            }
+        }
+    });
+    Bench::Report("ray", tree, linear);
+
+    // NEAREST
+    std::vector<glm::vec3> points;
+    for (int i = 0; i < NEAREST_QUERIES; i++) points.emplace_back(position(rng), 0.1f * position(rng), position(rng));
+
+    std::vector<float> treeNearest(points.size()), linearNearest(points.size());
+    tree = Bench::Time([&]() {
+        for (size_t i = 0; i < points.size(); i++)
+        {
+            Entity entity;
+            float distance = FLT_MAX;
+            scene.tree.QueryNearest(points[i], WORLD_SIZE, entity, distance);
+            treeNearest[i] = distance;
+        }
+    });
+    linear = Bench::Time([&]() {
+        for (size_t i = 0; i < points.size(); i++)
+        {
+            float bestSq = FLT_MAX;
+            for (const AABB& box : boxes) bestSq = std::min(bestSq, box.DistanceSq(points[i]));
+            linearNearest[i] = std::sqrt(bestSq);
+        }
+    });
+    Bench::Report("nearest", tree, linear);
+
+    // Nearest distances are to the fattened leaf boxes, within the margin of the exact ones
+    size_t rayMismatches = 0, nearestMismatches = 0;
+    for (size_t i = 0; i < rays.size(); i++) rayMismatches += treeHits[i] != linearHits[i];
+    for (size_t i = 0; i < points.size(); i++) nearestMismatches += std::fabs(treeNearest[i] - linearNearest[i]) > 0.2f;
+    std::printf("  check: visible %zu / %zu, overlaps %zu / %zu, ray mismatches %zu, nearest mismatches %zu\n",
+                treeVisible, linearVisible, treeOverlaps, linearOverlaps, rayMismatches, nearestMismatches);
+}
+
+}
+
+namespace Bench {
+
+void RunBVH()
+{
+    RunScene(10000);
+    RunScene(100000);
+}
+
+}
@@ -0,0 +1,28 @@
+//
+//  BenchMain.cpp
+//  MyEngine
+//
+//  Created by Priyanshu Kaushik on 19/10/2026.
+//
+
+#include "Benchmark.h"
+#include <cstring>
+
+// Runs every suite, or only the ones named on the command line
+int main(int argc, char** argv)
+{
+    struct Suite { const char* name; void (*run)(); };
+    const Suite suites[] = {
+        { "bvh", Bench::RunBVH },
+        { "terrain", Bench::RunTerrain },
+        { "broadphase", Bench::RunBroadphase },
+    };
+
+    for (const Suite& suite : suites)
+    {
+        bool selected = argc < 2;
+        for (int i = 1; i < argc; i++) selected |= std::strcmp(argv[i], suite.name) == 0;
+        if (selected) suite.run();
+    }
+    return 0;
+}
@@ -0,0 +1,61 @@
+//
+//  Benchmark.h
+//  MyEngine
+//
+//  Created by Priyanshu Kaushik on 19/10/2026.
+//
+
+#pragma once
+#include <chrono>
+#include <cstdio>
+#include <algorithm>
+#include <cfloat>
+
+/**
+ * @brief Timing helpers of the MyEngineBenchmarks target (CMake option MYENGINE_BUILD_BENCHMARKS).
+ * * Every case runs a few times and reports its fastest run, the least noisy figure on a busy
+ * machine. Each suite also checks its fast path against the straightforward one, so a result
+ * that is quick but wrong shows up as a mismatch instead of a speedup.
+ */
+namespace Bench {
+
+constexpr int RUNS = 5;
+
+// Fastest of runs calls, in milliseconds
+template <typename Fn>
+double Time(Fn&& fn, int runs = RUNS)
+{
+    double best = DBL_MAX;
+    for (int run = 0; run < runs; run++)
+    {
+        auto start = std::chrono::high_resolution_clock::now();
+        fn();
+        auto end = std::chrono::high_resolution_clock::now();
+        best = std::min(best, std::chrono::duration<double, std::milli>(end - start).count());
+    }
+    return best;
+}
+
+// One line per case: the fast path, the baseline it replaces and the speedup
+inline void Report(const char* name, double ms, double baselineMs)
+{
+    std::printf("  %-28s %10.3f ms %10.3f ms %8.1fx\n", name, ms, baselineMs, baselineMs / std::max(ms, 1e-6));
+}
+
+// Without a baseline
+inline void Report(const char* name, double ms)
+{
+    std::printf("  %-28s %10.3f ms %13s %9s\n", name, ms, "-", "-");
+}
+
+inline void Header(const char* title, const char* baseline)
+{
+    std::printf("\n%s\n  %-28s %13s %13s %9s\n", title, "case", "time", baseline, "speedup");
+}
+
+// SUITES
+void RunBVH();
+void RunTerrain();
+void RunBroadphase();
+
+}
@@ -0,0 +1,81 @@
+//
+//  TerrainBenchmark.cpp
+//  MyEngine
+//
+//  Created by Priyanshu Kaushik on 19/10/2026.
+//
+
+#include "Benchmark.h"
+#include "ECSSystems/TerrainSystem.h"
+#include "JobSystem.h"
+#include <cmath>
+#include <cstring>
+#include <memory>
+
+// Baked terrain builds (TerrainSystem::BuildMesh: vertices, SIMD normals, skirts, bounds and
+// quadtree) on the calling thread alone against the JobSystem workers. GL upload is left out.
+
+namespace {
+
+constexpr int TERRAIN_RUNS = 3;     // The 8k build allocates gigabytes, fewer repeats
+
+// Rolling hills with some detail, normalized like a loaded heightmap
+void FillHeights(TerrainComponent& terrain, int size)
+{
+    terrain.width = terrain.height = size;
+    terrain.heightData.resize((size_t)size * size);
+    for (int z = 0; z < size; z++)
+        for (int x = 0; x < size; x++)
+        {
+            float h = 0.5f + 0.25f * std::sin(x * 0.013f) * std::cos(z * 0.011f) + 0.05f * std::sin((x + 2 * z) * 0.17f);
+            terrain.heightData[(size_t)z * size + x] = h;
+        }
+}
+
+void RunHeightmap(TerrainSystem& system, int size, bool parallelOnly)
+{
+    TerrainComponent terrain;
+    FillHeights(terrain, size);
+
+    std::unique_ptr<Vertex[]> serialVertices, parallelVertices;
+    size_t vertexCount = 0;
+    double serial = 0.0;
+    if (!parallelOnly)
+    {
+        // The workers are not started yet, ParallelFor runs every row on this thread
+        serial = Bench::Time([&]() { serialVertices.reset(); vertexCount = system.BuildMesh(&terrain, serialVertices); }, TERRAIN_RUNS);
+    }
+
+    JobSystem::Get().Init();
+    double parallel = Bench::Time([&]() { parallelVertices.reset(); vertexCount = system.BuildMesh(&terrain, parallelVertices); }, TERRAIN_RUNS);
+    JobSystem::Get().Shutdown();
+
+    char name[64];
+    std::snprintf(name, sizeof(name), "%dx%d (%.1f M vertices)", size, size, vertexCount / 1e6);
+    if (parallelOnly)
+    {
+        Bench::Report(name, parallel);
+    }
+    else
+    {
+        Bench::Report(name, parallel, serial);
+        bool same = std::memcmp(serialVertices.get(), parallelVertices.get(), vertexCount * sizeof(Vertex)) == 0;
+        std::printf("  check: %s\n", same ? "identical vertices" : "VERTICES DIFFER");
+    }
+}
+
+}
+
+namespace Bench {
+
+void RunTerrain()
+{
+    Header("Terrain mesh build", "1 thread");
+    TerrainSystem system;
+    RunHeightmap(system, 1024, false);
+    RunHeightmap(system, 4096, false);
+    // Two copies of an 8k mesh do not fit everywhere, only the threaded build is timed
+    RunHeightmap(system, 8192, true);
+}
+
+}
@@ -9,6 +9,8 @@
 #include <cstdint>
 #include <glm/glm.hpp>
 #include <vector>
+#include <string>
+#include "Math/Bounds.h"
 
 
 enum class AssetType{
@@ -29,6 +31,17 @@ struct Face {
     std::vector<uint32_t> vertexIndices;
 };
 
+// One level of detail. LOD 0 is the source mesh, higher levels are simplified
+// triangle lists that index the same vertex buffer.
+struct MeshLOD {
+    std::vector<uint32_t> indices;
+    float error = 0.0f;
+
+    // Filled on GPU upload: range of this LOD relative to Mesh::baseIndex
+    uint32_t firstIndex = 0;
+    uint32_t indexCount = 0;
+};
+
 struct BaseData{
     virtual ~BaseData() = default;
     bool IsLoaded = false;
@@ -39,10 +52,20 @@ struct BaseData{
 struct Mesh : public BaseData{
     std::vector<Vertex> vertices;
     std::vector<Face> faces;
+    std::vector<MeshLOD> lods;
+
+    // Local space bounds (computed at load)
+    AABB bounds;
+    glm::vec3 boundsCenter = glm::vec3(0.0f);
+    float boundsRadius = 0.0f;
+    
+    // Ranges inside the global MeshPool (filled on GPU upload)
+    uint32_t poolHandle = UINT32_MAX;
+    uint32_t baseVertex = 0;
+    uint32_t vertexCount = 0;
+    uint32_t baseIndex = 0;
+    uint32_t poolIndexCount = 0;    // All LODs
     
-    unsigned int VAO = 0;
-    unsigned int VBO = 0;
-    unsigned int EBO = 0;
     int indexCount = 0;
     bool uploaded = false;
 };
@@ -59,6 +82,7 @@ struct Material{
     glm::vec3 Diffuse = { 1.0f, 1.0f, 1.0f };
     glm::vec3 Specular = { 0.5f, 0.5f, 0.5f };
     float Shininess = 32.0f;
+    float Opacity = 1.0f;          // Below 1 draws in the transparent pass
 
     uint32_t albedoID = UINT32_MAX;
     uint32_t normalID  = UINT32_MAX;
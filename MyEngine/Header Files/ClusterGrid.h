@@ -0,0 +1,60 @@
+//
+//  ClusterGrid.h
+//  MyEngine
+//
+//  Created by Priyanshu Kaushik on 19/10/2026.
+//
+
+#pragma once
+#include <glm/glm.hpp>
+#include <vector>
+#include <cstdint>
+
+// Point light as seen by the clustering (view space)
+struct ClusterLight
+{
+    glm::vec3 viewPosition;
+    float range;
+};
+
+/**
+ * @class ClusterGrid
+ * @brief Froxel grid for clustered forward shading, built on the CPU each frame.
+ * * The view frustum is split into TILES_X x TILES_Y screen tiles and SLICES_Z exponential
+ * depth slices. Every light is assigned to the clusters its bounding sphere touches:
+ * the cluster range is found from the projected sphere bounds, then each candidate is
+ * tested against the cluster's view space AABB.
+ * Output is a (offset, count) pair per cluster and one flat light index list.
+ */
+class ClusterGrid {
+public:
+    static constexpr int TILES_X = 16;
+    static constexpr int TILES_Y = 9;
+    static constexpr int SLICES_Z = 24;
+    static constexpr int CLUSTER_COUNT = TILES_X * TILES_Y * SLICES_Z;
+
+    void Build(const glm::mat4& projection, const std::vector<ClusterLight>& lights);
+
+    const std::vector<uint32_t>& GetClusterRanges() const { return m_ClusterRanges; }  // offset, count per cluster
+    const std::vector<uint32_t>& GetLightIndices() const { return m_LightIndices; }
+
+    // Slice = log(viewDepth) * scale + bias (matches the shader)
+    float GetSliceScale() const { return m_SliceScale; }
+    float GetSliceBias() const { return m_SliceBias; }
+
+private:
+    void RebuildClusterBounds(const glm::mat4& projection);
+    int GetSlice(float viewDepth) const;
+
+private:
+    glm::mat4 m_Projection = glm::mat4(0.0f);
+    float m_Near = 0.1f, m_Far = 100.0f;
+    float m_SliceScale = 0.0f, m_SliceBias = 0.0f;
+
+    // View space AABB per cluster, only rebuilt when the projection changes
+    std::vector<glm::vec3> m_ClusterMin, m_ClusterMax;
+
+    std::vector<uint32_t> m_ClusterRanges;
+    std::vector<uint32_t> m_LightIndices;
+    std::vector<uint64_t> m_Pairs;   // cluster << 32 | light, scratch
+};
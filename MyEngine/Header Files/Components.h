@@ -8,6 +8,8 @@
 #pragma once
 #include <glm/glm.hpp>
 #include <memory>
+#include <algorithm>
+#include <cstdint>
 #include "AssetData.h"
 #include "AssetManager.h"
 #include "sol/sol.hpp"
@@ -21,22 +23,40 @@ struct TransformComponent
     
     bool isDirty = true;
     
+    // Render only: added to position when building the model matrix. Physics uses it to
+    // interpolate bodies between fixed steps; not saved, not part of the simulated state.
+    glm::vec3 renderOffset = {0.0f, 0.0f, 0.0f};
+    
+    // Bumped on every change. isDirty is consumed (reset) by PhysicsSystem, so other
+    // systems caching world data compare against the revision they last saw.
+    uint32_t revision = 0;
+    
     void SetPosition(const glm::vec3& newPos) {
         if(position == newPos) return;
         position = newPos;
         isDirty = true;
+        revision++;
+    }
+
+    // Does not mark the transform dirty (bounds and physics do not care), only bumps the revision
+    void SetRenderOffset(const glm::vec3& newOffset) {
+        if(renderOffset == newOffset) return;
+        renderOffset = newOffset;
+        revision++;
     }
 
     void SetRotation(const glm::vec3& newRot) {
         if(rotation == newRot) return;
         rotation = newRot;
         isDirty = true;
+        revision++;
     }
 
     void SetScale(const glm::vec3& newScale) {
         if(scale == newScale) return;
         scale = newScale;
         isDirty = true;
+        revision++;
     }
     glm::vec3 GetForward() const {
         glm::vec3 forward;
@@ -75,6 +95,12 @@ struct MeshComponent
     uint32_t meshID = UINT32_MAX;
 
     std::string meshPath  = "";
+    
+    // Cached world space data, refreshed by RenderSystem when the transform changes
+    glm::mat4 worldTransform = glm::mat4(1.0f);
+    AABB worldBounds;
+    uint32_t boundsRevision = UINT32_MAX;
+    uint32_t boundsMeshID = UINT32_MAX;
 
     static constexpr const char* TypeName = "Mesh Component";
     static constexpr const bool UniquePerEntity = true;
@@ -122,11 +148,14 @@ struct LightComponent {
 
 struct RigidBodyComponent {
     glm::vec3 velocity = glm::vec3(0.0f);
+    glm::vec3 angularVelocity = glm::vec3(0.0f);    // World space, radians per second
     glm::vec3 acceleration = glm::vec3(0.0f);
     float mass = 1.0f;
     float gravityScale = 1.0f;
     bool isStatic = false;
     bool isKinematic = false;
+    bool freezeRotation = false;                    // Contacts do not make the body turn
+    bool isBullet = false;                          // Swept each step, fast enough to tunnel otherwise
     
     void AddForce(glm::vec3 force)
     {
@@ -197,6 +226,34 @@ struct ScriptComponent
     static constexpr const bool UniquePerEntity = true;
 };
 
+// One CHUNK_VERTS x CHUNK_VERTS block of the terrain grid (see TerrainSystem)
+struct TerrainChunk {
+    AABB bounds;                // Terrain local space, skirts included
+    int32_t baseVertex = 0;     // First vertex in the terrain VBO
+    float skirtDepth = 0.0f;    // How far the skirts hang below the chunk's lowest point
+};
+
+// Heightmap texels changed since the last GPU update (inclusive), empty when minX > maxX
+struct TerrainDirtyRect {
+    int minX = INT32_MAX, minZ = INT32_MAX;
+    int maxX = -1, maxZ = -1;
+    
+    bool IsEmpty() const { return minX > maxX || minZ > maxZ; }
+    void Expand(int x0, int z0, int x1, int z1) {
+        minX = std::min(minX, x0); minZ = std::min(minZ, z0);
+        maxX = std::max(maxX, x1); maxZ = std::max(maxZ, z1);
+    }
+};
+
+// Quadtree over the chunk grid, children are -1 when absent
+struct TerrainQuadNode {
+    AABB bounds;
+    int32_t children[4] = { -1, -1, -1, -1 };
+    int32_t chunk = -1;         // Leaf only
+};
+
+class TerrainStreamer;
+
 struct TerrainComponent {
     std::string heightmapPath, mainTexturePath;
     
@@ -208,10 +265,25 @@ struct TerrainComponent {
     
     std::vector<float> heightData;
 
+    // Chunked mesh: one VBO with every chunk, indices are shared per LOD by all terrains
     unsigned int VAO = 0;
     unsigned int VBO = 0;
-    unsigned int EBO = 0;
-    unsigned int indexCount = 0;
+    int chunksX = 0;
+    int chunksZ = 0;
+    std::vector<TerrainChunk> chunks;
+    std::vector<TerrainQuadNode> quadtree;   // Root at index 0
+
+    // Displaced render mode: heights live in a 16 bit texture, no per terrain vertices
+    unsigned int heightTexture = 0;
+
+    // Edits are collected here and patched into the GPU data once per frame
+    TerrainDirtyRect dirty;
+    float builtScale = 0.0f;        // terrainScale / maxHeight the GPU data was built with
+    float builtMaxHeight = 0.0f;
+
+    // Streamed terrain reads a tile pyramid (<heightmap>.metile) instead of the whole heightmap
+    bool streamed = false;
+    std::shared_ptr<TerrainStreamer> streamer;
 
     unsigned int textureID = 0;
     
@@ -40,6 +40,7 @@ public:
         mComponentManager->EntityDestroyed(entity);
 
         mSystemManager->EntityDestroyed(entity);
+        mComponentRevision++;
     }
 
 
@@ -68,6 +69,7 @@ public:
         mEntityManager->SetSignature(entity, signature);
 
         mSystemManager->EntitySignatureChanged(entity, signature);
+        mComponentRevision++;
         return true;
     }
     
@@ -90,6 +92,7 @@ public:
         mEntityManager->SetSignature(entity, signature);
 
         mSystemManager->EntitySignatureChanged(entity, signature);
+        mComponentRevision++;
     }
 
     template<typename T>
@@ -127,6 +130,10 @@ public:
         return mEntityManager->GetAliveEntities();
     }
     
+    // Bumped whenever components are added or removed. Component pointers (and system entity
+    // lists) cached by a system stay valid as long as this value is unchanged.
+    uint32_t GetComponentRevision() const { return mComponentRevision; }
+    
     bool DoesEntityExist(Entity e){
         return mEntityManager->DoesEntityExist(e);
     }
@@ -141,4 +148,5 @@ private:
     std::unique_ptr<ComponentManager> mComponentManager;
     std::unique_ptr<EntityManager> mEntityManager;
     std::unique_ptr<ECSSystemManager> mSystemManager;
+    uint32_t mComponentRevision = 0;
 };
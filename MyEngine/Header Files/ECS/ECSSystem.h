@@ -16,6 +16,8 @@ class Coordinator;
 class ECSSystem{
 public:
     virtual void Init(){};
+    // Called after an entity leaves mEntities (destroyed or signature no longer matches)
+    virtual void OnEntityRemoved(Entity entity){};
     std::vector<Entity> mEntities;
     void SetCoordinator(Coordinator* aCoordinator);
 
@@ -35,7 +35,11 @@ public:
         {
             auto const& system = pair.second;
             auto& entities = system->mEntities;
-            entities.erase(std::remove(entities.begin(), entities.end(), entity), entities.end());
+            auto it = std::find(entities.begin(), entities.end(), entity);
+            if (it == entities.end()) continue;
+            
+            entities.erase(it);
+            system->OnEntityRemoved(entity);
         }
     }
 
@@ -59,7 +63,12 @@ public:
             else
             {
                 auto& entities = system->mEntities;
-                entities.erase(std::remove(entities.begin(), entities.end(), entity), entities.end());
+                auto it = std::find(entities.begin(), entities.end(), entity);
+                if (it != entities.end())
+                {
+                    entities.erase(it);
+                    system->OnEntityRemoved(entity);
+                }
             }
         }
     }
@@ -22,6 +22,7 @@ public:
     
     void LookAt(const glm::vec3& target, const glm::vec3& up);
     glm::mat4 GetView() const;
+    glm::vec3 GetCameraPosition() const;
     
     void OnReleaseCamControl();
     void ProcessInput(GLFWwindow* aWindow, float aDeltaTime);
@@ -10,6 +10,7 @@
 #include "Components.h"
 #include "Shader.h"
 #include "ECS/Coordinator.h"
+#include "GPURingBuffer.h"
 
 struct LineVertex {
     glm::vec3 position;
@@ -22,6 +23,10 @@ public:
     void Update(Entity selectedEntity);
     void Render();
     
+    void SetFrameAllocator(GPURingBuffer* frameAllocator){
+        m_FrameAllocator = frameAllocator;
+    }
+    
 private:
     void DrawSphereCollision(const Entity& entity);
     void DrawCircle(glm::vec3 center, float radius, glm::vec3 axis, glm::vec3 color);
@@ -31,7 +36,8 @@ private:
     
 private:
     std::vector<LineVertex> lineVertices;
-    unsigned int lineVBO, lineVAO;
+    unsigned int lineVAO = 0;
+    GPURingBuffer* m_FrameAllocator = nullptr;
     
     bool showAllCollision = false;
 };
@@ -1,5 +1,5 @@
 //
-//  RenderSystem.h
+//  LightSystem.h
 //  MyEngine
 //
 //  Created by Priyanshu Kaushik on 19/11/2025.
@@ -10,12 +10,65 @@
 #include "Shader.h"
 #include "Components.h"
 #include "ECS/Coordinator.h"
+#include "UniformBuffer.h"
+#include "TextureBuffer.h"
+#include "ClusterGrid.h"
+
+// Directional light cascades for one frame
+struct ShadowCascades
+{
+    glm::mat4 matrices[SHADOW_CASCADES];
+    glm::vec4 splits;          // Far view depth of each cascade
+};
 
 class LightSystem : public ECSSystem{
 public:
     void Init() override;
-    void Render(Shader& shader);
-    glm::mat4 GetLightSpaceMatrix();
+    
+    // Gathers the directional lights into the LightData uniform block and assigns point/spot
+    // lights to the cluster grid of the camera. Once per frame, before any pass.
+    void UploadLights(const glm::mat4& view, const glm::mat4& projection, const glm::vec2& viewportSize);
+    
+    // Binds the clustered light buffers (texture units 4-6) for a lit shader
+    void BindClusters(Shader& shader) const;
+    
+    // Splits the camera frustum (practical split scheme) and fits one light ortho box per part.
+    // resolution: shadow map size, used to snap the boxes to whole texels. The boxes are anchored
+    // to the world and only move in steps of CASCADE_ANCHOR_STEP, so the matrices stay the same
+    // from frame to frame while the camera moves within a step.
+    void ComputeCascades(const glm::mat4& view, const glm::mat4& projection, int resolution, ShadowCascades& out) const;
+    
+    void SetFrameAllocator(GPURingBuffer* frameAllocator){
+        m_FrameAllocator = frameAllocator;
+    }
 private:
+    // Blend between logarithmic (1) and uniform (0) split distances
+    static constexpr float CASCADE_SPLIT_LAMBDA = 0.75f;
+    static constexpr float MAX_SHADOW_DISTANCE = 200.0f;
+    // Fraction of a cascade's radius its box moves by at once. The box grows by half a step to
+    // still cover the view, costing that much resolution (12.5% at 0.25).
+    static constexpr float CASCADE_ANCHOR_STEP = 0.25f;
+    // Extra depth towards the light, so casters outside the view still land in the map
+    static constexpr float CASTER_DEPTH_PADDING = 50.0f;
+    
+    // Attenuated intensity at which a point light's range ends
+    static constexpr float LIGHT_CUTOFF = 1.0f / 128.0f;
+    static constexpr float MAX_LIGHT_RANGE = 500.0f;
+    
+    static float ComputeLightRange(const LightComponent& light);
+    
     glm::vec3 m_LastDirectionalDir = glm::vec3(0.0f, -1.0f, 0.0f);
+    
+    LightUniforms m_LightData;
+    
+    // CLUSTERED LIGHTS
+    // Point light records: 3 RGBA32F texels each (position + range, color, attenuation)
+    std::vector<glm::vec4> m_PointLightData;
+    std::vector<ClusterLight> m_ClusterLights;
+    ClusterGrid m_ClusterGrid;
+    TextureBuffer m_PointLightBuffer;
+    TextureBuffer m_ClusterRangeBuffer;    // RG32UI: offset, count per cluster
+    TextureBuffer m_LightIndexBuffer;      // R32UI: indices into the point lights
+
+    GPURingBuffer* m_FrameAllocator = nullptr;
 };
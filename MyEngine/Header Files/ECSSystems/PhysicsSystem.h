@@ -7,28 +7,150 @@
 
 #pragma once
 #include "ECS/ECSSystem.h"
+#include <algorithm>
 #include "ECSSystems/TerrainSystem.h"
 #include "Components.h"
 #include "ECS/Coordinator.h"
+#include "Physics/Broadphase.h"
+#include "Physics/PhysicsWorld.h"
+#include "Physics/Contact.h"
+#include "Physics/Narrowphase.h"
+#include "Physics/ContactSolver.h"
+#include "Physics/IslandBuilder.h"
+#include "Physics/CCD.h"
+#include "Physics/Queries.h"
 
 class PhysicsSystem : public ECSSystem{
 public:
     void Init() override;
+
+    // Advances the simulation by whole fixed steps (at most m_MaxSubsteps per call) and
+    // interpolates the rendered transforms by the remaining fraction of a step
     void Update(float deltaTime);
     void UpdateBounds(Entity entity);
+    void OnEntityRemoved(Entity entity) override;
     
     void SetTerrainSystem(std::shared_ptr<TerrainSystem> terrainSystem){
         m_TerrainSystem = terrainSystem;
     }
+
+    // TIMESTEP
+    void SetFixedRate(float stepsPerSecond) { m_FixedDelta = 1.0f / std::max(stepsPerSecond, 1.0f); }
+    float GetFixedRate() const { return 1.0f / m_FixedDelta; }
+    void SetMaxSubsteps(int maxSubsteps) { m_MaxSubsteps = std::max(maxSubsteps, 1); }
+    int GetMaxSubsteps() const { return m_MaxSubsteps; }
+    // Drops leftover time, e.g. when play starts
+    void ResetAccumulator() { m_Accumulator = 0.0f; }
+
+    // SOLVER
+    void SetSolverIterations(int iterations) { m_Solver.SetIterations(iterations); }
+    int GetSolverIterations() const { return m_Solver.GetIterations(); }
+
+    // QUERIES
+    // Answered from the broadphase grid and collider shapes, refreshed by UpdateQueries when
+    // the simulation stepped or bounds changed since (every query calls it first). Transforms
+    // moved by scripts are seen once their bounds are updated, at the latest the next step.
+    // Directions need not be normalized. Triggers are skipped unless hitTriggers is set; the
+    // terrain reports its entity.
+    void UpdateQueries();
+    bool Raycast(const glm::vec3& origin, const glm::vec3& direction, float maxDistance, RaycastHit& hit, bool hitTriggers = false);
+    bool SphereCast(const glm::vec3& origin, float radius, const glm::vec3& direction, float maxDistance, RaycastHit& hit, bool hitTriggers = false);
+    // results are replaced. rotation is in Euler degrees, like transforms.
+    void OverlapSphere(const glm::vec3& center, float radius, std::vector<Entity>& results, bool hitTriggers = false);
+    void OverlapBox(const glm::vec3& center, const glm::vec3& halfExtents, const glm::vec3& rotation, std::vector<Entity>& results, bool hitTriggers = false);
+    // Rays spread over the JobSystem in groups of RAYCAST_BATCH_SIZE, hits[i] answers rays[i]
+    // (entity UINT32_MAX for a miss). Must not be called from a job.
+    void RaycastBatch(const std::vector<RaycastQuery>& rays, std::vector<RaycastHit>& hits, bool hitTriggers = false);
+
+    static constexpr int RAYCAST_BATCH_SIZE = 64;
 private:
+    // Cached component pointers of one body, plus the state last exchanged with them
+    struct BodyLink
+    {
+        Entity entity;
+        RigidBodyComponent* rigidBody;
+        TransformComponent* transform;
+        ColliderComponent* collider;        // Optional
+        BoxColliderComponent* box;          // Optional
+        SphereColliderComponent* sphere;    // Optional
+        uint32_t transformRevision;
+        glm::vec3 velocity, angularVelocity;
+        glm::quat orientation;              // Last written to transform->rotation
+        float mass, gravityScale;
+        bool isStatic, isKinematic, freezeRotation;
+    };
+
+    void Step(float deltaTime);
+    void Interpolate(float alpha);
+    void SetRenderOffset(BodyLink& link, const glm::vec3& offset);
+    void RebuildBodies();
+    void SyncBodies();
+    void SyncBodyType(uint32_t body);
+    void WriteBackBodies();
+
+    // Collider bounds brought up to date and handed to the broadphase
+    void RefreshProxies();
+    // Broadphase, then contact manifolds for every touching pair and terrain contact
+    void DetectCollisions();
+    // False (and nothing added) when both bodies sleep
+    bool AddBodyContacts(Entity entityA, Entity entityB);
+    void AddTerrainContacts(const TerrainSampler& terrain, uint32_t body);
+    void WakeBody(uint32_t body);
+    // Islands whose bodies all rested for SLEEP_TIME go to sleep together
+    void SleepIslands();
+    bool GetCollisionBox(const BodyLink& link, CollisionBox& box) const;
+    bool GetCollisionSphere(const BodyLink& link, CollisionSphere& sphere) const;
+    glm::vec3 GetTerrainNormal(const TerrainSampler& terrain, float x, float z) const;
+    // Resolved on the calling thread, once per step or query
+    TerrainSampler GetTerrainSampler() const;
+
+    // Bullets are swept from their pose at the start of the step to the integrated one and
+    // stopped at the first time of impact, the rest of the step continues after the hit
+    void SweepBullets(float deltaTime);
+    void SweepBullet(uint32_t body, const TerrainSampler& terrain, float deltaTime);
+    bool SweepTerrain(const TerrainSampler& terrain, const SweepShape& shape, const glm::vec3& motion, TimeOfImpact& hit) const;
+    bool MarchTerrain(const TerrainSampler& terrain, const glm::vec3& start, const glm::vec3& motion, float gap, int maxSamples, float& fraction) const;
+    bool GetSweepShape(const BodyLink& link, SweepShape& shape) const;
+
+    // Query internals, thread safe once the grid is up to date. direction is normalized.
+    bool CastRay(const glm::vec3& origin, const glm::vec3& direction, float maxDistance, const TerrainSampler& terrain, RaycastHit& hit, bool hitTriggers) const;
+    // Collider of a query candidate, nullptr for entities without a body or skipped triggers
+    const BodyLink* GetQueryBody(Entity entity, bool hitTriggers) const;
+    void Overlap(const SweepShape& shape, const TerrainSampler& terrain, std::vector<Entity>& results, bool hitTriggers) const;
+
     glm::mat4 GetWorldMatrix(const TransformComponent* transform);
-    bool CheckSphereSphereCollision(Entity entityA, Entity entityB);
-    bool CheckBoxBoxCollision(Entity entityA, Entity entityB);
-    bool CheckSphereBoxCollision(Entity sphereEnt, Entity boxEnt);
-    void ProjectBox(const ColliderComponent* col, const BoxColliderComponent* box, const glm::vec3& axis, float& min, float& max);
 private:
     
     std::shared_ptr<TerrainSystem> m_TerrainSystem;
+    Broadphase m_Broadphase;
+
+    // BODIES
+    PhysicsWorld m_World;
+    std::vector<BodyLink> m_Bodies;         // Same order as the world's bodies
+    std::vector<uint32_t> m_AwakeBodies;    // Awake this step
+    uint32_t m_BodiesRevision = UINT32_MAX; // Coordinator component revision the links were built at
+    std::vector<uint32_t> m_BodyOfEntity;   // Entity -> body, NO_BODY for entities without one
+
+    // CONTACTS
+    static constexpr float TERRAIN_NORMAL_STEP = 0.25f;    // Central difference distance for the terrain slope
+    std::vector<ContactManifold> m_Manifolds;
+    std::vector<BroadphasePair> m_SleepingPairs;    // Skipped this step, both bodies asleep
+    IslandBuilder m_Islands;
+    ContactSolver m_Solver;
+
+    // CONTINUOUS COLLISION
+    static constexpr float CCD_MOTION_THRESHOLD = 0.5f;    // Of the inner radius; slower bullets are left to the contacts
+    static constexpr int CCD_MAX_SUBSTEPS = 4;             // Impacts per bullet and step, the time after the last one is lost
+    static constexpr int TERRAIN_SWEEP_MAX_SAMPLES = 64;
+    static constexpr int TERRAIN_SWEEP_BISECTIONS = 10;
+    std::vector<Entity> m_SweepCandidates;
+
+    // QUERIES
+    static constexpr int TERRAIN_RAY_MAX_SAMPLES = 1024;
+    bool m_QueriesStale = true;     // Bodies moved since the grid was built
 
-    glm::vec3 axes[15];
+    // TIMESTEP
+    float m_FixedDelta = 1.0f / 60.0f;
+    int m_MaxSubsteps = 4;
+    float m_Accumulator = 0.0f;
 };
@@ -10,14 +10,162 @@
 #include "Shader.h"
 #include "Components.h"
 #include "ECS/Coordinator.h"
+#include "ECSSystems/CameraSystem.h"
+#include "Math/Frustum.h"
+#include "Math/BVH.h"
+#include "RenderQueue.h"
+#include "UniformBuffer.h"
+#include "GPURingBuffer.h"
+#include "MeshPool.h"
+#include "HiZBuffer.h"
+#include <vector>
+#include <unordered_map>
+
+// Per-frame counters (all passes), see RenderSystem::GetStats
+struct RenderStats
+{
+    uint32_t drawCalls = 0;
+    uint32_t instances = 0;
+    uint32_t materialBinds = 0;
+    uint32_t textureBinds = 0;
+    uint32_t meshBinds = 0;
+    uint32_t triangles = 0;
+    uint32_t occluded = 0;       // Entities rejected by the Hi-Z test (opaque pass)
+};
+
+// Which shadow casters a pass draws. Dynamic = non-static rigid bodies and scripted entities.
+enum class CasterFilter : uint8_t {
+    All,
+    Static,
+    Dynamic
+};
 
 class RenderSystem : public ECSSystem{
 public:
     void Init() override;
-    void Render(Shader& shader);
+    void OnEntityRemoved(Entity entity) override;
+    
+    // Uploads new meshes and refreshes world bounds/BVH for moved entities. Once per frame, before any pass.
+    void SyncSceneBounds();
+    
+    // cullMatrix: view-projection used for frustum culling this pass (camera or light)
+    void Render(Shader& shader, const glm::mat4& cullMatrix, RenderPass pass = RenderPass::Opaque, CasterFilter filter = CasterFilter::All);
+    
+    // True once after a static caster moved, appeared or was removed (cached shadows are stale)
+    bool ConsumeStaticCasterChanges();
+    uint32_t GetDynamicCasterCount() const { return m_DynamicCasterCount; }
+    
+    void SetCameraSystem(std::shared_ptr<CameraSystem> cameraSystem){
+        m_CameraSystem = cameraSystem;
+    }
+    
+    // Per-frame instance and material data are sub-allocated from here
+    void SetFrameAllocator(GPURingBuffer* frameAllocator){
+        m_FrameAllocator = frameAllocator;
+    }
+    
+    // Previous frame depth for occlusion culling the camera passes, nullptr disables it
+    void SetOcclusionBuffer(const HiZBuffer* occlusionBuffer){
+        m_OcclusionBuffer = occlusionBuffer;
+    }
+    
+    const BVH& GetSceneBVH() const { return m_SceneBVH; }
+    
+    // Counters of the last completed frame
+    const RenderStats& GetStats() const { return m_LastFrameStats; }
 private:
+    struct MaterialKey
+    {
+        uint32_t albedoID, normalID, specID;
+        glm::vec3 ambient, diffuse, specular;
+        float shininess, opacity;
+        
+        bool operator==(const MaterialKey& o) const {
+            return albedoID == o.albedoID && normalID == o.normalID && specID == o.specID &&
+                   ambient == o.ambient && diffuse == o.diffuse && specular == o.specular &&
+                   shininess == o.shininess && opacity == o.opacity;
+        }
+    };
+    
+    struct MaterialKeyHash
+    {
+        size_t operator()(const MaterialKey& k) const {
+            size_t h = std::hash<uint32_t>()(k.albedoID);
+            h = h * 31 + std::hash<uint32_t>()(k.normalID);
+            h = h * 31 + std::hash<uint32_t>()(k.specID);
+            h = h * 31 + std::hash<float>()(k.diffuse.x + k.diffuse.y * 3.0f + k.diffuse.z * 7.0f);
+            h = h * 31 + std::hash<float>()(k.shininess);
+            h = h * 31 + std::hash<float>()(k.opacity);
+            return h;
+        }
+    };
+    
+    struct MaterialBinding
+    {
+        const Material* material = nullptr;
+        unsigned int textures[3] = { 0, 0, 0 }; // Albedo, Normal, Specular (0 = missing)
+    };
+    
+    // Run of draw commands sharing one material, submitted as one multi draw
+    struct CommandGroup
+    {
+        uint32_t materialIndex;
+        uint32_t firstCommand;
+        uint32_t commandCount;
+    };
+    
+    // Returns the number of entities rejected by occlusion
+    uint32_t CullVisible(const glm::mat4& cullMatrix, bool occlusion);
+    void SetInstanceAttributes(size_t offset);
+    uint32_t GetMaterialIndex(const Material& material);
+
     void DrawPhysicsGizmos();
     void UploadMeshIfNeeded(Entity e, MeshComponent* mc);
     glm::mat4 BuildModelMatrix(TransformComponent* t);
+    int SelectLOD(const Mesh* mesh, const glm::mat4& model, const glm::vec3& cameraPos, float projScale) const;
+    bool UpdateWorldBounds(TransformComponent* t, MeshComponent* mc, const Mesh* mesh);
+    bool IsDynamicCaster(Entity e) const;
+    
+private:
+    std::shared_ptr<CameraSystem> m_CameraSystem;
+    GPURingBuffer* m_FrameAllocator = nullptr;
+    const HiZBuffer* m_OcclusionBuffer = nullptr;
+    
+    // World bounds of every drawable entity
+    BVH m_SceneBVH;
+    
+    // Culling scratch. The BVH accepts/rejects whole subtrees; leaves under partially
+    // visible nodes are tested in SoA batches (4 boxes at a time).
+    Frustum m_Frustum;
+    std::vector<Entity> m_VisibleEntities;
+    std::vector<Entity> m_CullEntities;
+    std::vector<float> m_CullCenterX, m_CullCenterY, m_CullCenterZ;
+    std::vector<float> m_CullExtentX, m_CullExtentY, m_CullExtentZ;
+    std::vector<uint8_t> m_CullVisible;
+    
+    // Draw packets of the current pass and the materials they reference
+    RenderQueue m_Queue;
+    std::vector<MaterialBinding> m_Materials;
+    std::unordered_map<MaterialKey, uint32_t, MaterialKeyHash> m_MaterialLookup;
+    
+    // Indirect commands of the current pass (into the MeshPool buffers)
+    std::vector<DrawElementsIndirectCommand> m_DrawCommands;
+    std::vector<CommandGroup> m_CommandGroups;
+    
+    // MaterialData block records of the pass (ring allocation), bound by range on material change
+    size_t m_MaterialStride = 0;
+    
+    // Static/dynamic caster split, refreshed in SyncSceneBounds
+    std::vector<uint8_t> m_DynamicCasters;
+    uint32_t m_DynamicCasterCount = 0;
+    bool m_StaticCastersChanged = true;
+    
+    RenderStats m_FrameStats;
+    RenderStats m_LastFrameStats;
+    
+    // First of the 4 attribute slots holding the instance model matrix
+    static constexpr int INSTANCE_ATTRIB = MeshPool::INSTANCE_ATTRIB;
     
+    // Fraction of screen height covered by the bounding sphere below which LOD i+1 is used
+    static constexpr float LOD_SCREEN_THRESHOLDS[3] = { 0.35f, 0.15f, 0.06f };
 };
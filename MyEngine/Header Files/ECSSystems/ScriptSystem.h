@@ -9,11 +9,18 @@
 #include "ECS/ECSSystem.h"
 #include "Components.h"
 #include "ScriptManager.h"
+#include <memory>
+
+class PhysicsSystem;
 
 class ScriptSystem : public ECSSystem{
 public:
     void Init() override;
     void Update(float deltaTime);
+    // Spatial queries for scripts, call after Init
+    void SetPhysicsSystem(std::shared_ptr<PhysicsSystem> physicsSystem){
+        m_ScriptManager->SetPhysicsSystem(physicsSystem.get());
+    }
 private:
     std::unique_ptr<ScriptManager> m_ScriptManager;
 };
@@ -8,22 +8,164 @@
 #pragma once
 #include "ECS/ECSSystem.h"
 #include "Components.h"
+#include "UniformBuffer.h"
+#include "ECSSystems/CameraSystem.h"
+#include "Math/Frustum.h"
+#include "GPURingBuffer.h"
+#include "GLAD/include/glad/glad.h"
+#include <memory>
 
 class Shader;
 
+// How chunk vertices are produced
+enum class TerrainRenderMode {
+    Baked,      // Full vertices per chunk, built on the CPU
+    Displaced   // One shared flat patch instanced per chunk, heights fetched in the vertex shader
+};
+
+enum class TerrainBrushMode { Raise, Lower, Flatten, Smooth };
+
+struct TerrainBrush {
+    TerrainBrushMode mode = TerrainBrushMode::Raise;
+    float radius = 8.0f;          // World units
+    float strength = 0.25f;       // Normalized height per second at the centre (fades out to the rim)
+    float targetHeight = 0.5f;    // Flatten, normalized [0, 1]
+};
+
+// One terrain's components, looked up once for code that samples it many times (physics
+// queries). Valid until components are added or removed; read only, so jobs can share it.
+struct TerrainSampler {
+    Entity entity = UINT32_MAX;
+    const TerrainComponent* terrain = nullptr;
+    const TransformComponent* transform = nullptr;
+
+    explicit operator bool() const { return terrain != nullptr; }
+
+    // World XZ rectangle covered by the heightmap
+    void GetFootprint(glm::vec2& min, glm::vec2& max) const;
+    bool Contains(float worldX, float worldZ) const;
+    // 0 outside the footprint and where a streamed terrain has nothing resident yet
+    float GetHeightAt(float worldX, float worldZ) const;
+};
+
+/**
+ * @class TerrainSystem
+ * @brief Heightmap terrain, split into fixed size chunks under a quadtree (geomipmapping).
+ * * Every chunk is a CHUNK_VERTS x CHUNK_VERTS vertex grid plus a skirt along its border.
+ * All chunks use the same index buffer, holding one index range per LOD (vertex step 1, 2, 4, ...).
+ * Rendering walks the quadtree against the frustum, picks a LOD per visible chunk from its
+ * camera distance and issues one multi draw per LOD. Skirts hide the cracks between chunks
+ * of different LODs.
+ * * In Displaced mode no vertices are stored per terrain: a single flat patch with the chunk
+ * layout is instanced once per visible chunk, and the vertex shaders read heights and normals
+ * from a 16 bit height texture. Only the heightmap and the chunk bounds stay on the CPU.
+ * * Height edits (brushes, scale or max height changes) only mark a dirty rectangle. Update then
+ * rebuilds the touched rows of the touched chunks and patches them in with glBufferSubData
+ * (glTexSubImage2D in Displaced mode) and refits the chunk bounds and the quadtree.
+ * * Streamed terrains have no heightmap in memory: a TerrainStreamer keeps the tiles around the
+ * camera resident and the drawn tiles (same vertex layout as a chunk) all use the LOD 0 range.
+ */
 class TerrainSystem : public ECSSystem{
 public:
     void Init() override;
-    
-    void Render(Shader& shader);
+
+    // Streaming residency and tile selection, pending height edits. Once per frame after the camera moved.
+    void Update();
+
+    // cullMatrix: view-projection the chunks are frustum culled against
+    void Render(Shader& shader, const glm::mat4& cullMatrix);
     void CreateTerrain(Entity entity);
     float GetHeightAt(Entity entity, float worldX, float worldZ);
+    // Invalid sampler for entities without (heights in) a terrain
+    TerrainSampler GetSampler(Entity entity);
+
+    // BRUSH EDITING
+    // Heights change on the CPU right away (GetHeightAt sees them), the GPU copy in the next Update.
+    // Not available for streamed terrains.
+    void ApplyBrush(Entity entity, const glm::vec3& worldPosition, const TerrainBrush& brush, float deltaTime);
+    // For edits made to heightData directly, in heightmap texels (inclusive)
+    void MarkDirty(Entity entity, int minX, int minZ, int maxX, int maxZ);
 
     Entity GetTerrainEntity(){return m_TerrainEntity;}
+
+    // CPU half of a baked terrain build: chunk layout, vertices with skirts, chunk bounds and
+    // the quadtree (heightmap of at least 2 x 2). Returns the vertex count; no GL calls, so the
+    // benchmarks can time it alone.
+    size_t BuildMesh(TerrainComponent* terrain, std::unique_ptr<Vertex[]>& outVertices);
+
+    TerrainRenderMode GetRenderMode() const { return m_RenderMode; }
+    // Rebuilds every terrain for the new mode (streamed terrains are always baked)
+    void SetRenderMode(TerrainRenderMode mode);
+
+    // Displaced mode instance data is sub-allocated from here
+    void SetFrameAllocator(GPURingBuffer* frameAllocator){
+        m_FrameAllocator = frameAllocator;
+    }
+
+    // LOD selection uses the camera position
+    void SetCameraSystem(std::shared_ptr<CameraSystem> cameraSystem){
+        m_CameraSystem = cameraSystem;
+    }
+
+    static constexpr int CHUNK_QUADS = 64;
+    static constexpr int CHUNK_VERTS = CHUNK_QUADS + 1;                              // 65 x 65 grid
+    static constexpr int CHUNK_GRID_VERTICES = CHUNK_VERTS * CHUNK_VERTS;
+    static constexpr int CHUNK_VERTEX_COUNT = CHUNK_GRID_VERTICES + 4 * CHUNK_VERTS;  // + skirts
+    static constexpr int LOD_COUNT = 5;                                                // Steps 1 .. 16
+
 private:
     glm::mat4 GetWorldMatrix(const TransformComponent* transform);
+    void ReleaseTerrain(TerrainComponent* terrain);
     void GenerateMesh(Entity entity);
-    
+    void ComputeChunkBounds(TerrainComponent* terrain, int cx, int cz) const;
+    void FillChunkRows(const TerrainComponent* terrain, int cx, int cz, int z0, int z1, Vertex* out) const;
+    void FillChunkSkirts(const TerrainComponent* terrain, int cx, int cz, float skirtDepth, Vertex* out) const;
+    void FlushEdits(TerrainComponent* terrain);
+    AABB RefitQuadtree(TerrainComponent* terrain, int nodeIndex);
+    void GenerateDisplaced(Entity entity, const uint16_t* heights);
+    void BuildPatch();
+    void RenderDisplaced(Shader& shader, const TerrainComponent* terrain);
+    // Normals of grid points gx0 .. gx0 + count - 1 on row gz (SIMD, safe to call from jobs)
+    void ComputeNormalRow(const TerrainComponent* terrain, int gx0, int gz, int count, glm::vec3* outNormals) const;
+    int BuildQuadtree(TerrainComponent* terrain, int x0, int z0, int x1, int z1);
+    void BuildChunkIndexBuffer();
+    int SelectLOD(const AABB& worldBounds, float chunkWorldSize, const glm::vec3& cameraPos) const;
+    bool OpenStreamedTerrain(TerrainComponent* terrain);
+    void RenderStreamed(const TerrainComponent* terrain, const glm::mat4& model);
+
 private:
     Entity m_TerrainEntity = UINT32_MAX;
+    std::shared_ptr<CameraSystem> m_CameraSystem;
+    GPURingBuffer* m_FrameAllocator = nullptr;
+    TerrainRenderMode m_RenderMode = TerrainRenderMode::Baked;
+
+    // Terrain's own MaterialData record (default material + albedo flag)
+    UniformBuffer m_MaterialBuffer;
+    int m_UploadedAlbedoFlag = -1;   // Material record is only re-uploaded when this changes
+
+    // Shared chunk indices (16 bit, local to a chunk), one range per LOD
+    GLuint m_ChunkIndexBuffer = 0;
+    struct IndexRange { GLsizei first = 0; GLsizei count = 0; };
+    IndexRange m_LODRanges[LOD_COUNT];
+
+    // Per pass scratch: visible chunks grouped by LOD for glMultiDrawElementsBaseVertex
+    Frustum m_Frustum;
+    std::vector<int32_t> m_NodeStack;
+    std::vector<GLsizei> m_DrawCounts[LOD_COUNT];
+    std::vector<const void*> m_DrawOffsets[LOD_COUNT];
+    std::vector<GLint> m_DrawBaseVertices[LOD_COUNT];
+    std::vector<int32_t> m_DrawChunks[LOD_COUNT];    // Displaced mode: chunk indices
+
+    // Edit scratch: rebuilt rows of one chunk, 16 bit texels of a dirty rectangle, brush source heights
+    std::vector<Vertex> m_EditVertices;
+    std::vector<uint16_t> m_EditTexels;
+    std::vector<float> m_BrushSource;
+
+    // Displaced mode: flat patch with the chunk vertex layout, (x, 0 or -1 for skirts, z) per vertex
+    GLuint m_PatchVAO = 0, m_PatchVBO = 0;
+    static constexpr GLuint PATCH_INSTANCE_ATTRIBUTE = 8;   // vec4: origin in texels, skirt depth
+    static constexpr int HEIGHT_MAP_UNIT = 7;               // After material, shadow and cluster units
+
+    // A chunk closer than this many chunk widths uses LOD 0, each doubling of the distance drops one level
+    static constexpr float LOD_DISTANCE = 1.5f;
 };
@@ -19,6 +19,8 @@
 #include "ECS/Coordinator.h"
 #include "MessageQueue.h"
 #include "ShaderManager.h"
+#include "UniformBuffer.h"
+#include "HiZBuffer.h"
 
 
 #include <queue>
@@ -31,6 +33,12 @@ enum class EngineState {
     Launcher = 2
 };
 
+// How the opaque geometry is lit. Transparent materials always go through a forward pass.
+enum class RenderMode {
+    Forward = 0,    // Clustered forward shading
+    Deferred = 1    // G-buffer + one fullscreen lighting pass over the same light clusters
+};
+
 class Scene;
 class Shader;
 class EditorContext;
@@ -46,6 +54,9 @@ public:
     Coordinator* GetCoordinator(){return m_Coordinator;}
     ShaderManager* GetShaderManager(){return m_ShaderManager;}
     std::shared_ptr<CameraSystem> GetCameraSystem(){ return cameraSystem;}
+    std::shared_ptr<RenderSystem> GetRenderSystem(){ return renderSystem;}
+    std::shared_ptr<TerrainSystem> GetTerrainSystem(){ return terrainSystem;}
+    std::shared_ptr<PhysicsSystem> GetPhysicsSystem(){ return physicsSystem;}
     unsigned int GetViewportTexture(){return m_ViewportTexture;}
     int GetFPS(){ return FPS;}
     
@@ -58,6 +69,14 @@ public:
     EngineState GetState() { return m_State; }
     void SetState(EngineState newState);
     
+    RenderMode GetRenderMode() { return m_RenderMode; }
+    void SetRenderMode(RenderMode mode) { m_RenderMode = mode; }
+    
+    bool GetDepthPrepass() { return m_DepthPrepass; }
+    void SetDepthPrepass(bool enabled) { m_DepthPrepass = enabled; }
+    bool GetOcclusionCulling() { return m_OcclusionCulling; }
+    void SetOcclusionCulling(bool enabled);
+    
     void PushMessage(std::unique_ptr<Message> msg){
         m_MessageQueue->Push(std::move(msg));
     }
@@ -73,7 +92,13 @@ public:
     void DeleteEntity(Entity aEntity);
 private:
     void InitViewportFramebuffer(int width, int height);
+    void InitGBuffer(int width, int height);
     void InitShadowMap();
+    void CreateShadowTarget(unsigned int* fbos, unsigned int& textureArray);
+    void RenderShadows(Shader& shadowShader, const ShadowCascades& cascades);
+    void BindSceneLighting(Shader& shader);
+    void RenderDepthPrepass(Shader& depthShader);
+    void RenderDeferred(Shader& gBufferShader, Shader& lightingShader, Shader* depthShader);
     void OnEditMode();
     void ProcessMessages();
     void SendMessage(std::unique_ptr<Message> msg);
@@ -81,6 +106,9 @@ private:
     void Cleanup();
 private:
     EngineState m_State = EngineState::Edit;
+    RenderMode m_RenderMode = RenderMode::Forward;
+    bool m_DepthPrepass = false;
+    bool m_OcclusionCulling = false;
 
     Coordinator* m_Coordinator = nullptr;
     GLFWwindow* m_Window = nullptr;
@@ -101,11 +129,33 @@ private:
     float m_ViewportWidth, m_ViewportHeight;
     unsigned int m_ViewportFBO, m_ViewportTexture, m_ViewportRBO;
     
-    unsigned int m_DepthMapFBO, m_DepthMapTexture;
+    // Cascaded shadow maps: one texture array layer (and one FBO) per cascade
+    unsigned int m_DepthMapFBOs[SHADOW_CASCADES], m_DepthMapTexture;
     const unsigned int SHADOW_WIDTH = 2048, SHADOW_HEIGHT = 2048;
     
+    // Static casters only, a cascade is redrawn when one of them or its light matrix changes.
+    // m_DepthMapTexture = cached static depth + dynamic casters of this frame.
+    unsigned int m_StaticDepthMapFBOs[SHADOW_CASCADES], m_StaticDepthMapTexture;
+    unsigned int m_ShadowTexture = 0;       // What the main pass samples this frame
+    glm::mat4 m_CachedCascadeMatrices[SHADOW_CASCADES];
+    bool m_StaticShadowValid = false;
+    
+    ShadowCascades m_ShadowCascades;
+    
+    // Camera + shadow matrices shared by every shader (FrameData block)
+    FrameUniforms m_FrameData;
+    
+    // Transient per-frame GPU data (uniform ranges, instances, debug lines)
+    GPURingBuffer m_FrameRing;
+    static constexpr GLsizeiptr FRAME_RING_SIZE = 4 * 1024 * 1024;
+    
+    // Deferred G-buffer, same size as the viewport (layout in GBufferFragmentShader.glsl)
     unsigned int m_gBuffer, m_gDepthRBO;
     unsigned int m_gPosition, m_gNormal, m_gAlbedoSpec;
+    unsigned int m_FullscreenVAO = 0;       // Empty, the fullscreen triangle comes from gl_VertexID
+    
+    // Previous frame's depth pyramid for occlusion culling
+    HiZBuffer m_HiZ;
     
     float m_DeltaTime = 0.0f;
     float m_LastFrameTime = 0.0f;
@@ -0,0 +1,95 @@
+//
+//  GPURingBuffer.h
+//  MyEngine
+//
+//  Created by Priyanshu Kaushik on 19/10/2026.
+//
+
+#pragma once
+#include "GLAD/include/glad/glad.h"
+#include <vector>
+#include <cstdint>
+#include <cstring>
+
+// A range of the ring handed out for this frame
+struct GPUAllocation
+{
+    uint8_t* data = nullptr;   // CPU write pointer (persistent mapping or staging copy)
+    GLuint buffer = 0;
+    GLintptr offset = 0;
+    GLsizeiptr size = 0;
+
+    explicit operator bool() const { return data != nullptr; }
+};
+
+/**
+ * @class GPURingBuffer
+ * @brief Per-frame linear allocator for transient GPU data (vertices, instances, UBO ranges).
+ * * With ARB_buffer_storage the buffer is persistently mapped and split into 3 frame
+ * segments; a fence placed at EndFrame guards each segment until the GPU is done with it.
+ * Without it (macOS tops out at GL 4.1) the buffer is orphaned once per frame and
+ * allocations are written to a CPU staging copy and uploaded on Commit.
+ * * A frame that overflows its segment gets the rest of its allocations from separate overflow
+ * buffers (staged, uploaded on Commit), so ranges handed out earlier in the frame stay valid.
+ * The ring itself only grows in the next BeginFrame, to fit what the frame needed.
+ */
+class GPURingBuffer {
+public:
+    void Create(GLsizeiptr frameSize);
+    void Destroy();
+
+    // Waits until the next segment is free again. Call before any Allocate in a frame.
+    void BeginFrame();
+    // Fences everything submitted this frame.
+    void EndFrame();
+
+    GPUAllocation Allocate(GLsizeiptr size, GLsizeiptr alignment = 16);
+
+    // Makes the bytes written through allocation.data visible to GL. No-op when persistently mapped.
+    void Commit(const GPUAllocation& allocation);
+
+    // Allocate + copy + Commit
+    GPUAllocation Upload(const void* data, GLsizeiptr size, GLsizeiptr alignment = 16)
+    {
+        GPUAllocation allocation = Allocate(size, alignment);
+        if (!allocation) return allocation;
+        std::memcpy(allocation.data, data, size);
+        Commit(allocation);
+        return allocation;
+    }
+
+    GLuint GetBuffer() const { return m_Buffer; }
+    bool IsPersistent() const { return m_Persistent; }
+
+    static constexpr int FRAME_COUNT = 3;
+
+private:
+    // Separately allocated storage for the rest of an overflowing frame
+    struct OverflowChunk
+    {
+        GLuint buffer = 0;
+        GLsizeiptr size = 0;
+        GLsizeiptr offset = 0;
+        std::vector<uint8_t> staging;
+    };
+
+    void CreateStorage();
+    void WaitForFence(int segment);
+    GPUAllocation AllocateOverflow(GLsizeiptr size, GLsizeiptr alignment);
+    void ReleaseOverflow();
+
+private:
+    GLuint m_Buffer = 0;
+    bool m_Persistent = false;
+
+    GLsizeiptr m_FrameSize = 0;
+    GLsizeiptr m_FrameOffset = 0;   // Write head inside the current segment
+    int m_Segment = 0;
+
+    uint8_t* m_Mapped = nullptr;            // Persistent mapping of the whole buffer
+    std::vector<uint8_t> m_Staging;         // Fallback: CPU copy of one frame
+    GLsync m_Fences[FRAME_COUNT] = { nullptr, nullptr, nullptr };
+
+    std::vector<OverflowChunk> m_Overflow;  // This frame's, released in the next BeginFrame
+    GLsizeiptr m_FrameNeeded = 0;           // Bytes this frame asked for, overflow included
+};
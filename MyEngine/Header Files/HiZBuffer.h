@@ -0,0 +1,70 @@
+//
+//  HiZBuffer.h
+//  MyEngine
+//
+//  Created by Priyanshu Kaushik on 19/10/2026.
+//
+
+#pragma once
+#include "GLAD/include/glad/glad.h"
+#include "Math/Bounds.h"
+#include <glm/glm.hpp>
+#include <vector>
+
+class Shader;
+
+/**
+ * @class HiZBuffer
+ * @brief Hierarchical depth pyramid of the previous frame, used to occlusion cull entity bounds.
+ * * After the opaque passes the viewport depth is copied and max-reduced on the GPU down to
+ * READBACK_SIZE, read back asynchronously (pixel pack buffer + fence) and reduced further on the CPU.
+ * Bounds are projected with the view-projection the depth was rendered with; a box is occluded
+ * when its nearest depth lies behind the farthest depth stored over its screen rect.
+ * Results are one or more frames old, which can let a just disoccluded object pop in a frame late.
+ */
+class HiZBuffer {
+public:
+    void Create(int width, int height);
+    void Destroy();
+
+    // Picks up a finished readback. Call once per frame before any culling.
+    void Resolve();
+
+    // Reduces the depth of sourceFBO and starts the readback. Skipped while one is still in flight.
+    // Leaves framebuffer 0 bound.
+    void Build(Shader& downsampleShader, GLuint sourceFBO, const glm::mat4& viewProjection);
+
+    bool IsReady() const { return m_Ready; }
+    // Drops the pyramid and any readback in flight (scene reload, culling re-enabled)
+    void Invalidate();
+    bool IsOccluded(const AABB& bounds) const;
+
+    // Largest level read back to the CPU, in texels
+    static constexpr int READBACK_SIZE = 256;
+
+private:
+    void BuildCPULevels();
+
+private:
+    int m_Width = 0, m_Height = 0;
+
+    // Copy of the scene depth (the viewport depth is a renderbuffer and cannot be sampled)
+    GLuint m_DepthCopyFBO = 0, m_DepthCopyTexture = 0;
+
+    // R32F pyramid, level 0 = half the viewport, one FBO per level
+    GLuint m_PyramidTexture = 0;
+    std::vector<GLuint> m_LevelFBOs;
+    std::vector<glm::ivec2> m_LevelSizes;
+    GLuint m_FullscreenVAO = 0;
+
+    // Async readback of the last GPU level
+    GLuint m_ReadbackPBO = 0;
+    GLsync m_ReadbackFence = nullptr;
+    glm::mat4 m_PendingViewProjection = glm::mat4(1.0f);
+
+    // CPU pyramid, level 0 = the read back level
+    std::vector<std::vector<float>> m_Levels;
+    std::vector<glm::ivec2> m_CPULevelSizes;
+    glm::mat4 m_ViewProjection = glm::mat4(1.0f);
+    bool m_Ready = false;
+};
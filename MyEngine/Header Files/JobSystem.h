@@ -14,6 +14,8 @@
 #include <mutex>
 #include <condition_variable>
 #include <atomic>
+#include <memory>
+#include <algorithm>
 
 // Platform-specific includes for thread naming
 #ifdef _WIN32
@@ -106,6 +108,48 @@ public:
         m_Condition.notify_one();
     }
 
+    /**
+     * @brief Runs job(0) .. job(count - 1) on the workers and the calling thread, returns once all ran.
+     * * Indices are handed out one at a time, so uneven jobs balance themselves.
+     * Must not be called from a job: the worker would wait for itself.
+     */
+    void ParallelFor(int count, const std::function<void(int)>& job) {
+        if (count <= 0) return;
+        if (count == 1 || m_Workers.empty()) {
+            for (int i = 0; i < count; i++) job(i);
+            return;
+        }
+
+        struct Batch {
+            std::atomic<int> next{0};
+            std::atomic<int> remaining{0};
+            std::mutex mutex;
+            std::condition_variable done;
+        };
+        // Shared: a late worker may still look at the counters after this call returned
+        auto batch = std::make_shared<Batch>();
+        batch->remaining = count;
+
+        // job is only touched while indices are left, i.e. while the caller still waits
+        auto run = [batch, &job, count] {
+            int i;
+            while ((i = batch->next.fetch_add(1)) < count) {
+                job(i);
+                if (batch->remaining.fetch_sub(1) == 1) {
+                    std::lock_guard<std::mutex> lock(batch->mutex);
+                    batch->done.notify_all();
+                }
+            }
+        };
+
+        int helpers = std::min(count - 1, (int)m_Workers.size());
+        for (int i = 0; i < helpers; i++) Execute(run);
+        run();
+
+        std::unique_lock<std::mutex> lock(batch->mutex);
+        batch->done.wait(lock, [&batch] { return batch->remaining.load() == 0; });
+    }
+
     /**
      * @brief Signals all threads to stop and waits for them to join.
      * Should be called during Engine shutdown to prevent orphan threads.
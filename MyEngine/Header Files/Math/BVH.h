@@ -0,0 +1,109 @@
+//
+//  BVH.h
+//  MyEngine
+//
+//  Created by Priyanshu Kaushik on 19/10/2026.
+//
+
+#pragma once
+#include <vector>
+#include <unordered_map>
+#include <functional>
+#include "ECS/ECS.h"
+#include "Math/Bounds.h"
+#include "Math/Frustum.h"
+
+/**
+ * @class BVH
+ * @brief Dynamic AABB tree keyed by entity.
+ * * Leaves store a slightly enlarged ("fat") box so small movements don't touch the tree.
+ * Moves that leave the fat box refit the ancestors in place when the new box still overlaps
+ * the old one, and reinsert the leaf otherwise. Quality is tracked with the SAH cost and
+ * the tree can be rebuilt top-down (binned SAH) once it has degraded.
+ */
+class BVH {
+public:
+    struct RayHit
+    {
+        Entity entity = 0;
+        float distance = 0.0f;
+    };
+
+    // Narrowphase for Raycast. Receives the entity and the distance to its leaf box, may refine
+    // the distance, and returns false to reject the hit.
+    using RayFilter = std::function<bool(Entity entity, float& distance)>;
+
+    void Insert(Entity entity, const AABB& box);
+    void Remove(Entity entity);
+
+    // Inserts the entity when missing. Returns true if the tree changed.
+    bool Update(Entity entity, const AABB& box);
+
+    // Recomputes every internal box bottom-up from the leaves.
+    void Refit();
+
+    // Rebuilds the whole tree with a binned SAH split.
+    void Rebuild();
+
+    // True once the SAH cost has grown noticeably since the last rebuild.
+    bool NeedsRebuild() const;
+
+    void Clear();
+    bool Contains(Entity entity) const { return m_Leaves.find(entity) != m_Leaves.end(); }
+    size_t GetLeafCount() const { return m_Leaves.size(); }
+
+    // Sum of internal node areas relative to the root (expected node visits for a random ray)
+    float GetCost() const;
+
+    // QUERIES
+    void QueryAABB(const AABB& box, std::vector<Entity>& outEntities) const;
+
+    /**
+     * @brief Collects entities whose leaf box touches the frustum.
+     * @param outPartial When given, leaves reached through a partially visible node are
+     *        appended here untested (so the caller can batch test exact bounds) instead of
+     *        being tested one by one. Whole subtrees inside the frustum always go to outInside.
+     */
+    void QueryFrustum(const Frustum& frustum, std::vector<Entity>& outInside, std::vector<Entity>* outPartial = nullptr) const;
+
+    bool Raycast(const glm::vec3& origin, const glm::vec3& direction, float maxDistance,
+                 RayHit& outHit, const RayFilter& filter = nullptr) const;
+
+    // Closest leaf box to the point (distance is 0 when the point is inside a box)
+    bool QueryNearest(const glm::vec3& point, float maxDistance, Entity& outEntity, float& outDistance) const;
+
+private:
+    struct Node
+    {
+        AABB box;
+        int parent = -1;
+        int left = -1;
+        int right = -1;
+        Entity entity = 0;
+
+        bool IsLeaf() const { return left == -1; }
+    };
+
+    int AllocateNode();
+    void FreeNode(int index);
+    void InsertLeaf(int leaf);
+    void RemoveLeaf(int leaf);
+    void RefitAncestors(int index);
+    int BuildRecursive(std::vector<int>& leaves, size_t begin, size_t end);
+
+private:
+    std::vector<Node> m_Nodes;
+    std::unordered_map<Entity, int> m_Leaves;
+    int m_Root = -1;
+    int m_FreeList = -1;
+
+    float m_BuiltCost = 0.0f;
+    uint32_t m_ChangesSinceBuild = 0;
+
+    // Traversal stack reused between queries
+    mutable std::vector<int> m_Stack;
+
+    static constexpr float FAT_MARGIN = 0.1f;
+    static constexpr float REBUILD_COST_RATIO = 1.5f;
+    static constexpr int SAH_BINS = 12;
+};
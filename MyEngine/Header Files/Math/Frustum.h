@@ -0,0 +1,142 @@
+//
+//  Frustum.h
+//  MyEngine
+//
+//  Created by Priyanshu Kaushik on 19/10/2026.
+//
+
+#pragma once
+#include <glm/glm.hpp>
+#include <cstdint>
+#include "Math/Bounds.h"
+#include "Math/SIMD.h"
+
+/**
+ * @class Frustum
+ * @brief Six clip planes extracted from a view-projection matrix (Gribb/Hartmann).
+ * * Planes point inwards: a point is inside when dot(n, p) + d >= 0 for all planes.
+ * Planes are also kept in SoA form (two groups of 4) so one box can be tested against
+ * 4 planes per instruction, and CullAABBs tests 4 boxes per plane at a time.
+ */
+class Frustum {
+public:
+    enum class TestResult { Outside, Intersects, Inside };
+
+    Frustum() = default;
+    explicit Frustum(const glm::mat4& viewProjection) { Extract(viewProjection); }
+
+    void Extract(const glm::mat4& m)
+    {
+        // Rows of the matrix (glm is column-major: m[col][row])
+        glm::vec4 row0(m[0][0], m[1][0], m[2][0], m[3][0]);
+        glm::vec4 row1(m[0][1], m[1][1], m[2][1], m[3][1]);
+        glm::vec4 row2(m[0][2], m[1][2], m[2][2], m[3][2]);
+        glm::vec4 row3(m[0][3], m[1][3], m[2][3], m[3][3]);
+
+        m_Planes[0] = row3 + row0; // Left
+        m_Planes[1] = row3 - row0; // Right
+        m_Planes[2] = row3 + row1; // Bottom
+        m_Planes[3] = row3 - row1; // Top
+        m_Planes[4] = row3 + row2; // Near
+        m_Planes[5] = row3 - row2; // Far
+
+        for (auto& p : m_Planes) {
+            float len = glm::length(glm::vec3(p));
+            if (len > 0.0f) p /= len;
+        }
+
+        // SoA copy, last two lanes padded with an always-passing plane
+        for (int i = 0; i < 8; i++) {
+            glm::vec4 p = i < 6 ? m_Planes[i] : glm::vec4(0.0f, 0.0f, 0.0f, 1.0f);
+            m_PlaneX[i] = p.x; m_PlaneY[i] = p.y; m_PlaneZ[i] = p.z; m_PlaneD[i] = p.w;
+        }
+    }
+
+    const glm::vec4& GetPlane(int i) const { return m_Planes[i]; }
+
+    bool IntersectsSphere(const glm::vec3& center, float radius) const
+    {
+        for (const auto& p : m_Planes)
+            if (glm::dot(glm::vec3(p), center) + p.w < -radius) return false;
+        return true;
+    }
+
+    // One box vs all planes, 4 planes per SIMD op
+    bool IntersectsAABB(const glm::vec3& center, const glm::vec3& extents) const
+    {
+        using namespace simd;
+        float4 cx = Set1(center.x), cy = Set1(center.y), cz = Set1(center.z);
+        float4 ex = Set1(extents.x), ey = Set1(extents.y), ez = Set1(extents.z);
+        float4 zero = Set1(0.0f);
+
+        for (int group = 0; group < 8; group += 4)
+        {
+            float4 px = Load(m_PlaneX + group), py = Load(m_PlaneY + group), pz = Load(m_PlaneZ + group), pd = Load(m_PlaneD + group);
+            float4 dist = MulAdd(px, cx, MulAdd(py, cy, MulAdd(pz, cz, pd)));
+            float4 radius = MulAdd(Abs(px), ex, MulAdd(Abs(py), ey, Mul(Abs(pz), ez)));
+            if (MoveMask(CmpLT(Add(dist, radius), zero)) != 0) return false;
+        }
+        return true;
+    }
+
+    bool IntersectsAABB(const AABB& box) const { return IntersectsAABB(box.GetCenter(), box.GetExtents()); }
+
+    // Like IntersectsAABB, but also reports boxes fully inside (lets hierarchies skip child tests)
+    TestResult ClassifyAABB(const AABB& box) const
+    {
+        using namespace simd;
+        glm::vec3 center = box.GetCenter(), extents = box.GetExtents();
+        float4 cx = Set1(center.x), cy = Set1(center.y), cz = Set1(center.z);
+        float4 ex = Set1(extents.x), ey = Set1(extents.y), ez = Set1(extents.z);
+        float4 zero = Set1(0.0f);
+        int straddling = 0;
+
+        for (int group = 0; group < 8; group += 4)
+        {
+            float4 px = Load(m_PlaneX + group), py = Load(m_PlaneY + group), pz = Load(m_PlaneZ + group), pd = Load(m_PlaneD + group);
+            float4 dist = MulAdd(px, cx, MulAdd(py, cy, MulAdd(pz, cz, pd)));
+            float4 radius = MulAdd(Abs(px), ex, MulAdd(Abs(py), ey, Mul(Abs(pz), ez)));
+            if (MoveMask(CmpLT(Add(dist, radius), zero)) != 0) return TestResult::Outside;
+            straddling |= MoveMask(CmpLT(Sub(dist, radius), zero));
+        }
+        return straddling ? TestResult::Intersects : TestResult::Inside;
+    }
+
+    /**
+     * @brief Batch test of boxes in SoA layout (center + extents), 4 boxes per iteration.
+     * @param outVisible Receives 1 for boxes touching the frustum, 0 otherwise.
+     */
+    void CullAABBs(const float* cx, const float* cy, const float* cz,
+                   const float* ex, const float* ey, const float* ez,
+                   size_t count, uint8_t* outVisible) const
+    {
+        using namespace simd;
+        float4 zero = Set1(0.0f);
+        size_t i = 0;
+
+        for (; i + 4 <= count; i += 4)
+        {
+            float4 bcx = Load(cx + i), bcy = Load(cy + i), bcz = Load(cz + i);
+            float4 bex = Load(ex + i), bey = Load(ey + i), bez = Load(ez + i);
+            int outside = 0;
+
+            for (int p = 0; p < 6 && outside != 0xF; p++)
+            {
+                float4 px = Set1(m_PlaneX[p]), py = Set1(m_PlaneY[p]), pz = Set1(m_PlaneZ[p]), pd = Set1(m_PlaneD[p]);
+                float4 dist = MulAdd(px, bcx, MulAdd(py, bcy, MulAdd(pz, bcz, pd)));
+                float4 radius = MulAdd(Abs(px), bex, MulAdd(Abs(py), bey, Mul(Abs(pz), bez)));
+                outside |= MoveMask(CmpLT(Add(dist, radius), zero));
+            }
+
+            for (int k = 0; k < 4; k++) outVisible[i + k] = (outside & (1 << k)) ? 0 : 1;
+        }
+
+        for (; i < count; i++)
+            outVisible[i] = IntersectsAABB(glm::vec3(cx[i], cy[i], cz[i]), glm::vec3(ex[i], ey[i], ez[i])) ? 1 : 0;
+    }
+
+private:
+    glm::vec4 m_Planes[6];
+
+    float m_PlaneX[8], m_PlaneY[8], m_PlaneZ[8], m_PlaneD[8];
+};
@@ -0,0 +1,188 @@
+//
+//  SIMD.h
+//  MyEngine
+//
+//  Created by Priyanshu Kaushik on 19/10/2026.
+//
+
+#pragma once
+#include <cstdint>
+#include <cmath>
+#include <cstring>
+#include <algorithm>
+#include <new>
+#include <vector>
+
+// Pick the widest 4-lane backend the target supports.
+// x86: SSE2 (always on for x86_64), ARM (Apple Silicon): NEON, anything else: scalar.
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #define MYENGINE_SIMD_SSE 1
+    #include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+    #define MYENGINE_SIMD_NEON 1
+    #include <arm_neon.h>
+#else
+    #define MYENGINE_SIMD_SCALAR 1
+#endif
+
+/**
+ * @brief Minimal 4-wide float abstraction.
+ * * Lets hot loops (culling, terrain normals, physics integration) be written once
+ * and compiled to SSE, NEON or plain scalar code. Masks are float4 values with
+ * all bits set in "true" lanes, like the native compare instructions produce.
+ */
+namespace simd {
+
+struct float4
+{
+#if MYENGINE_SIMD_SSE
+    __m128 v;
+    float4() : v(_mm_setzero_ps()) {}
+    float4(__m128 x) : v(x) {}
+#elif MYENGINE_SIMD_NEON
+    float32x4_t v;
+    float4() : v(vdupq_n_f32(0.0f)) {}
+    float4(float32x4_t x) : v(x) {}
+#else
+    float v[4];
+    float4() : v{0.0f, 0.0f, 0.0f, 0.0f} {}
+#endif
+};
+
+constexpr int WIDTH = 4;
+
+// LOAD / STORE
+
+inline float4 Load(const float* p)
+{
+#if MYENGINE_SIMD_SSE
+    return _mm_loadu_ps(p);
+#elif MYENGINE_SIMD_NEON
+    return vld1q_f32(p);
+#else
+    float4 r; for (int i = 0; i < 4; i++) r.v[i] = p[i]; return r;
+#endif
+}
+
+inline void Store(float* p, float4 a)
+{
+#if MYENGINE_SIMD_SSE
+    _mm_storeu_ps(p, a.v);
+#elif MYENGINE_SIMD_NEON
+    vst1q_f32(p, a.v);
+#else
+    for (int i = 0; i < 4; i++) p[i] = a.v[i];
+#endif
+}
+
+inline float4 Set1(float x)
+{
+#if MYENGINE_SIMD_SSE
+    return _mm_set1_ps(x);
+#elif MYENGINE_SIMD_NEON
+    return vdupq_n_f32(x);
+#else
+    float4 r; for (int i = 0; i < 4; i++) r.v[i] = x; return r;
+#endif
+}
+
+inline float4 Set(float x, float y, float z, float w)
+{
+    const float values[4] = { x, y, z, w };
+    return Load(values);
+}
+
+// ARITHMETIC
+
+#if MYENGINE_SIMD_SSE
+inline float4 Add(float4 a, float4 b) { return _mm_add_ps(a.v, b.v); }
+inline float4 Sub(float4 a, float4 b) { return _mm_sub_ps(a.v, b.v); }
+inline float4 Mul(float4 a, float4 b) { return _mm_mul_ps(a.v, b.v); }
+inline float4 Div(float4 a, float4 b) { return _mm_div_ps(a.v, b.v); }
+inline float4 Min(float4 a, float4 b) { return _mm_min_ps(a.v, b.v); }
+inline float4 Max(float4 a, float4 b) { return _mm_max_ps(a.v, b.v); }
+inline float4 Sqrt(float4 a) { return _mm_sqrt_ps(a.v); }
+inline float4 Abs(float4 a) { return _mm_andnot_ps(_mm_set1_ps(-0.0f), a.v); }
+inline float4 CmpLT(float4 a, float4 b) { return _mm_cmplt_ps(a.v, b.v); }
+inline float4 CmpGT(float4 a, float4 b) { return _mm_cmpgt_ps(a.v, b.v); }
+inline float4 CmpLE(float4 a, float4 b) { return _mm_cmple_ps(a.v, b.v); }
+inline float4 And(float4 a, float4 b) { return _mm_and_ps(a.v, b.v); }
+inline float4 Or(float4 a, float4 b) { return _mm_or_ps(a.v, b.v); }
+inline float4 Select(float4 mask, float4 a, float4 b) { return _mm_or_ps(_mm_and_ps(mask.v, a.v), _mm_andnot_ps(mask.v, b.v)); }
+inline int MoveMask(float4 mask) { return _mm_movemask_ps(mask.v); }
+#elif MYENGINE_SIMD_NEON
+inline float4 Add(float4 a, float4 b) { return vaddq_f32(a.v, b.v); }
+inline float4 Sub(float4 a, float4 b) { return vsubq_f32(a.v, b.v); }
+inline float4 Mul(float4 a, float4 b) { return vmulq_f32(a.v, b.v); }
+inline float4 Div(float4 a, float4 b) { return vdivq_f32(a.v, b.v); }
+inline float4 Min(float4 a, float4 b) { return vminq_f32(a.v, b.v); }
+inline float4 Max(float4 a, float4 b) { return vmaxq_f32(a.v, b.v); }
+inline float4 Sqrt(float4 a) { return vsqrtq_f32(a.v); }
+inline float4 Abs(float4 a) { return vabsq_f32(a.v); }
+inline float4 CmpLT(float4 a, float4 b) { return vreinterpretq_f32_u32(vcltq_f32(a.v, b.v)); }
+inline float4 CmpGT(float4 a, float4 b) { return vreinterpretq_f32_u32(vcgtq_f32(a.v, b.v)); }
+inline float4 CmpLE(float4 a, float4 b) { return vreinterpretq_f32_u32(vcleq_f32(a.v, b.v)); }
+inline float4 And(float4 a, float4 b) { return vreinterpretq_f32_u32(vandq_u32(vreinterpretq_u32_f32(a.v), vreinterpretq_u32_f32(b.v))); }
+inline float4 Or(float4 a, float4 b) { return vreinterpretq_f32_u32(vorrq_u32(vreinterpretq_u32_f32(a.v), vreinterpretq_u32_f32(b.v))); }
+inline float4 Select(float4 mask, float4 a, float4 b) { return vbslq_f32(vreinterpretq_u32_f32(mask.v), a.v, b.v); }
+inline int MoveMask(float4 mask)
+{
+    uint32x4_t bits = vshrq_n_u32(vreinterpretq_u32_f32(mask.v), 31);
+    return (int)(vgetq_lane_u32(bits, 0) | (vgetq_lane_u32(bits, 1) << 1) | (vgetq_lane_u32(bits, 2) << 2) | (vgetq_lane_u32(bits, 3) << 3));
+}
+#else
+#define MYENGINE_SIMD_LANEWISE(name, expr) \
+    inline float4 name(float4 a, float4 b) { float4 r; for (int i = 0; i < 4; i++) { float x = a.v[i], y = b.v[i]; r.v[i] = (expr); } return r; }
+#define MYENGINE_SIMD_MASK(name, expr) \
+    inline float4 name(float4 a, float4 b) { float4 r; for (int i = 0; i < 4; i++) { float x = a.v[i], y = b.v[i]; uint32_t m = (expr) ? 0xffffffffu : 0u; std::memcpy(&r.v[i], &m, 4); } return r; }
+MYENGINE_SIMD_LANEWISE(Add, x + y)
+MYENGINE_SIMD_LANEWISE(Sub, x - y)
+MYENGINE_SIMD_LANEWISE(Mul, x * y)
+MYENGINE_SIMD_LANEWISE(Div, x / y)
+MYENGINE_SIMD_LANEWISE(Min, std::min(x, y))
+MYENGINE_SIMD_LANEWISE(Max, std::max(x, y))
+MYENGINE_SIMD_MASK(CmpLT, x < y)
+MYENGINE_SIMD_MASK(CmpGT, x > y)
+MYENGINE_SIMD_MASK(CmpLE, x <= y)
+#undef MYENGINE_SIMD_LANEWISE
+#undef MYENGINE_SIMD_MASK
+inline float4 Sqrt(float4 a) { float4 r; for (int i = 0; i < 4; i++) r.v[i] = std::sqrt(a.v[i]); return r; }
+inline float4 Abs(float4 a) { float4 r; for (int i = 0; i < 4; i++) r.v[i] = std::fabs(a.v[i]); return r; }
+inline uint32_t Bits(float f) { uint32_t u; std::memcpy(&u, &f, 4); return u; }
+inline float FromBits(uint32_t u) { float f; std::memcpy(&f, &u, 4); return f; }
+inline float4 And(float4 a, float4 b) { float4 r; for (int i = 0; i < 4; i++) r.v[i] = FromBits(Bits(a.v[i]) & Bits(b.v[i])); return r; }
+inline float4 Or(float4 a, float4 b) { float4 r; for (int i = 0; i < 4; i++) r.v[i] = FromBits(Bits(a.v[i]) | Bits(b.v[i])); return r; }
+inline float4 Select(float4 mask, float4 a, float4 b) { float4 r; for (int i = 0; i < 4; i++) r.v[i] = Bits(mask.v[i]) ? a.v[i] : b.v[i]; return r; }
+inline int MoveMask(float4 mask) { int m = 0; for (int i = 0; i < 4; i++) m |= (Bits(mask.v[i]) >> 31) << i; return m; }
+#endif
+
+// a * b + c
+inline float4 MulAdd(float4 a, float4 b, float4 c) { return Add(Mul(a, b), c); }
+
+// ALIGNED STORAGE
+// SoA arrays walked with Load/Store, 16 byte aligned so every group of WIDTH lanes shares a cache line
+
+constexpr size_t ALIGNMENT = 16;
+
+template<typename T>
+struct AlignedAllocator
+{
+    using value_type = T;
+
+    AlignedAllocator() = default;
+    template<typename U> AlignedAllocator(const AlignedAllocator<U>&) {}
+
+    T* allocate(size_t count) { return static_cast<T*>(::operator new(count * sizeof(T), std::align_val_t(ALIGNMENT))); }
+    void deallocate(T* p, size_t) { ::operator delete(p, std::align_val_t(ALIGNMENT)); }
+
+    template<typename U> bool operator==(const AlignedAllocator<U>&) const { return true; }
+    template<typename U> bool operator!=(const AlignedAllocator<U>&) const { return false; }
+};
+
+template<typename T>
+using AlignedVector = std::vector<T, AlignedAllocator<T>>;
+
+// Round a lane count up to whole float4 groups
+inline size_t PaddedCount(size_t count) { return (count + WIDTH - 1) / WIDTH * WIDTH; }
+
+}
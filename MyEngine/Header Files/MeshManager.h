@@ -42,7 +42,12 @@ private:
     bool SaveMeshBinary(const std::string& path, const Mesh& mesh);
     bool LoadMeshBinary(const std::string& path, Mesh& outMesh);
     void CalculateTangents(Mesh& mesh);
+    void CalculateBounds(Mesh& mesh);
+    void GenerateLODs(Mesh& mesh);
 private:
+    // LOD 0 + up to 3 simplified levels, each targeting half the previous triangle count
+    static constexpr int MAX_LOD_COUNT = 4;
+
     std::unordered_map<uint32_t, int> m_MeshRefCount;
     std::unordered_map<uint32_t, Mesh*> m_Meshes;
     uint32_t m_NextMeshID = 1;
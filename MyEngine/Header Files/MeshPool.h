@@ -0,0 +1,96 @@
+//
+//  MeshPool.h
+//  MyEngine
+//
+//  Created by Priyanshu Kaushik on 19/10/2026.
+//
+
+#pragma once
+#include "GLAD/include/glad/glad.h"
+#include <cstdint>
+#include <map>
+#include <vector>
+
+struct Mesh;
+
+// Layout of glMultiDrawElementsIndirect / glDrawElementsIndirect commands
+struct DrawElementsIndirectCommand
+{
+    uint32_t count;
+    uint32_t instanceCount;
+    uint32_t firstIndex;
+    int32_t baseVertex;
+    uint32_t baseInstance;
+};
+
+/**
+ * @class MeshPool
+ * @brief Global vertex/index buffers shared by every mesh, drawn through a single VAO.
+ * * Meshes get a vertex range and an index range from first-fit free lists and keep
+ * the offsets (Mesh::baseVertex / Mesh::baseIndex). Freed ranges are merged with their
+ * neighbours. When a range does not fit, the buffer grows and the old content is copied
+ * on the GPU.
+ * Vertex layout: [Pos(3), Normal(3), UV(2), Tangent(3)] floats. Attributes 4-7 are the
+ * per-instance model matrix, their buffer/offset is set by the renderer.
+ */
+class MeshPool {
+public:
+    static MeshPool& Get() {
+        static MeshPool instance;
+        return instance;
+    }
+
+    void Init();
+    void Shutdown();
+
+    // Copies the mesh into the pool (freeing its previous range, if any) and fills its offsets
+    bool Upload(Mesh* mesh, const std::vector<float>& vertices, const std::vector<uint32_t>& indices);
+    void Free(Mesh* mesh);
+
+    GLuint GetVAO() const { return m_VAO; }
+
+    // glMultiDrawElementsIndirect with base instance support (GL 4.3 / ARB extensions)
+    static bool SupportsMultiDrawIndirect();
+
+    static constexpr int VERTEX_FLOATS = 11;
+    static constexpr int VERTEX_STRIDE = VERTEX_FLOATS * sizeof(float);
+    static constexpr int INSTANCE_ATTRIB = 4;
+
+private:
+    MeshPool() = default;
+
+    // First-fit allocator over [0, capacity) in elements
+    class RangeAllocator {
+    public:
+        void Reset(uint32_t capacity);
+        void Grow(uint32_t newCapacity);
+        bool Allocate(uint32_t count, uint32_t& outOffset);
+        void Free(uint32_t offset, uint32_t count);
+        uint32_t GetCapacity() const { return m_Capacity; }
+
+    private:
+        std::map<uint32_t, uint32_t> m_FreeRanges; // offset -> count
+        uint32_t m_Capacity = 0;
+    };
+
+    bool AllocateRange(RangeAllocator& allocator, GLuint& buffer, GLenum target, size_t elementSize, uint32_t count, uint32_t& outOffset);
+    void GrowBuffer(GLuint& buffer, GLenum target, size_t oldBytes, size_t newBytes);
+    void SetupVertexAttributes();
+
+    uint32_t AcquireHandle();
+
+private:
+    GLuint m_VAO = 0;
+    GLuint m_VertexBuffer = 0;
+    GLuint m_IndexBuffer = 0;
+
+    RangeAllocator m_Vertices;
+    RangeAllocator m_Indices;
+
+    // Mesh handles double as the mesh id in render sort keys
+    std::vector<uint32_t> m_FreeHandles;
+    uint32_t m_NextHandle = 0;
+
+    static constexpr uint32_t INITIAL_VERTICES = 1 << 18;   // ~11 MB
+    static constexpr uint32_t INITIAL_INDICES = 1 << 20;    // 4 MB
+};
@@ -0,0 +1,34 @@
+//
+//  MeshSimplifier.h
+//  MyEngine
+//
+//  Created by Priyanshu Kaushik on 19/10/2026.
+//
+
+#pragma once
+#include <vector>
+#include <cstdint>
+#include "AssetData.h"
+
+/**
+ * @class MeshSimplifier
+ * @brief Quadric Error Metric (Garland-Heckbert) mesh decimation used to build LOD chains.
+ * * Vertices are welded by position first (the OBJ importer emits one vertex per face corner),
+ * then edges are collapsed cheapest-first until the triangle budget is met. Collapses always
+ * move onto an existing vertex, so every LOD indexes the same vertex buffer as LOD 0.
+ */
+class MeshSimplifier {
+public:
+    /**
+     * @brief Simplifies an indexed triangle list.
+     * @param vertices Source vertex buffer (shared by all LODs).
+     * @param indices Source triangle list (3 indices per triangle).
+     * @param targetIndexCount Stop once the result has this many indices or fewer.
+     * @param outError Receives the largest quadric error accepted (in squared world units).
+     * @return New triangle list referencing the same vertex buffer.
+     */
+    static std::vector<uint32_t> Simplify(const std::vector<Vertex>& vertices,
+                                          const std::vector<uint32_t>& indices,
+                                          size_t targetIndexCount,
+                                          float& outError);
+};
@@ -0,0 +1,108 @@
+//
+//  Broadphase.h
+//  MyEngine
+//
+//  Created by Priyanshu Kaushik on 19/10/2026.
+//
+
+#pragma once
+#include <vector>
+#include <unordered_map>
+#include <functional>
+#include <glm/glm.hpp>
+#include "ECS/ECS.h"
+#include "Physics/Queries.h"
+
+// Two colliders whose world AABBs overlap, candidates for the narrowphase
+struct BroadphasePair
+{
+    Entity a;
+    Entity b;
+};
+
+/**
+ * @class Broadphase
+ * @brief Uniform spatial hash over collider AABBs, keyed by entity.
+ * * Each step the cell size is picked from the median proxy size, every proxy is entered
+ * into the cells its box covers and boxes sharing a cell are tested against each other.
+ * A pair sharing several cells is only reported from the first one (the cell holding the
+ * min corner of the two boxes' overlap), so the pair list needs no deduplication.
+ * Cells are bucketed with a counting sort into a flat table, no per cell allocations.
+ * Proxies far larger than a cell are kept out of the grid and tested against everything.
+ * Static-static pairs are never reported.
+ * * Every live collider is refreshed with SetProxy once per step; proxies that were not
+ * refreshed since the previous FindPairs are dropped there, so removed colliders need no
+ * separate bookkeeping.
+ */
+class Broadphase {
+public:
+    void SetProxy(Entity entity, const glm::vec3& min, const glm::vec3& max, bool isStatic);
+    void RemoveProxy(Entity entity);
+    void Clear();
+
+    // The returned list is valid until the next call
+    const std::vector<BroadphasePair>& FindPairs();
+    // Grid for the queries only, without looking for pairs. False when there are too few proxies for one.
+    bool BuildGrid();
+
+    // Appends the proxies overlapping the box, at their bounds and in the grid of the last
+    // FindPairs or BuildGrid. Boxes spanning too many cells test every proxy instead.
+    void Query(const glm::vec3& min, const glm::vec3& max, std::vector<Entity>& results) const;
+
+    // Hands the proxies whose box the ray crosses to visit, cell by cell in ray order. visit returns
+    // the new maximum distance (its closest hit so far), which cuts the walk short. Proxies spanning
+    // several cells can be visited more than once. Read only, like Query: safe from several threads.
+    void Raycast(const glm::vec3& origin, const glm::vec3& direction, float maxDistance, const std::function<float(Entity)>& visit) const;
+
+    size_t GetProxyCount() const { return m_Proxies.size(); }
+    const std::vector<BroadphasePair>& GetPairs() const { return m_Pairs; }
+    float GetCellSize() const { return m_CellSize; }
+
+    // A proxy covering more cells than this along any axis skips the grid
+    static constexpr int MAX_CELL_SPAN = 4;
+    static constexpr int MAX_QUERY_CELLS = 64;
+    // Cells a ray walks before it falls back to testing every proxy
+    static constexpr int MAX_RAY_CELLS = 4096;
+
+private:
+    struct Proxy
+    {
+        glm::vec3 min;
+        glm::vec3 max;
+        Entity entity;
+        bool isStatic;
+        bool touched;       // Refreshed since the last FindPairs
+    };
+
+    struct CellEntry
+    {
+        uint64_t cell;      // Packed cell coordinates
+        uint32_t proxy;
+    };
+
+    void DropStaleProxies();
+    void ChooseCellSize();
+    void AddPair(uint32_t a, uint32_t b);
+    bool Overlaps(uint32_t a, uint32_t b) const;
+    bool Overlaps(uint32_t proxy, const glm::vec3& min, const glm::vec3& max) const;
+    size_t BucketOf(uint64_t cell) const { return (size_t)((cell * 0x9E3779B97F4A7C15ull) >> 32 & m_TableMask); }
+    uint64_t PackCell(int x, int y, int z) const;
+    glm::ivec3 CellOf(const glm::vec3& point) const;
+
+private:
+    std::vector<Proxy> m_Proxies;
+    std::unordered_map<Entity, uint32_t> m_ProxyIndex;
+
+    float m_CellSize = 1.0f;
+    glm::vec3 m_BoundsMin = glm::vec3(0.0f), m_BoundsMax = glm::vec3(0.0f);    // Of all proxies, at the last grid build
+
+    // Per step scratch
+    std::vector<float> m_Sizes;
+    std::vector<uint32_t> m_Large;
+    std::vector<CellEntry> m_Entries;       // Unsorted, as generated
+    std::vector<CellEntry> m_Buckets;       // Entries grouped by bucket
+    std::vector<uint32_t> m_BucketStart;    // Prefix sums, one past the table size
+    uint64_t m_TableMask = 0;
+
+    std::vector<BroadphasePair> m_Pairs;
+};
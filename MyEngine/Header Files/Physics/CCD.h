@@ -0,0 +1,54 @@
+//
+//  CCD.h
+//  MyEngine
+//
+//  Created by Priyanshu Kaushik on 19/10/2026.
+//
+
+#pragma once
+#include <glm/glm.hpp>
+#include "Physics/Narrowphase.h"
+
+// A sphere or box collider, moved by translation only while it is swept
+struct SweepShape
+{
+    bool isSphere = true;
+    CollisionSphere sphere;
+    CollisionBox box;
+
+    void Translate(const glm::vec3& offset);
+    void GetBounds(glm::vec3& min, glm::vec3& max) const;
+    glm::vec3 GetLowestPoint() const;
+    float GetInnerRadius() const;       // Smallest half extent
+};
+
+struct TimeOfImpact
+{
+    float fraction = 1.0f;              // Of the swept motion, 1 = no hit
+    glm::vec3 normal = glm::vec3(0.0f); // A to B at the hit
+};
+
+/**
+ * @brief Continuous collision detection for fast bodies.
+ * * Conservative advancement: A moves along the motion in steps that can never overshoot the
+ * first contact, each one as long as the current distance divided by the closing speed along
+ * the closest direction. Under pure translation the distance between convex shapes is a convex
+ * function of time, so that estimate is a lower bound. Box-box uses the largest separating
+ * axis gap instead of the exact distance, also convex and zero exactly when the boxes touch.
+ * * Hits stop TARGET_GAP short of contact, inside the narrowphase margin, so the regular
+ * contacts take over in the next step. Rotation during the sweep is ignored.
+ */
+namespace CCD {
+
+constexpr float TARGET_GAP = 0.5f * Narrowphase::CONTACT_MARGIN;
+constexpr float TOLERANCE = 0.25f * Narrowphase::CONTACT_MARGIN;
+constexpr int MAX_ITERATIONS = 32;
+
+// Exact for sphere pairs and sphere-box, a lower bound for box-box; negative when overlapping
+float Distance(const SweepShape& a, const SweepShape& b, glm::vec3& normal);
+
+// A moving by motion relative to B. False when they do not come within TARGET_GAP, or
+// already are and move apart.
+bool ConservativeAdvancement(const SweepShape& a, const SweepShape& b, const glm::vec3& motion, TimeOfImpact& hit);
+
+}
@@ -0,0 +1,59 @@
+//
+//  Contact.h
+//  MyEngine
+//
+//  Created by Priyanshu Kaushik on 19/10/2026.
+//
+
+#pragma once
+#include <cstdint>
+#include <glm/glm.hpp>
+#include "ECS/ECS.h"
+
+// PhysicsWorld body index of the terrain (or anything else that never moves)
+constexpr uint32_t NO_BODY = UINT32_MAX;
+
+struct ContactPoint
+{
+    glm::vec3 position = glm::vec3(0.0f);   // World, halfway between the two surfaces
+    float depth = 0.0f;                     // Penetration, negative while still apart (speculative)
+
+    // Accumulated impulses, carried over between steps for warm starting
+    float normalImpulse = 0.0f;
+    float tangentImpulse[2] = { 0.0f, 0.0f };
+
+    // Solver scratch
+    glm::vec3 localA = glm::vec3(0.0f);     // position in A's frame, matches points between steps
+    glm::vec3 rA = glm::vec3(0.0f), rB = glm::vec3(0.0f);
+    float normalMass = 0.0f;
+    float tangentMass[2] = { 0.0f, 0.0f };
+    float velocityBias = 0.0f;
+};
+
+/**
+ * @brief Contact points between two bodies sharing one normal (pointing from A to B).
+ * * Box-box contacts produce up to 4 points from face clipping, everything else one.
+ * Manifolds are keyed by their entity pair so the solver can warm start them from the
+ * impulses of the previous step.
+ */
+struct ContactManifold
+{
+    static constexpr int MAX_POINTS = 4;
+
+    Entity a = 0, b = 0;
+    uint32_t bodyA = NO_BODY, bodyB = NO_BODY;
+
+    glm::vec3 normal = glm::vec3(0.0f, 1.0f, 0.0f);
+    glm::vec3 tangent[2];
+    float friction = 0.5f;
+    float restitution = 0.0f;
+
+    int pointCount = 0;
+    ContactPoint points[MAX_POINTS];
+
+    // Solver scratch
+    uint32_t solverA = 0, solverB = 0;
+
+    static uint64_t MakeKey(Entity a, Entity b) { return ((uint64_t)a << 32) | (uint64_t)b; }
+    uint64_t GetKey() const { return MakeKey(a, b); }
+};
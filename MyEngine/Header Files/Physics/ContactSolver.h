@@ -0,0 +1,89 @@
+//
+//  ContactSolver.h
+//  MyEngine
+//
+//  Created by Priyanshu Kaushik on 19/10/2026.
+//
+
+#pragma once
+#include <vector>
+#include <unordered_map>
+#include <algorithm>
+#include <glm/glm.hpp>
+#include "Physics/Contact.h"
+#include "Physics/PhysicsWorld.h"
+#include "Physics/IslandBuilder.h"
+
+/**
+ * @class ContactSolver
+ * @brief Sequential impulse solver for contact manifolds, with friction and warm starting.
+ * * Bodies touched by a contact are gathered into a compact array, every point's normal and
+ * two friction impulses are solved iteratively (friction clamped by the normal impulse,
+ * normal impulse clamped to push only) and the velocities written back to the world.
+ * Penetration is removed with a Baumgarte velocity bias; restitution kicks in above
+ * RESTITUTION_THRESHOLD so resting contacts do not bounce.
+ * * Accumulated impulses are cached per entity pair. Next step, each new point starts from
+ * the impulse of the cached point at the same place on body A, so stacks start out close
+ * to the solution and need few iterations.
+ * * Islands share no dynamic body, so they are solved in parallel on the JobSystem, small
+ * ones grouped into batches of about ISLAND_BATCH_MANIFOLDS contacts. Each island is solved
+ * in the same order on whichever thread, so results do not depend on the thread count.
+ */
+class ContactSolver {
+public:
+    // manifolds sorted island by island (IslandBuilder::Build)
+    void Solve(PhysicsWorld& world, std::vector<ContactManifold>& manifolds, const std::vector<Island>& islands, float deltaTime);
+    void ClearCache();
+    // After the world's bodies were rebuilt in a new order. Contacts of entities that lost their
+    // body are dropped; the (new) bodies they touched are added to orphaned.
+    void RemapBodies(const std::vector<uint32_t>& bodyOfEntity, std::vector<uint32_t>& orphaned);
+    // Whether the pair touched when it was last solved (kept while both bodies sleep)
+    bool HasCachedContact(Entity a, Entity b) const { return m_CacheIndex.count(ContactManifold::MakeKey(a, b)) != 0; }
+
+    void SetIterations(int iterations) { m_Iterations = std::max(iterations, 1); }
+    int GetIterations() const { return m_Iterations; }
+
+    static constexpr int DEFAULT_ITERATIONS = 8;
+    static constexpr float BAUMGARTE = 0.2f;
+    static constexpr float PENETRATION_SLOP = 0.01f;
+    static constexpr float RESTITUTION_THRESHOLD = 1.0f;   // m/s of approach
+    static constexpr float MATCH_DISTANCE = 0.05f;         // Points closer than this are "the same"
+    static constexpr uint32_t ISLAND_BATCH_MANIFOLDS = 64; // Work per job
+
+private:
+    struct SolverBody
+    {
+        glm::vec3 velocity = glm::vec3(0.0f);
+        glm::vec3 angularVelocity = glm::vec3(0.0f);
+        glm::mat3 invInertia = glm::mat3(0.0f);
+        float invMass = 0.0f;
+        uint32_t body = NO_BODY;
+    };
+
+    void GatherBodies(const PhysicsWorld& world, std::vector<ContactManifold>& manifolds, const std::vector<Island>& islands);
+    void BuildBatches(const std::vector<Island>& islands);
+    void SolveIsland(const PhysicsWorld& world, ContactManifold* manifolds, uint32_t count, float deltaTime);
+    void ScatterBodies(PhysicsWorld& world);
+
+    // Per island, called from the solver jobs
+    void MatchCache(const PhysicsWorld& world, ContactManifold* manifolds, uint32_t count) const;
+    void Prepare(const PhysicsWorld& world, ContactManifold* manifolds, uint32_t count, float deltaTime);
+    void WarmStart(const ContactManifold* manifolds, uint32_t count);
+    void SolveVelocities(ContactManifold* manifolds, uint32_t count);
+    void UpdateCache(const PhysicsWorld& world, const std::vector<ContactManifold>& manifolds);
+
+    void ApplyImpulse(SolverBody& a, SolverBody& b, const ContactPoint& point, const glm::vec3& impulse);
+
+private:
+    int m_Iterations = DEFAULT_ITERATIONS;
+
+    // Bodies are gathered per island: an immovable body (static, kinematic, terrain) touching
+    // several islands gets a copy in each, so no two jobs ever write the same SolverBody
+    std::vector<SolverBody> m_Bodies;
+    std::vector<uint32_t> m_SolverIndex;        // World body -> m_Bodies index ...
+    std::vector<uint32_t> m_SolverIsland;       // ... valid for the island stored here
+    std::vector<uint32_t> m_Batches;            // First island of each job, plus the end
+
+    std::vector<ContactManifold> m_Cache;
+    std::unordered_map<uint64_t, uint32_t> m_CacheIndex;
+};
@@ -0,0 +1,51 @@
+//
+//  IslandBuilder.h
+//  MyEngine
+//
+//  Created by Priyanshu Kaushik on 19/10/2026.
+//
+
+#pragma once
+#include <vector>
+#include <cstdint>
+#include "Physics/Contact.h"
+#include "Physics/PhysicsWorld.h"
+
+// Bodies that touch each other (directly or through others) and the contacts between them
+struct Island
+{
+    uint32_t bodyStart = 0, bodyCount = 0;             // Into IslandBuilder::GetBodies()
+    uint32_t manifoldStart = 0, manifoldCount = 0;     // Into the manifolds, sorted by island
+};
+
+/**
+ * @class IslandBuilder
+ * @brief Splits the awake bodies into islands along the contact graph (union-find).
+ * * Only bodies that contacts can move link islands: static, kinematic and terrain
+ * contacts belong to the island of their one dynamic body, otherwise a floor would
+ * join everything standing on it. Islands share no dynamic body, so they can be solved
+ * independently and put to sleep as a whole.
+ * * Islands are numbered in the order their first body appears in the awake list, so
+ * the result (and solving order) does not depend on thread timing.
+ */
+class IslandBuilder {
+public:
+    // Reorders the manifolds island by island; contacts without any dynamic body are dropped
+    void Build(const PhysicsWorld& world, const std::vector<uint32_t>& awakeBodies, std::vector<ContactManifold>& manifolds);
+
+    const std::vector<Island>& GetIslands() const { return m_Islands; }
+    const std::vector<uint32_t>& GetBodies() const { return m_Bodies; }
+
+private:
+    uint32_t Find(uint32_t body);
+    void Union(uint32_t a, uint32_t b);
+    uint32_t IslandOf(const PhysicsWorld& world, const ContactManifold& manifold);
+
+private:
+    std::vector<uint32_t> m_Parent;         // Union-find forest over world bodies
+    std::vector<uint32_t> m_IslandOfRoot;
+
+    std::vector<Island> m_Islands;
+    std::vector<uint32_t> m_Bodies;
+    std::vector<ContactManifold> m_Sorted;  // Scratch, swapped with the manifolds
+};
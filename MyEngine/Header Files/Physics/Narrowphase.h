@@ -0,0 +1,46 @@
+//
+//  Narrowphase.h
+//  MyEngine
+//
+//  Created by Priyanshu Kaushik on 19/10/2026.
+//
+
+#pragma once
+#include <glm/glm.hpp>
+#include "Physics/Contact.h"
+
+// Oriented box in world space
+struct CollisionBox
+{
+    glm::vec3 center = glm::vec3(0.0f);
+    glm::vec3 axes[3] = { glm::vec3(1, 0, 0), glm::vec3(0, 1, 0), glm::vec3(0, 0, 1) };     // Unit length
+    glm::vec3 halfExtents = glm::vec3(0.5f);
+};
+
+struct CollisionSphere
+{
+    glm::vec3 center = glm::vec3(0.0f);
+    float radius = 0.5f;
+};
+
+/**
+ * @brief Contact generation between collider shapes.
+ * * Each test fills the points and the normal (A to B) of a manifold and returns false
+ * when the shapes are further apart than CONTACT_MARGIN. Points closer than the margin
+ * are kept with a negative depth, the solver uses them as speculative contacts.
+ */
+namespace Narrowphase {
+
+constexpr float CONTACT_MARGIN = 0.02f;
+
+bool SphereSphere(const CollisionSphere& a, const CollisionSphere& b, ContactManifold& manifold);
+bool SphereBox(const CollisionSphere& a, const CollisionBox& b, ContactManifold& manifold);
+
+// Separating axis test over the 15 axes. Face contacts clip the incident face against the
+// reference face's side planes (up to 4 points), edge contacts give the closest point pair.
+bool BoxBox(const CollisionBox& a, const CollisionBox& b, ContactManifold& manifold);
+
+// Keeps the 4 points spanning the largest area (deepest one first) of a larger set
+int ReducePoints(ContactPoint* points, int count, const glm::vec3& normal);
+
+}
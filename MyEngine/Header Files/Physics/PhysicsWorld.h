@@ -0,0 +1,100 @@
+//
+//  PhysicsWorld.h
+//  MyEngine
+//
+//  Created by Priyanshu Kaushik on 19/10/2026.
+//
+
+#pragma once
+#include <cstdint>
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+#include "Math/SIMD.h"
+
+/**
+ * @class PhysicsWorld
+ * @brief Rigid body state in structure-of-arrays form, integrated WIDTH bodies at a time.
+ *
+ * Positions, orientations, linear and angular velocities, accumulated accelerations, gravity,
+ * inverse masses and inertias, sleep timers and the awake mask each live in their own aligned
+ * array, padded to whole float4 groups (padding lanes are asleep and never change). Bodies
+ * are addressed by index; PhysicsSystem owns the mapping to entities and copies state in and
+ * out only for bodies that changed.
+ *
+ * Static bodies are kept (so indices match the system's entity list) but never awake.
+ */
+class PhysicsWorld {
+public:
+    void Clear();
+    uint32_t AddBody(const glm::vec3& position, const glm::vec3& velocity);
+    size_t GetBodyCount() const { return m_Count; }
+
+    glm::vec3 GetPosition(uint32_t body) const { return { m_PosX[body], m_PosY[body], m_PosZ[body] }; }
+    glm::vec3 GetVelocity(uint32_t body) const { return { m_VelX[body], m_VelY[body], m_VelZ[body] }; }
+    glm::vec3 GetPreviousPosition(uint32_t body) const { return { m_PrevX[body], m_PrevY[body], m_PrevZ[body] }; }
+    glm::vec3 GetAngularVelocity(uint32_t body) const { return { m_AngX[body], m_AngY[body], m_AngZ[body] }; }
+    glm::quat GetOrientation(uint32_t body) const { return glm::quat(m_RotW[body], m_RotX[body], m_RotY[body], m_RotZ[body]); }
+    void SetPosition(uint32_t body, const glm::vec3& position);
+    // Moves the previous position too, so the jump is not interpolated
+    void Teleport(uint32_t body, const glm::vec3& position);
+    void SetVelocity(uint32_t body, const glm::vec3& velocity);
+    void SetAngularVelocity(uint32_t body, const glm::vec3& angularVelocity);
+    void SetOrientation(uint32_t body, const glm::quat& orientation);
+    void AddAcceleration(uint32_t body, const glm::vec3& acceleration);
+
+    // gravityScale is ignored for kinematic bodies, static bodies go (and stay) to sleep.
+    // Static and kinematic bodies get an infinite mass: contacts never push them.
+    void SetBodyType(uint32_t body, float mass, float gravityScale, bool isStatic, bool isKinematic);
+
+    // Diagonal of the inverse inertia tensor in the body frame (0 = rotation locked on that axis)
+    void SetInverseInertia(uint32_t body, const glm::vec3& inverseInertia);
+    glm::mat3 GetInverseInertiaWorld(uint32_t body) const;
+
+    bool IsAwake(uint32_t body) const { return m_Awake[body] != 0.0f; }
+    float GetSleepTime(uint32_t body) const { return m_SleepTime[body]; }
+    bool IsStatic(uint32_t body) const { return m_Static[body] != 0; }
+    float GetInverseMass(uint32_t body) const { return m_InvMass[body]; }
+    void Wake(uint32_t body);
+    // Puts the body to rest: not integrated and its velocities zeroed
+    void Sleep(uint32_t body);
+    void SetSleepTime(uint32_t body, float sleepTime) { m_SleepTime[body] = sleepTime; }
+
+    // Remembers the current positions as the previous state, call before each fixed step
+    void SavePreviousPositions();
+
+    // Gravity, accelerations and damping into velocities. Accumulated accelerations are consumed.
+    void IntegrateVelocities(float deltaTime);
+
+    // Velocities into positions and orientations (renormalized)
+    void IntegratePositions(float deltaTime);
+
+    // Zeroes crawling velocities and advances the sleep timers of resting bodies. Bodies are
+    // put to sleep by island (PhysicsSystem), once every body of it rested for SLEEP_TIME.
+    void UpdateSleepTimers(float deltaTime);
+
+    static constexpr float GRAVITY = -9.81f;
+    static constexpr float DAMPING_PER_60HZ_FRAME = 0.98f;
+    static constexpr float SLEEP_SPEED = 0.01f;
+    static constexpr float SLEEP_ANGULAR_SPEED = 0.05f;
+    static constexpr float SLEEP_TIME = 0.5f;
+
+private:
+    void Grow();
+    void ResizeLanes(size_t size);
+
+private:
+    size_t m_Count = 0;
+
+    simd::AlignedVector<float> m_PosX, m_PosY, m_PosZ;
+    simd::AlignedVector<float> m_PrevX, m_PrevY, m_PrevZ;    // Positions before the last step
+    simd::AlignedVector<float> m_RotX, m_RotY, m_RotZ, m_RotW;
+    simd::AlignedVector<float> m_VelX, m_VelY, m_VelZ;
+    simd::AlignedVector<float> m_AngX, m_AngY, m_AngZ;
+    simd::AlignedVector<float> m_AccX, m_AccY, m_AccZ;
+    simd::AlignedVector<float> m_Gravity;       // GRAVITY * gravityScale, 0 for kinematic bodies
+    simd::AlignedVector<float> m_InvMass;       // 0 for static and kinematic bodies
+    simd::AlignedVector<float> m_InvInertiaX, m_InvInertiaY, m_InvInertiaZ;
+    simd::AlignedVector<float> m_SleepTime;     // Seconds spent below the sleep speeds
+    simd::AlignedVector<float> m_Awake;         // 1 awake, 0 asleep / static / padding
+    simd::AlignedVector<uint8_t> m_Static;
+};
@@ -0,0 +1,48 @@
+//
+//  Queries.h
+//  MyEngine
+//
+//  Created by Priyanshu Kaushik on 19/10/2026.
+//
+
+#pragma once
+#include <cstdint>
+#include <glm/glm.hpp>
+#include "ECS/ECS.h"
+#include "Physics/Narrowphase.h"
+
+struct RaycastHit
+{
+    Entity entity = UINT32_MAX;         // UINT32_MAX when nothing was hit
+    float distance = 0.0f;              // Along the (normalized) direction
+    glm::vec3 point = glm::vec3(0.0f);
+    glm::vec3 normal = glm::vec3(0.0f); // Of the surface that was hit
+};
+
+// One ray of a batch (PhysicsSystem::RaycastBatch)
+struct RaycastQuery
+{
+    glm::vec3 origin = glm::vec3(0.0f);
+    glm::vec3 direction = glm::vec3(0.0f, 0.0f, 1.0f);
+    float maxDistance = 1000.0f;
+};
+
+/**
+ * @brief Ray tests against collider shapes, used by the PhysicsSystem queries.
+ * * direction must be normalized. Each test returns false when the ray misses or the first
+ * hit is further than maxDistance; a ray starting inside a shape hits it at distance 0.
+ */
+namespace Queries {
+
+bool RaySphere(const glm::vec3& origin, const glm::vec3& direction, float maxDistance, const CollisionSphere& sphere, float& distance, glm::vec3& normal);
+
+// Slab test in the box's frame
+bool RayBox(const glm::vec3& origin, const glm::vec3& direction, float maxDistance, const CollisionBox& box, float& distance, glm::vec3& normal);
+
+// Entry distance into an axis aligned box, for the broadphase
+bool RayAABB(const glm::vec3& origin, const glm::vec3& direction, float maxDistance, const glm::vec3& min, const glm::vec3& max, float& entry);
+
+// Fractions [enter, exit] of start + motion * t, t in [0, 1], over an XZ rectangle (terrain footprint)
+bool ClipSegmentXZ(const glm::vec3& start, const glm::vec3& motion, const glm::vec2& min, const glm::vec2& max, float& enter, float& exit);
+
+}
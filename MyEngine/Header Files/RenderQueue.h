@@ -0,0 +1,83 @@
+//
+//  RenderQueue.h
+//  MyEngine
+//
+//  Created by Priyanshu Kaushik on 19/10/2026.
+//
+
+#pragma once
+#include <vector>
+#include <cstdint>
+#include "ECS/ECS.h"
+
+struct Mesh;
+
+enum class RenderPass : uint8_t {
+    Shadow = 0,
+    Opaque = 1,
+    Transparent = 2,
+    Depth = 3           // Camera depth prepass, no materials
+};
+
+// One draw of one entity, gathered before any GL call is made
+struct DrawPacket
+{
+    uint64_t sortKey = 0;
+    Entity entity = 0;
+    Mesh* mesh = nullptr;
+    uint32_t materialIndex = 0;   // Into the RenderSystem's per-pass material table
+    uint32_t firstIndex = 0;      // Into the MeshPool index buffer
+    uint32_t indexCount = 0;
+};
+
+/**
+ * @class RenderQueue
+ * @brief Collects draw packets and orders them by a 64-bit sort key.
+ * * Key layout (MSB -> LSB): pass(4) | shader(6) | material(20) | mesh(16) | depth(18).
+ * The mesh field holds the MeshPool handle and the LOD level, so packets that can be
+ * drawn as one instanced command are adjacent after sorting.
+ * Sorting groups packets that share state, so submission only touches GL when
+ * the corresponding key bits change. Depth only orders packets within a state group,
+ * front-to-back.
+ * * Transparent keys are pass(4) | inverted depth(24) | unused(36): blending needs a strict
+ * back-to-front order across materials and meshes, so the state fields are left out and
+ * transparent packets are never merged into instanced runs.
+ */
+class RenderQueue {
+public:
+    void Clear() { m_Packets.clear(); }
+    void Push(const DrawPacket& packet) { m_Packets.push_back(packet); }
+
+    // LSD radix sort on the keys (8 bits per pass, constant bytes are skipped)
+    void Sort();
+
+    size_t Size() const { return m_Packets.size(); }
+    bool Empty() const { return m_Packets.empty(); }
+
+    // Packets in sorted order (valid after Sort)
+    const DrawPacket& operator[](size_t i) const { return m_Packets[m_Order[i]]; }
+
+    static uint64_t MakeKey(RenderPass pass, uint32_t shaderID, uint32_t materialID, uint32_t meshID, float depth01);
+
+    // Key field extraction, used by submission to detect state changes (not for transparent keys)
+    static uint32_t GetMaterialBits(uint64_t key) { return static_cast<uint32_t>((key >> MATERIAL_SHIFT) & MATERIAL_MASK); }
+    static uint32_t GetMeshBits(uint64_t key) { return static_cast<uint32_t>((key >> MESH_SHIFT) & MESH_MASK); }
+
+    static constexpr uint64_t DEPTH_MASK = (1ull << 18) - 1;
+    static constexpr uint64_t MESH_MASK = (1ull << 16) - 1;
+    static constexpr uint64_t MATERIAL_MASK = (1ull << 20) - 1;
+    static constexpr uint64_t SHADER_MASK = (1ull << 6) - 1;
+    static constexpr uint64_t PASS_MASK = (1ull << 4) - 1;
+    static constexpr uint64_t TRANSPARENT_DEPTH_MASK = (1ull << 24) - 1;
+
+    static constexpr int MESH_SHIFT = 18;
+    static constexpr int MATERIAL_SHIFT = 34;
+    static constexpr int SHADER_SHIFT = 54;
+    static constexpr int PASS_SHIFT = 60;
+    static constexpr int TRANSPARENT_DEPTH_SHIFT = 36;
+
+private:
+    std::vector<DrawPacket> m_Packets;
+    std::vector<uint32_t> m_Order;
+    std::vector<uint32_t> m_Scratch;
+};
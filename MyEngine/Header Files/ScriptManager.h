@@ -7,9 +7,13 @@
 
 #pragma once
 #include "sol/sol.hpp"
+#include "ECS/ECS.h"
+#include <glm/glm.hpp>
 #include <unordered_map>
 
 class Coordinator;
+class PhysicsSystem;
+struct TransformComponent;
 
 class ScriptManager {
 public:
@@ -20,8 +24,27 @@ public:
     sol::state& GetLuaState() { return m_Lua; }
     
     void SetCoordinator(Coordinator* aCoordinator);
+    void SetPhysicsSystem(PhysicsSystem* physicsSystem) { m_PhysicsSystem = physicsSystem; }
+    
+    // Scripts write transform fields in place (transform.position.x = 1), which skips the
+    // setters. Call around the script updates of a frame: every transform a script got that
+    // changed in between is marked dirty and gets its revision bumped, like a setter call.
+    void BeginTransformEdits();
+    void CommitTransformEdits();
 private:
+    struct WatchedTransform
+    {
+        glm::vec3 position;
+        glm::vec3 rotation;
+        glm::vec3 scale;
+    };
+    
+    void WatchTransform(Entity entity, const TransformComponent& transform);
+    
     Coordinator* m_Coordinator;
+    PhysicsSystem* m_PhysicsSystem = nullptr;
     sol::state m_Lua;
     std::unordered_map<std::string, sol::protected_function> m_CompiledScripts;
+    // Every transform handed to a script, as it was before this frame's scripts ran
+    std::unordered_map<Entity, WatchedTransform> m_WatchedTransforms;
 };
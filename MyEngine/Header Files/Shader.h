@@ -8,28 +8,58 @@
 #pragma once
 #include <string>
 #include <vector>
+#include <unordered_map>
+#include <cstdint>
 #include <glm/glm.hpp>
 
+// Hashed uniform name (FNV-1a). Hot paths keep these as static constexpr
+// so no string is built or hashed per call.
+struct UniformID
+{
+    uint32_t hash;
+
+    constexpr UniformID(const char* name) : hash(Hash(name)) {}
+    UniformID(const std::string& name) : hash(Hash(name.c_str())) {}
+
+    static constexpr uint32_t Hash(const char* name)
+    {
+        uint32_t h = 2166136261u;
+        while (*name) {
+            h ^= static_cast<uint8_t>(*name++);
+            h *= 16777619u;
+        }
+        return h;
+    }
+};
+
 class Shader{
 public:
     std::string m_VertexPath;
     std::string m_FragmentPath;
     Shader(const char* aVertexPath, const char* aFragmentPath);
     void Use();
-    void SetMatrix4(glm::mat4 aMatrix, const std::string& aName) const;
-    void SetBool(bool booleanToSet, const std::string& aName) const;
-    void SetVec3(const std::string& name, const glm::vec3& value) const;
-    void SetVec3Array(const std::string& name, const std::vector<glm::vec3>& values) const;
-    void SetVec4(const std::string& name, const glm::vec4& value) const;
-    void SetVec4Array(const std::string& name, const std::vector<glm::vec4>& values) const;
+    void SetMatrix4(const glm::mat4& aMatrix, UniformID aName) const;
+    void SetBool(bool booleanToSet, UniformID aName) const;
+    void SetVec3(UniformID name, const glm::vec3& value) const;
+    void SetVec3Array(UniformID name, const std::vector<glm::vec3>& values) const;
+    void SetVec4(UniformID name, const glm::vec4& value) const;
+    void SetVec4Array(UniformID name, const std::vector<glm::vec4>& values) const;
     
     
-    void SetFloat(const std::string& name, float value) const;
-    void SetInt(const std::string& name, int value) const;
+    void SetFloat(UniformID name, float value) const;
+    void SetInt(UniformID name, int value) const;
+    
+    // -1 when the uniform is not active in the program (GL ignores -1)
+    int GetUniformLocation(UniformID name) const;
+    
     void Reload();
-    unsigned int shaderProgram;
+    unsigned int shaderProgram = 0;
 private:
     std::string LoadShader(const char *aPath);
     unsigned int LoadVertexShader();
     unsigned int LoadFragmentShader();
+    void ReflectUniforms();
+    
+    // Filled from the active uniforms after every successful link
+    std::unordered_map<uint32_t, int> m_UniformLocations;
 };
@@ -14,6 +14,9 @@ class ShaderManager {
 public:
     void Init() {
         AddShader("Main", "Shaders/VertexShader.glsl", "Shaders/FragmentShader.glsl");
+        AddShader("GBuffer", "Shaders/VertexShader.glsl", "Shaders/GBufferFragmentShader.glsl");
+        AddShader("DeferredLighting", "Shaders/FullscreenVertexShader.glsl", "Shaders/DeferredLightingFragmentShader.glsl");
+        AddShader("HiZDownsample", "Shaders/FullscreenVertexShader.glsl", "Shaders/HiZDownsampleFragmentShader.glsl");
         AddShader("ShadowMap", "Shaders/ShadowDepthVertexShader.glsl", "Shaders/ShadowDepthFragmentShader.glsl");
         AddShader("DebugShader", "Shaders/DebugGizmosVertexShader.glsl", "Shaders/DebugGizmosFragmentShader.glsl");
     }
@@ -0,0 +1,133 @@
+//
+//  TerrainStreamer.h
+//  MyEngine
+//
+//  Created by Priyanshu Kaushik on 19/10/2026.
+//
+
+#pragma once
+#include "GLAD/include/glad/glad.h"
+#include "TerrainTileFile.h"
+#include "AssetData.h"
+#include "Math/Bounds.h"
+#include <glm/glm.hpp>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+struct TerrainComponent;
+
+/**
+ * @class TerrainStreamer
+ * @brief Keeps the tiles of a .metile pyramid around the camera resident, within a memory budget.
+ * * Every frame the pyramid is walked from the coarsest level: a tile close enough to the camera
+ * is refined into its 4 children once they are all resident, otherwise it is drawn itself, so
+ * the drawn set never has holes. Missing tiles are decoded by JobSystem workers (coarse levels
+ * first) and turned into chunk meshes on the main thread, each in a fixed slot of one VBO.
+ * Resident tiles are kept in an LRU list; when the budget is used up the least recently used
+ * tile not needed this frame gives its slot away. The coarsest level is never evicted.
+ */
+class TerrainStreamer {
+public:
+    // Tile drawn this frame (terrain local space)
+    struct DrawTile
+    {
+        AABB bounds;
+        GLint baseVertex = 0;
+    };
+
+    TerrainStreamer() = default;
+    ~TerrainStreamer() { Close(); }
+    TerrainStreamer(const TerrainStreamer&) = delete;
+    TerrainStreamer& operator=(const TerrainStreamer&) = delete;
+
+    // chunkIndexBuffer: TerrainSystem's shared chunk indices, bound to the streamer's VAO
+    bool Open(const std::string& tilePath, GLuint chunkIndexBuffer, size_t memoryBudget = DEFAULT_BUDGET);
+    void Close();
+
+    // Residency and tile selection. refineDistance = distance below which level 0 is wanted,
+    // doubling per level (same rule as chunk LOD selection).
+    void Update(const TerrainComponent& terrain, const glm::vec3& cameraLocal, float refineDistance);
+
+    const std::vector<DrawTile>& GetDrawList() const { return m_DrawList; }
+    GLuint GetVAO() const { return m_VAO; }
+    int GetWidth() const { return m_File ? m_File->GetWidth() : 0; }
+    int GetHeight() const { return m_File ? m_File->GetHeight() : 0; }
+
+    // Normalized [0, 1] height from the finest resident tile at a heightmap grid position
+    bool SampleHeight(float gridX, float gridZ, float& outHeight) const;
+
+    size_t GetResidentCount() const { return m_Resident.size(); }
+    size_t GetSlotCount() const { return m_SlotCount; }
+
+    static constexpr size_t DEFAULT_BUDGET = 256u * 1024u * 1024u;
+    static constexpr int MAX_LOADS_IN_FLIGHT = 8;
+
+private:
+    struct Tile
+    {
+        int level = 0, x = 0, z = 0;
+        int slot = -1;
+        bool pinned = false;            // Coarsest level, never evicted
+        uint64_t lastUsedFrame = 0;
+        std::vector<uint16_t> samples;  // TILE_SAMPLES^2, kept for height queries and rebuilds
+        std::list<uint64_t>::iterator lru;
+    };
+
+    struct LoadedTile
+    {
+        uint64_t key = 0;
+        bool ok = false;
+        std::vector<uint16_t> samples;
+    };
+
+    // Filled by workers, drained on the main thread. Shared so jobs outliving the streamer stay valid.
+    struct LoadQueue
+    {
+        std::mutex mutex;
+        std::vector<LoadedTile> done;
+    };
+
+    struct Request
+    {
+        int level, x, z;
+        float distance;
+    };
+
+    static uint64_t MakeKey(int level, int x, int z) { return ((uint64_t)level << 48) | ((uint64_t)z << 24) | (uint64_t)x; }
+
+    void Select(int level, int x, int z, const glm::vec3& cameraLocal, float refineDistance);
+    Tile* Find(int level, int x, int z);
+    const Tile* Find(int level, int x, int z) const;
+    void Touch(Tile& tile);
+    void RequestTile(int level, int x, int z, float distance);
+    void IssueLoads();
+    void ReceiveLoads(const TerrainComponent& terrain);
+    int AcquireSlot();
+    void UploadTile(const TerrainComponent& terrain, const Tile& tile);
+    AABB GetTileBounds(int level, int x, int z) const;
+
+private:
+    std::shared_ptr<TerrainTileFile> m_File;
+    std::shared_ptr<LoadQueue> m_LoadQueue;
+    std::unordered_set<uint64_t> m_InFlight;
+    std::unordered_set<uint64_t> m_Failed;     // Not requested again
+
+    std::unordered_map<uint64_t, Tile> m_Resident;
+    std::list<uint64_t> m_LRU;                  // Front = most recently used
+    std::vector<int> m_FreeSlots;
+    size_t m_SlotCount = 0;
+
+    GLuint m_VAO = 0, m_VBO = 0;
+    std::vector<Vertex> m_Scratch;
+
+    std::vector<Request> m_Requests;
+    std::vector<DrawTile> m_DrawList;
+    uint64_t m_Frame = 0;
+
+    // Mesh parameters the resident slots were built with, a change rebuilds them
+    float m_BuiltScale = 0.0f, m_BuiltMaxHeight = 0.0f;
+};
@@ -0,0 +1,75 @@
+//
+//  TerrainTileFile.h
+//  MyEngine
+//
+//  Created by Priyanshu Kaushik on 19/10/2026.
+//
+
+#pragma once
+#include <string>
+#include <vector>
+#include <cstdint>
+
+// Directory entry of one tile
+struct TerrainTileEntry
+{
+    uint64_t offset = 0;        // Compressed blob, absolute file offset
+    uint32_t size = 0;
+    uint16_t minHeight = 0;     // Over the tile's own samples (apron excluded)
+    uint16_t maxHeight = 0;
+};
+
+/**
+ * @class TerrainTileFile
+ * @brief Preprocessed heightmap pyramid (.metile) for streamed terrain.
+ * * Level 0 holds the full resolution heights, every further level every second sample of the
+ * one below, until one tile covers the whole map. A tile of level L covers TILE_QUADS quads of
+ * that level (TILE_QUADS * 2^L heightmap texels) and stores its samples as 16 bit heights plus a
+ * one sample apron, so normals at the tile border need no neighbour.
+ * Tiles are compressed independently (row deltas, zigzag + varint) and addressed through a
+ * directory that also carries their height range, so bounds are known before a tile is loaded.
+ * ReadTile opens its own stream and can be called from any thread.
+ */
+class TerrainTileFile {
+public:
+    static constexpr int TILE_QUADS = 64;                              // Matches TerrainSystem::CHUNK_QUADS
+    static constexpr int APRON = 1;
+    static constexpr int TILE_SAMPLES = TILE_QUADS + 1 + 2 * APRON;    // 67 x 67 per tile
+
+    // Heightmap image (8 or 16 bit) -> tile pyramid on disk
+    static bool Build(const std::string& heightmapPath, const std::string& tilePath);
+
+    // Reads the header and the directory
+    bool Open(const std::string& tilePath);
+
+    bool ReadTile(int level, int x, int z, std::vector<uint16_t>& outSamples) const;
+
+    int GetWidth() const { return m_Width; }
+    int GetHeight() const { return m_Height; }
+    int GetLevelCount() const { return (int)m_Levels.size(); }
+    int GetTilesX(int level) const { return m_Levels[level].tilesX; }
+    int GetTilesZ(int level) const { return m_Levels[level].tilesZ; }
+    // Over all levels
+    size_t GetTileCount() const { return m_Entries.size(); }
+    const TerrainTileEntry& GetEntry(int level, int x, int z) const
+    {
+        const Level& l = m_Levels[level];
+        return m_Entries[l.firstEntry + z * l.tilesX + x];
+    }
+
+private:
+    struct Level { int tilesX = 0, tilesZ = 0; uint32_t firstEntry = 0; };
+
+    static std::vector<Level> ComputeLevels(int width, int height);
+    static void Encode(const std::vector<uint16_t>& samples, std::vector<uint8_t>& out);
+    static bool Decode(const uint8_t* data, size_t size, std::vector<uint16_t>& outSamples);
+
+private:
+    std::string m_Path;
+    int m_Width = 0, m_Height = 0;
+    std::vector<Level> m_Levels;
+    std::vector<TerrainTileEntry> m_Entries;
+
+    static constexpr uint32_t MAGIC = 0x4C54454D;   // "METL"
+    static constexpr uint32_t VERSION = 1;
+};
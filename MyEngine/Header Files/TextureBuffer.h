@@ -0,0 +1,69 @@
+//
+//  TextureBuffer.h
+//  MyEngine
+//
+//  Created by Priyanshu Kaushik on 19/10/2026.
+//
+
+#pragma once
+#include "GLAD/include/glad/glad.h"
+
+/**
+ * @class TextureBuffer
+ * @brief Buffer texture (samplerBuffer / usamplerBuffer) for per-frame arrays too big for a
+ * uniform block. Stands in for SSBOs, which GL 4.1 does not have.
+ * * glTexBufferRange is GL 4.3, so it owns its storage instead of living in the frame ring.
+ */
+class TextureBuffer {
+public:
+    void Create(GLenum format, GLsizeiptr capacity)
+    {
+        m_Format = format;
+        m_Capacity = capacity;
+        glGenBuffers(1, &m_Buffer);
+        glBindBuffer(GL_TEXTURE_BUFFER, m_Buffer);
+        glBufferData(GL_TEXTURE_BUFFER, capacity, nullptr, GL_STREAM_DRAW);
+
+        glGenTextures(1, &m_Texture);
+        glBindTexture(GL_TEXTURE_BUFFER, m_Texture);
+        glTexBuffer(GL_TEXTURE_BUFFER, format, m_Buffer);
+
+        glBindTexture(GL_TEXTURE_BUFFER, 0);
+        glBindBuffer(GL_TEXTURE_BUFFER, 0);
+    }
+
+    void Destroy()
+    {
+        if (m_Texture) glDeleteTextures(1, &m_Texture);
+        if (m_Buffer) glDeleteBuffers(1, &m_Buffer);
+        m_Texture = m_Buffer = 0;
+        m_Capacity = 0;
+    }
+
+    bool IsValid() const { return m_Buffer != 0; }
+
+    // Orphans the storage (the GPU may still read last frame's) and writes the new content.
+    // Only grows, never shrinks.
+    void Upload(const void* data, GLsizeiptr size)
+    {
+        if (size <= 0) return;
+        if (size > m_Capacity) m_Capacity = size + size / 2;
+
+        glBindBuffer(GL_TEXTURE_BUFFER, m_Buffer);
+        glBufferData(GL_TEXTURE_BUFFER, m_Capacity, nullptr, GL_STREAM_DRAW);
+        glBufferSubData(GL_TEXTURE_BUFFER, 0, size, data);
+        glBindBuffer(GL_TEXTURE_BUFFER, 0);
+    }
+
+    void Bind(int unit) const
+    {
+        glActiveTexture(GL_TEXTURE0 + unit);
+        glBindTexture(GL_TEXTURE_BUFFER, m_Texture);
+    }
+
+private:
+    GLuint m_Buffer = 0;
+    GLuint m_Texture = 0;
+    GLenum m_Format = GL_R32UI;
+    GLsizeiptr m_Capacity = 0;
+};
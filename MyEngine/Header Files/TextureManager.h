@@ -19,6 +19,8 @@ public:
     bool LoadTexture(const std::string& path, TextureData* target);
     
     unsigned char* LoadRawData(const std::string& path, int& width, int& height, int& channels);
+    // Single channel at 16 bits (8 bit sources are widened), free with stbi_image_free
+    unsigned short* LoadRawData16(const std::string& path, int& width, int& height, int& channels);
     AssetHandle GetTexture(uint32_t textureId);
     AssetHandle GetTexture(const std::string& path);
     std::unordered_map<std::string, uint32_t>& GetAllTextures(){return m_PathToID;}
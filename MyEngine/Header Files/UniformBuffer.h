@@ -0,0 +1,134 @@
+//
+//  UniformBuffer.h
+//  MyEngine
+//
+//  Created by Priyanshu Kaushik on 19/10/2026.
+//
+
+#pragma once
+#include "GLAD/include/glad/glad.h"
+#include "GPURingBuffer.h"
+#include <glm/glm.hpp>
+#include <cstdint>
+
+// Binding points of the std140 blocks shared by all shaders (assigned in Shader::Reload)
+enum class UniformBinding : GLuint {
+    Frame = 0,
+    Light = 1,
+    Material = 2
+};
+
+// Directional lights go through the uniform block, point/spot lights are clustered (no cap)
+constexpr int MAX_DIRECTIONAL_LIGHTS = 4;
+constexpr int SHADOW_CASCADES = 4;
+
+// C++ mirrors of the GLSL blocks. Only vec4/ivec4/mat4 members, so the
+// C++ layout matches std140 without manual padding.
+
+// layout(std140) uniform FrameData
+struct FrameUniforms
+{
+    glm::mat4 view;
+    glm::mat4 projection;
+    glm::mat4 viewProjection;
+    glm::mat4 cascadeMatrices[SHADOW_CASCADES];   // Light view-projection per cascade
+    glm::vec4 cascadeSplits;                      // Far view depth of each cascade
+    glm::vec4 eyePosition;
+};
+
+// layout(std140) uniform LightData
+struct LightUniforms
+{
+    glm::vec4 ambient;
+    glm::ivec4 count;                                  // x = directional lights, y = clustered lights
+    glm::ivec4 clusterGrid;                            // Tiles X, tiles Y, depth slices
+    glm::vec4 clusterParams;                           // Slice scale, slice bias, 1 / viewport width, 1 / viewport height
+    glm::vec4 direction[MAX_DIRECTIONAL_LIGHTS];
+    glm::vec4 diffuse[MAX_DIRECTIONAL_LIGHTS];
+    glm::vec4 specular[MAX_DIRECTIONAL_LIGHTS];
+};
+
+// layout(std140) uniform MaterialData
+struct MaterialUniforms
+{
+    glm::vec4 ambient;
+    glm::vec4 diffuse;
+    glm::vec4 specular;                    // w = shininess
+    glm::ivec4 flags;                      // x = albedo map, y = normal map, z = specular map
+};
+
+/**
+ * @class UniformBuffer
+ * @brief Thin wrapper over a GL_UNIFORM_BUFFER attached to one UniformBinding.
+ */
+class UniformBuffer {
+public:
+    void Create(GLsizeiptr size, UniformBinding binding)
+    {
+        m_Binding = binding;
+        m_Size = size;
+        glGenBuffers(1, &m_Buffer);
+        glBindBuffer(GL_UNIFORM_BUFFER, m_Buffer);
+        glBufferData(GL_UNIFORM_BUFFER, size, nullptr, GL_DYNAMIC_DRAW);
+        glBindBuffer(GL_UNIFORM_BUFFER, 0);
+        Bind();
+    }
+
+    void Destroy()
+    {
+        if (m_Buffer) glDeleteBuffers(1, &m_Buffer);
+        m_Buffer = 0;
+        m_Size = 0;
+    }
+
+    bool IsValid() const { return m_Buffer != 0; }
+
+    // Replaces the content in place. Only reallocates when it has to grow.
+    // Meant for rarely changing data, per-frame data goes through the GPURingBuffer.
+    void Upload(const void* data, GLsizeiptr size)
+    {
+        glBindBuffer(GL_UNIFORM_BUFFER, m_Buffer);
+        if (size > m_Size) {
+            m_Size = size;
+            glBufferData(GL_UNIFORM_BUFFER, size, data, GL_DYNAMIC_DRAW);
+        }
+        else {
+            glBufferSubData(GL_UNIFORM_BUFFER, 0, size, data);
+        }
+        glBindBuffer(GL_UNIFORM_BUFFER, 0);
+    }
+
+    void Bind() const
+    {
+        glBindBufferBase(GL_UNIFORM_BUFFER, static_cast<GLuint>(m_Binding), m_Buffer);
+    }
+
+    void BindRange(GLintptr offset, GLsizeiptr size) const
+    {
+        glBindBufferRange(GL_UNIFORM_BUFFER, static_cast<GLuint>(m_Binding), m_Buffer, offset, size);
+    }
+
+    GLuint GetBuffer() const { return m_Buffer; }
+
+    // Required alignment for BindRange offsets (usually 256 bytes). Queried once.
+    static GLint GetOffsetAlignment()
+    {
+        static GLint alignment = 0;
+        if (alignment == 0) {
+            alignment = 256;
+            glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &alignment);
+        }
+        return alignment;
+    }
+
+private:
+    GLuint m_Buffer = 0;
+    GLsizeiptr m_Size = 0;
+    UniformBinding m_Binding = UniformBinding::Frame;
+};
+
+// Attaches a per-frame ring allocation to a block binding point
+inline void BindUniformRange(UniformBinding binding, const GPUAllocation& allocation)
+{
+    glBindBufferRange(GL_UNIFORM_BUFFER, static_cast<GLuint>(binding), allocation.buffer, allocation.offset, allocation.size);
+}
@@ -0,0 +1,163 @@
+//
+//  DeferredLightingFragmentShader.glsl
+//  MyEngine
+//
+//  Created by Priyanshu Kaushik on 19/10/2026.
+//
+
+#version 330 core
+#define MAX_DIRECTIONAL_LIGHTS 4
+#define SHADOW_CASCADES 4
+
+out vec4 FragColor;
+
+in vec2 TexCoord;
+
+// G-buffer (see GBufferFragmentShader.glsl)
+uniform sampler2D gPosition;
+uniform sampler2D gNormal;
+uniform sampler2D gAlbedoSpec;
+uniform sampler2DArray shadowMap;   // One layer per cascade
+
+// Clustered point lights
+uniform samplerBuffer u_PointLights;            // 3 texels per light: position + range, color, attenuation
+uniform usamplerBuffer u_ClusterRanges;         // Per cluster: offset, count
+uniform usamplerBuffer u_ClusterLightIndices;
+
+layout (std140) uniform FrameData {
+    mat4 view;
+    mat4 projection;
+    mat4 viewProjection;
+    mat4 cascadeMatrices[SHADOW_CASCADES];
+    vec4 cascadeSplits;            // Far view depth of each cascade
+    vec4 eyePosition;
+} u_Frame;
+
+layout (std140) uniform LightData {
+    vec4 ambient;
+    ivec4 count;                   // x = directional lights, y = clustered lights
+    ivec4 clusterGrid;             // Tiles X, tiles Y, depth slices
+    vec4 clusterParams;            // Slice scale, slice bias, 1 / viewport width, 1 / viewport height
+    vec4 direction[MAX_DIRECTIONAL_LIGHTS];
+    vec4 diffuse[MAX_DIRECTIONAL_LIGHTS];
+    vec4 specular[MAX_DIRECTIONAL_LIGHTS];
+} u_Lights;
+
+
+float CalcShadowFactor(vec3 worldPos, vec3 normal, vec3 lightDir) {
+    // Pick the first cascade whose far split is beyond this fragment
+    float viewDepth = -(u_Frame.view * vec4(worldPos, 1.0)).z;
+    int cascade = -1;
+    for (int i = SHADOW_CASCADES - 1; i >= 0; --i)
+        if (viewDepth < u_Frame.cascadeSplits[i]) cascade = i;
+    if (cascade < 0) return 0.0;
+    
+    vec4 shadowSpace = u_Frame.cascadeMatrices[cascade] * vec4(worldPos, 1.0);
+    vec3 projCoords = shadowSpace.xyz / shadowSpace.w;
+    projCoords = projCoords * 0.5 + 0.5;
+
+    if(projCoords.z > 1.0) return 0.0;
+    
+    float currentDepth = projCoords.z;
+
+    // Farther cascades cover more world per texel
+    float bias = max(0.005 * (1.0 - dot(normal, lightDir)), 0.0005) * float(cascade + 1);
+    
+    float shadow = 0.0;
+    vec2 texelSize = 1.0 / vec2(textureSize(shadowMap, 0).xy);
+    
+    for(int x = -2; x <= 2; ++x)
+    {
+        for(int y = -2; y <= 2; ++y)
+        {
+            float pcfDepth = texture(shadowMap, vec3(projCoords.xy + vec2(x, y) * texelSize, float(cascade))).r;
+            shadow += currentDepth - bias > pcfDepth ? 1.0 : 0.0;
+        }
+    }
+    
+    shadow /= 25.0;
+    return shadow;
+}
+
+// Blinn-Phong diffuse + specular of one light, material values come from the G-buffer
+vec3 ShadeLight(vec3 norm, vec3 viewDir, vec3 lightDir, vec3 diffuseColor, vec3 specularColor, vec3 albedo, float specularIntensity, float shininess)
+{
+    float diff = max(dot(norm, lightDir), 0.0);
+    vec3 diffuse = diff * diffuseColor * albedo;
+
+    vec3 specular = vec3(0.0);
+    if (diff > 0.0)
+    {
+        vec3 halfVector = normalize(lightDir + viewDir);
+        float specAngle = max(dot(norm, halfVector), 0.0);
+        float spec = pow(specAngle, shininess);
+        specular = spec * specularColor * specularIntensity;
+    }
+    return diffuse + specular;
+}
+
+int GetClusterIndex(float viewDepth)
+{
+    ivec2 tile = ivec2(gl_FragCoord.xy * u_Lights.clusterParams.zw * vec2(u_Lights.clusterGrid.xy));
+    tile = clamp(tile, ivec2(0), u_Lights.clusterGrid.xy - 1);
+    int slice = int(floor(log(max(viewDepth, 1e-4)) * u_Lights.clusterParams.x + u_Lights.clusterParams.y));
+    slice = clamp(slice, 0, u_Lights.clusterGrid.z - 1);
+    return (slice * u_Lights.clusterGrid.y + tile.y) * u_Lights.clusterGrid.x + tile.x;
+}
+
+void main()
+{
+    vec4 positionAmbient = texture(gPosition, TexCoord);
+    vec4 normalShininess = texture(gNormal, TexCoord);
+    vec4 albedoSpec = texture(gAlbedoSpec, TexCoord);
+
+    // Nothing was drawn here, keep the clear color
+    if (dot(normalShininess.xyz, normalShininess.xyz) < 0.01) discard;
+
+    vec3 FragPos = positionAmbient.xyz;
+    vec3 norm = normalize(normalShininess.xyz);
+    vec3 albedo = albedoSpec.rgb;
+    float specularIntensity = albedoSpec.a;
+    float shininess = normalShininess.w;
+    vec3 viewDir = normalize(u_Frame.eyePosition.xyz - FragPos);
+
+    vec3 ambient = positionAmbient.w * u_Lights.ambient.rgb * albedo;
+    vec3 totalDiffuseSpecular = vec3(0.0);
+
+    // Directional lights (shadowed)
+    for(int i = 0; i < u_Lights.count.x; i++)
+    {
+        vec3 lightDir = normalize(-u_Lights.direction[i].xyz);
+        float shadow = CalcShadowFactor(FragPos, norm, lightDir);
+        totalDiffuseSpecular += ShadeLight(norm, viewDir, lightDir, u_Lights.diffuse[i].rgb, u_Lights.specular[i].rgb,
+                                           albedo, specularIntensity, shininess) * (1.0 - shadow);
+    }
+
+    // Point lights of this pixel's cluster only
+    if (u_Lights.count.y > 0)
+    {
+        float viewDepth = -(u_Frame.view * vec4(FragPos, 1.0)).z;
+        uvec2 range = texelFetch(u_ClusterRanges, GetClusterIndex(viewDepth)).xy;
+
+        for (uint i = 0u; i < range.y; i++)
+        {
+            int lightIndex = int(texelFetch(u_ClusterLightIndices, int(range.x + i)).r);
+            vec4 positionRange = texelFetch(u_PointLights, lightIndex * 3);
+            vec3 color = texelFetch(u_PointLights, lightIndex * 3 + 1).rgb;
+            vec3 falloff = texelFetch(u_PointLights, lightIndex * 3 + 2).xyz;
+
+            vec3 toLight = positionRange.xyz - FragPos;
+            float distance = length(toLight);
+            if (distance >= positionRange.w) continue;
+
+            float attenuation = 1.0 / (falloff.x + falloff.y * distance + falloff.z * (distance * distance));
+            float window = clamp(1.0 - pow(distance / positionRange.w, 4.0), 0.0, 1.0);
+            attenuation *= window * window;
+
+            totalDiffuseSpecular += ShadeLight(norm, viewDir, toLight / distance, color, color,
+                                               albedo, specularIntensity, shininess) * attenuation;
+        }
+    }
+
+    FragColor = vec4(ambient + totalDiffuseSpecular, 1.0);
+}
@@ -6,43 +6,62 @@
 //
 
 #version 330 core
-#define MAX_LIGHTS 10
-
-struct Material {
-    vec3 ambient;
-    vec3 diffuse;
-    vec3 specular;
-    float shininess;
-};
+#define MAX_DIRECTIONAL_LIGHTS 4
+#define SHADOW_CASCADES 4
 
 out vec4 FragColor;
 
 in vec3 FragPos;
 in vec3 Normal;
 in vec2 TexCoord;
-in vec4 FragPosShadowSpace;
 in mat3 TBN;
 
 uniform sampler2D mainTexture;
 uniform sampler2D normalMap;
 uniform sampler2D specularMap;
-uniform sampler2D shadowMap;
-
-uniform int u_LightCount = 0;
-uniform vec4 u_Light_ambient = vec4(1,1,1,1);
-uniform vec4 u_Light_diffuse[MAX_LIGHTS];
-uniform vec4 u_Light_specular[MAX_LIGHTS];
-uniform vec4 u_Light_position[MAX_LIGHTS];
-uniform vec3 u_Light_attenuation[MAX_LIGHTS];
-
-uniform Material u_Material;
-uniform bool u_HasTexture;
-uniform bool u_HasSpecularMap;
-uniform bool u_HasNormalMap;
-uniform vec3 eyePosition;
-
-
-float CalcShadowFactor(vec4 shadowSpace, vec3 normal, vec3 lightDir) {
+uniform sampler2DArray shadowMap;   // One layer per cascade
+
+// Clustered point lights
+uniform samplerBuffer u_PointLights;            // 3 texels per light: position + range, color, attenuation
+uniform usamplerBuffer u_ClusterRanges;         // Per cluster: offset, count
+uniform usamplerBuffer u_ClusterLightIndices;
+
+layout (std140) uniform FrameData {
+    mat4 view;
+    mat4 projection;
+    mat4 viewProjection;
+    mat4 cascadeMatrices[SHADOW_CASCADES];
+    vec4 cascadeSplits;            // Far view depth of each cascade
+    vec4 eyePosition;
+} u_Frame;
+
+layout (std140) uniform LightData {
+    vec4 ambient;
+    ivec4 count;                   // x = directional lights, y = clustered lights
+    ivec4 clusterGrid;             // Tiles X, tiles Y, depth slices
+    vec4 clusterParams;            // Slice scale, slice bias, 1 / viewport width, 1 / viewport height
+    vec4 direction[MAX_DIRECTIONAL_LIGHTS];
+    vec4 diffuse[MAX_DIRECTIONAL_LIGHTS];
+    vec4 specular[MAX_DIRECTIONAL_LIGHTS];
+} u_Lights;
+
+layout (std140) uniform MaterialData {
+    vec4 ambient;
+    vec4 diffuse;                  // w = opacity
+    vec4 specular;                 // w = shininess
+    ivec4 flags;                   // x = albedo map, y = normal map, z = specular map
+} u_Material;
+
+
+float CalcShadowFactor(vec3 worldPos, vec3 normal, vec3 lightDir) {
+    // Pick the first cascade whose far split is beyond this fragment
+    float viewDepth = -(u_Frame.view * vec4(worldPos, 1.0)).z;
+    int cascade = -1;
+    for (int i = SHADOW_CASCADES - 1; i >= 0; --i)
+        if (viewDepth < u_Frame.cascadeSplits[i]) cascade = i;
+    if (cascade < 0) return 0.0;
+    
+    vec4 shadowSpace = u_Frame.cascadeMatrices[cascade] * vec4(worldPos, 1.0);
     vec3 projCoords = shadowSpace.xyz / shadowSpace.w;
     projCoords = projCoords * 0.5 + 0.5;
 
@@ -50,16 +69,17 @@ float CalcShadowFactor(vec4 shadowSpace, vec3 normal, vec3 lightDir) {
     
     float currentDepth = projCoords.z;
 
-    float bias = max(0.05 * (1.0 - dot(normal, lightDir)), 0.005);
+    // Farther cascades cover more world per texel
+    float bias = max(0.005 * (1.0 - dot(normal, lightDir)), 0.0005) * float(cascade + 1);
     
     float shadow = 0.0;
-    vec2 texelSize = 1.0 / textureSize(shadowMap, 0);
+    vec2 texelSize = 1.0 / vec2(textureSize(shadowMap, 0).xy);
     
     for(int x = -2; x <= 2; ++x)
     {
         for(int y = -2; y <= 2; ++y)
         {
-            float pcfDepth = texture(shadowMap, projCoords.xy + vec2(x, y) * texelSize).r;
+            float pcfDepth = texture(shadowMap, vec3(projCoords.xy + vec2(x, y) * texelSize, float(cascade))).r;
             shadow += currentDepth - bias > pcfDepth ? 1.0 : 0.0;
         }
     }
@@ -68,60 +88,86 @@ float CalcShadowFactor(vec4 shadowSpace, vec3 normal, vec3 lightDir) {
     return shadow;
 }
 
+// Blinn-Phong diffuse + specular of one light
+vec3 ShadeLight(vec3 norm, vec3 viewDir, vec3 lightDir, vec3 diffuseColor, vec3 specularColor, vec3 texColor, vec3 specularTexel)
+{
+    float diff = max(dot(norm, lightDir), 0.0);
+    vec3 diffuse = diff * u_Material.diffuse.rgb * diffuseColor * texColor;
+
+    vec3 specular = vec3(0.0);
+    if (diff > 0.0)
+    {
+        vec3 halfVector = normalize(lightDir + viewDir);
+        float specAngle = max(dot(norm, halfVector), 0.0);
+        float spec = pow(specAngle, u_Material.specular.w);
+        specular = spec * u_Material.specular.rgb * specularColor * specularTexel;
+    }
+    return diffuse + specular;
+}
+
+int GetClusterIndex(float viewDepth)
+{
+    ivec2 tile = ivec2(gl_FragCoord.xy * u_Lights.clusterParams.zw * vec2(u_Lights.clusterGrid.xy));
+    tile = clamp(tile, ivec2(0), u_Lights.clusterGrid.xy - 1);
+    int slice = int(floor(log(max(viewDepth, 1e-4)) * u_Lights.clusterParams.x + u_Lights.clusterParams.y));
+    slice = clamp(slice, 0, u_Lights.clusterGrid.z - 1);
+    return (slice * u_Lights.clusterGrid.y + tile.y) * u_Lights.clusterGrid.x + tile.x;
+}
+
 void main()
 {
     vec3 norm;
-    if(u_HasNormalMap) {
+    if(u_Material.flags.y != 0) {
         norm = texture(normalMap, TexCoord).rgb;
         norm = normalize(norm * 2.0 - 1.0);
         norm = normalize(TBN * norm);
     } else {
         norm = normalize(Normal);
     }
-    vec3 viewDir = normalize(eyePosition - FragPos);
-    vec4 texColor = u_HasTexture ? texture(mainTexture, TexCoord) : vec4(1.0);
-    vec4 specularTexel = u_HasSpecularMap ? texture(specularMap, TexCoord) : vec4(1.0);
+    vec3 viewDir = normalize(u_Frame.eyePosition.xyz - FragPos);
+    vec4 texColor = u_Material.flags.x != 0 ? texture(mainTexture, TexCoord) : vec4(1.0);
+    vec4 specularTexel = u_Material.flags.z != 0 ? texture(specularMap, TexCoord) : vec4(1.0);
 
-    vec3 ambient = u_Material.ambient * u_Light_ambient.rgb * texColor.rgb;
+    vec3 ambient = u_Material.ambient.rgb * u_Lights.ambient.rgb * texColor.rgb;
     vec3 totalDiffuseSpecular = vec3(0.0);
 
-
-    for(int i = 0; i < u_LightCount; i++)
+    // Directional lights (shadowed)
+    for(int i = 0; i < u_Lights.count.x; i++)
     {
-        vec3 lightDir;
-        float attenuation = 1.0;
-        float currentShadow = 0.0;
-
-        if(u_Light_position[i].w == 0.0)
-        {
-            lightDir = normalize(-u_Light_position[i].xyz);
-            currentShadow = CalcShadowFactor(FragPosShadowSpace, norm, lightDir);;
-        }
-        else
-        {
-            lightDir = normalize(u_Light_position[i].xyz - FragPos);
-            float distance = length(u_Light_position[i].xyz - FragPos);
-            attenuation = 1.0 / (u_Light_attenuation[i].x +
-                                 u_Light_attenuation[i].y * distance +
-                                 u_Light_attenuation[i].z * (distance * distance));
-        }
+        vec3 lightDir = normalize(-u_Lights.direction[i].xyz);
+        float shadow = CalcShadowFactor(FragPos, norm, lightDir);
+        totalDiffuseSpecular += ShadeLight(norm, viewDir, lightDir, u_Lights.diffuse[i].rgb, u_Lights.specular[i].rgb,
+                                           texColor.rgb, specularTexel.rgb) * (1.0 - shadow);
+    }
 
-        float diff = max(dot(norm, lightDir), 0.0);
-        vec3 diffuse = diff * u_Material.diffuse * u_Light_diffuse[i].rgb * texColor.rgb;
+    // Point lights of this fragment's cluster only
+    if (u_Lights.count.y > 0)
+    {
+        float viewDepth = -(u_Frame.view * vec4(FragPos, 1.0)).z;
+        uvec2 range = texelFetch(u_ClusterRanges, GetClusterIndex(viewDepth)).xy;
 
-        vec3 specular = vec3(0.0);
-        if (diff > 0.0)
+        for (uint i = 0u; i < range.y; i++)
         {
-            vec3 halfVector = normalize(lightDir + viewDir);
-            float specAngle = max(dot(norm, halfVector), 0.0);
-            float spec = pow(specAngle, u_Material.shininess);
-            specular = spec * u_Material.specular * u_Light_specular[i].rgb * specularTexel.rgb;
+            int lightIndex = int(texelFetch(u_ClusterLightIndices, int(range.x + i)).r);
+            vec4 positionRange = texelFetch(u_PointLights, lightIndex * 3);
+            vec3 color = texelFetch(u_PointLights, lightIndex * 3 + 1).rgb;
+            vec3 falloff = texelFetch(u_PointLights, lightIndex * 3 + 2).xyz;
+
+            vec3 toLight = positionRange.xyz - FragPos;
+            float distance = length(toLight);
+            if (distance >= positionRange.w) continue;
+
+            float attenuation = 1.0 / (falloff.x + falloff.y * distance + falloff.z * (distance * distance));
+            // Fade to zero at the cluster range so the cutoff is not visible
+            float window = clamp(1.0 - pow(distance / positionRange.w, 4.0), 0.0, 1.0);
+            attenuation *= window * window;
+
+            totalDiffuseSpecular += ShadeLight(norm, viewDir, toLight / distance, color, color,
+                                               texColor.rgb, specularTexel.rgb) * attenuation;
         }
-
-        totalDiffuseSpecular += (diffuse + specular) * attenuation * (1.0 - currentShadow);
     }
 
     vec3 result = ambient + totalDiffuseSpecular;
-    FragColor = vec4(result, 1.0);
+    FragColor = vec4(result, u_Material.diffuse.w);
     
 }
@@ -0,0 +1,18 @@
+//
+//  FullscreenVertexShader.glsl
+//  MyEngine
+//
+//  Created by Priyanshu Kaushik on 19/10/2026.
+//
+
+#version 330 core
+
+out vec2 TexCoord;
+
+// One triangle covering the screen, no vertex buffer (draw 3 vertices with an empty VAO)
+void main()
+{
+    vec2 position = vec2((gl_VertexID << 1) & 2, gl_VertexID & 2);
+    TexCoord = position;
+    gl_Position = vec4(position * 2.0 - 1.0, 0.0, 1.0);
+}
@@ -0,0 +1,48 @@
+//
+//  GBufferFragmentShader.glsl
+//  MyEngine
+//
+//  Created by Priyanshu Kaushik on 19/10/2026.
+//
+
+#version 330 core
+layout (location = 0) out vec4 gPosition;    // xyz = world position, w = material ambient
+layout (location = 1) out vec4 gNormal;      // xyz = world normal, w = shininess
+layout (location = 2) out vec4 gAlbedoSpec;  // rgb = albedo * diffuse, a = specular intensity
+
+in vec3 FragPos;
+in vec3 Normal;
+in vec2 TexCoord;
+in mat3 TBN;
+
+uniform sampler2D mainTexture;
+uniform sampler2D normalMap;
+uniform sampler2D specularMap;
+
+layout (std140) uniform MaterialData {
+    vec4 ambient;
+    vec4 diffuse;                  // w = opacity
+    vec4 specular;                 // w = shininess
+    ivec4 flags;                   // x = albedo map, y = normal map, z = specular map
+} u_Material;
+
+void main()
+{
+    vec3 norm;
+    if(u_Material.flags.y != 0) {
+        norm = texture(normalMap, TexCoord).rgb;
+        norm = normalize(norm * 2.0 - 1.0);
+        norm = normalize(TBN * norm);
+    } else {
+        norm = normalize(Normal);
+    }
+    vec4 texColor = u_Material.flags.x != 0 ? texture(mainTexture, TexCoord) : vec4(1.0);
+    vec3 specularTexel = u_Material.flags.z != 0 ? texture(specularMap, TexCoord).rgb : vec3(1.0);
+
+    // Colored specular does not fit, the lighting pass uses its average
+    vec3 specular = u_Material.specular.rgb * specularTexel;
+
+    gPosition = vec4(FragPos, dot(u_Material.ambient.rgb, vec3(1.0 / 3.0)));
+    gNormal = vec4(norm, u_Material.specular.w);
+    gAlbedoSpec = vec4(u_Material.diffuse.rgb * texColor.rgb, dot(specular, vec3(1.0 / 3.0)));
+}
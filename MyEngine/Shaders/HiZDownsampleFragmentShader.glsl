@@ -0,0 +1,32 @@
+//
+//  HiZDownsampleFragmentShader.glsl
+//  MyEngine
+//
+//  Created by Priyanshu Kaushik on 19/10/2026.
+//
+
+#version 330 core
+out float HiZ;
+
+// Depth copy or the previous pyramid level (base level restricted to it)
+uniform sampler2D u_Source;
+
+// Farthest depth of the 2x2 source texels under this one. An odd source edge
+// folds its extra row/column into the last texel, so no depth is dropped.
+void main()
+{
+    ivec2 sourceSize = textureSize(u_Source, 0);
+    ivec2 texel = ivec2(gl_FragCoord.xy) * 2;
+    ivec2 last = sourceSize - 1;
+
+    ivec2 extent = ivec2(1);
+    if ((sourceSize.x & 1) != 0 && texel.x + 2 == last.x) extent.x = 2;
+    if ((sourceSize.y & 1) != 0 && texel.y + 2 == last.y) extent.y = 2;
+
+    float depth = 0.0;
+    for (int y = 0; y <= extent.y; y++)
+        for (int x = 0; x <= extent.x; x++)
+            depth = max(depth, texelFetch(u_Source, min(texel + ivec2(x, y), last), 0).r);
+
+    HiZ = depth;
+}
@@ -7,10 +7,45 @@
 
 
 #version 330 core
+#define SHADOW_CASCADES 4
 layout (location = 0) in vec3 aPos;
+layout (location = 4) in mat4 aInstanceMatrix;
+
+layout (std140) uniform FrameData {
+    mat4 view;
+    mat4 projection;
+    mat4 viewProjection;
+    mat4 cascadeMatrices[SHADOW_CASCADES];
+    vec4 cascadeSplits;            // Far view depth of each cascade
+    vec4 eyePosition;
+} u_Frame;
+
 uniform mat4 transformMatrix;
-uniform mat4 shadowMapMatrix;
+uniform bool u_Instanced;
+uniform int u_Cascade;     // Cascade currently being rendered, -1 = camera depth prepass
+
+// Displaced terrain (TerrainSystem): aPos is a patch grid point (x, 0 or -1 on skirts, z)
+layout (location = 8) in vec4 aTerrainPatch;   // Chunk origin in heightmap texels, skirt depth
+uniform bool u_TerrainDisplaced;
+uniform sampler2D u_HeightMap;                 // R16, [0, 1]
+uniform vec4 u_TerrainParams;                  // x: terrainScale, y: maxHeight
+
+// Prepass depth has to match the main passes bit for bit (equal depth test)
+invariant gl_Position;
+
+// Position part of DisplaceTerrain in VertexShader.glsl
+vec3 DisplaceTerrain()
+{
+    ivec2 size = textureSize(u_HeightMap, 0);
+    ivec2 texel = min(ivec2(aTerrainPatch.xy + aPos.xz), size - 1);
+    float h = texelFetch(u_HeightMap, texel, 0).r * u_TerrainParams.y;
+    return vec3(float(texel.x) * u_TerrainParams.x, h + aPos.y * aTerrainPatch.z, float(texel.y) * u_TerrainParams.x);
+}
 
 void main() {
-    gl_Position = shadowMapMatrix * transformMatrix * vec4(aPos, 1.0);
+    mat4 model = u_Instanced ? aInstanceMatrix : transformMatrix;
+    vec3 position = u_TerrainDisplaced ? DisplaceTerrain() : aPos;
+    vec4 worldPos = model * vec4(position, 1.0);
+    mat4 viewProjection = u_Cascade < 0 ? u_Frame.viewProjection : u_Frame.cascadeMatrices[u_Cascade];
+    gl_Position = viewProjection * worldPos;
 }
@@ -7,38 +7,84 @@
 
 
 #version 330 core
+#define SHADOW_CASCADES 4
 layout (location = 0) in vec3 aPos;
 layout (location = 1) in vec3 aNormal;
 layout (location = 2) in vec2 aTexCoord;
 layout (location = 3) in vec3 aTangent;
+layout (location = 4) in mat4 aInstanceMatrix; // Locations 4-7, one per instance
 
 out vec3 FragPos;
 out vec3 Normal;
 out vec2 TexCoord;
-out vec4 FragPosShadowSpace;
 out mat3 TBN;
 
+layout (std140) uniform FrameData {
+    mat4 view;
+    mat4 projection;
+    mat4 viewProjection;
+    mat4 cascadeMatrices[SHADOW_CASCADES];
+    vec4 cascadeSplits;            // Far view depth of each cascade
+    vec4 eyePosition;
+} u_Frame;
+
 uniform mat4 transformMatrix;
-uniform mat4 projectionMatrix;
-uniform mat4 viewMatrix;
-uniform mat4 shadowMapMatrix;
+uniform bool u_Instanced; // true: model matrix comes from the instance buffer
+
+// Displaced terrain (TerrainSystem): aPos is a patch grid point (x, 0 or -1 on skirts, z)
+layout (location = 8) in vec4 aTerrainPatch;   // Chunk origin in heightmap texels, skirt depth
+uniform bool u_TerrainDisplaced;
+uniform sampler2D u_HeightMap;                 // R16, [0, 1]
+uniform vec4 u_TerrainParams;                  // x: terrainScale, y: maxHeight
+
+// Same depth as the prepass in ShadowDepthVertexShader.glsl
+invariant gl_Position;
+
+// Same vertex as TerrainSystem::GenerateMesh would bake for this grid point
+void DisplaceTerrain(out vec3 position, out vec3 normal, out vec2 uv)
+{
+    ivec2 size = textureSize(u_HeightMap, 0);
+    ivec2 texel = min(ivec2(aTerrainPatch.xy + aPos.xz), size - 1);
+    float scale = u_TerrainParams.x;
+    float maxHeight = u_TerrainParams.y;
+    
+    float h  = texelFetch(u_HeightMap, texel, 0).r * maxHeight;
+    float hL = texelFetch(u_HeightMap, max(texel - ivec2(1, 0), ivec2(0)), 0).r * maxHeight;
+    float hR = texelFetch(u_HeightMap, min(texel + ivec2(1, 0), size - 1), 0).r * maxHeight;
+    float hD = texelFetch(u_HeightMap, max(texel - ivec2(0, 1), ivec2(0)), 0).r * maxHeight;
+    float hU = texelFetch(u_HeightMap, min(texel + ivec2(0, 1), size - 1), 0).r * maxHeight;
+    
+    position = vec3(float(texel.x) * scale, h + aPos.y * aTerrainPatch.z, float(texel.y) * scale);
+    normal = normalize(vec3(hL - hR, 2.0 * scale, hD - hU));
+    uv = vec2(texel) / vec2(size - 1);
+}
 
 void main()
 {
-    vec4 worldPos = transformMatrix * vec4(aPos, 1.0);
+    mat4 model = u_Instanced ? aInstanceMatrix : transformMatrix;
+    
+    vec3 position = aPos;
+    vec3 normal = aNormal;
+    vec3 tangent = aTangent;
+    vec2 uv = aTexCoord;
+    if (u_TerrainDisplaced) {
+        DisplaceTerrain(position, normal, uv);
+        tangent = vec3(0.0);
+    }
+    
+    vec4 worldPos = model * vec4(position, 1.0);
     FragPos = vec3(worldPos);
-    Normal = mat3(transpose(inverse(transformMatrix))) * aNormal;
-    TexCoord = aTexCoord;
+    Normal = mat3(transpose(inverse(model))) * normal;
+    TexCoord = uv;
     
-    mat3 normalMatrix = transpose(inverse(mat3(transformMatrix)));
+    mat3 normalMatrix = transpose(inverse(mat3(model)));
     
-    vec3 T = normalize(normalMatrix * aTangent);
-    vec3 N = normalize(normalMatrix * aNormal);
+    vec3 T = normalize(normalMatrix * tangent);
+    vec3 N = normalize(normalMatrix * normal);
     T = normalize(T - dot(T, N) * N);
     vec3 B = cross(N, T);
     
     TBN = mat3(T, B, N);
     
-    FragPosShadowSpace = shadowMapMatrix * worldPos;
-    gl_Position = projectionMatrix * viewMatrix * worldPos;
+    gl_Position = u_Frame.viewProjection * worldPos;
 }
@@ -0,0 +1,157 @@
+//
+//  ClusterGrid.cpp
+//  MyEngine
+//
+//  Created by Priyanshu Kaushik on 19/10/2026.
+//
+
+#include "ClusterGrid.h"
+#include <algorithm>
+#include <cmath>
+#include <cfloat>
+
+int ClusterGrid::GetSlice(float viewDepth) const
+{
+    if (viewDepth <= m_Near) return 0;
+    int slice = static_cast<int>(std::floor(std::log(viewDepth) * m_SliceScale + m_SliceBias));
+    return std::clamp(slice, 0, SLICES_Z - 1);
+}
+
+// CLUSTER BOUNDS
+// Tiles are uniform in NDC, slices exponential in view depth. Symmetric perspective assumed.
+
+void ClusterGrid::RebuildClusterBounds(const glm::mat4& projection)
+{
+    m_Projection = projection;
+    m_Near = projection[3][2] / (projection[2][2] - 1.0f);
+    m_Far = projection[3][2] / (projection[2][2] + 1.0f);
+
+    float logRatio = std::log(m_Far / m_Near);
+    m_SliceScale = SLICES_Z / logRatio;
+    m_SliceBias = -SLICES_Z * std::log(m_Near) / logRatio;
+
+    m_ClusterMin.resize(CLUSTER_COUNT);
+    m_ClusterMax.resize(CLUSTER_COUNT);
+
+    float invScaleX = 1.0f / projection[0][0];
+    float invScaleY = 1.0f / projection[1][1];
+
+    for (int z = 0; z < SLICES_Z; z++)
+    {
+        float nearDepth = m_Near * std::pow(m_Far / m_Near, float(z) / SLICES_Z);
+        float farDepth = m_Near * std::pow(m_Far / m_Near, float(z + 1) / SLICES_Z);
+
+        for (int y = 0; y < TILES_Y; y++)
+        {
+            float ndcY0 = -1.0f + 2.0f * y / TILES_Y;
+            float ndcY1 = -1.0f + 2.0f * (y + 1) / TILES_Y;
+
+            for (int x = 0; x < TILES_X; x++)
+            {
+                float ndcX0 = -1.0f + 2.0f * x / TILES_X;
+                float ndcX1 = -1.0f + 2.0f * (x + 1) / TILES_X;
+
+                // The tile widens with depth: bounds over both depth planes
+                glm::vec3 minV(FLT_MAX), maxV(-FLT_MAX);
+                for (float depth : { nearDepth, farDepth })
+                {
+                    for (float ndcX : { ndcX0, ndcX1 })
+                    {
+                        for (float ndcY : { ndcY0, ndcY1 })
+                        {
+                            glm::vec3 p(ndcX * depth * invScaleX, ndcY * depth * invScaleY, -depth);
+                            minV = glm::min(minV, p);
+                            maxV = glm::max(maxV, p);
+                        }
+                    }
+                }
+
+                int index = (z * TILES_Y + y) * TILES_X + x;
+                m_ClusterMin[index] = minV;
+                m_ClusterMax[index] = maxV;
+            }
+        }
+    }
+}
+
+// LIGHT ASSIGNMENT
+
+void ClusterGrid::Build(const glm::mat4& projection, const std::vector<ClusterLight>& lights)
+{
+    if (projection != m_Projection) RebuildClusterBounds(projection);
+
+    m_Pairs.clear();
+    m_ClusterRanges.assign(CLUSTER_COUNT * 2, 0);
+
+    for (uint32_t lightIndex = 0; lightIndex < lights.size(); lightIndex++)
+    {
+        const ClusterLight& light = lights[lightIndex];
+        glm::vec3 center = light.viewPosition;
+        float radius = light.range;
+
+        // Depth range (view space looks down -Z)
+        float minDepth = -center.z - radius;
+        float maxDepth = -center.z + radius;
+        if (maxDepth < m_Near || minDepth > m_Far) continue;
+        minDepth = std::max(minDepth, m_Near);
+
+        // Screen range: x/depth is monotonic in both, so the extremes are at the box corners
+        float ndcMinX = FLT_MAX, ndcMaxX = -FLT_MAX, ndcMinY = FLT_MAX, ndcMaxY = -FLT_MAX;
+        for (float depth : { minDepth, maxDepth })
+        {
+            for (float side : { -1.0f, 1.0f })
+            {
+                float ndcX = projection[0][0] * (center.x + side * radius) / depth;
+                float ndcY = projection[1][1] * (center.y + side * radius) / depth;
+                ndcMinX = std::min(ndcMinX, ndcX); ndcMaxX = std::max(ndcMaxX, ndcX);
+                ndcMinY = std::min(ndcMinY, ndcY); ndcMaxY = std::max(ndcMaxY, ndcY);
+            }
+        }
+        if (ndcMaxX < -1.0f || ndcMinX > 1.0f || ndcMaxY < -1.0f || ndcMinY > 1.0f) continue;
+
+        int x0 = std::clamp(static_cast<int>((ndcMinX * 0.5f + 0.5f) * TILES_X), 0, TILES_X - 1);
+        int x1 = std::clamp(static_cast<int>((ndcMaxX * 0.5f + 0.5f) * TILES_X), 0, TILES_X - 1);
+        int y0 = std::clamp(static_cast<int>((ndcMinY * 0.5f + 0.5f) * TILES_Y), 0, TILES_Y - 1);
+        int y1 = std::clamp(static_cast<int>((ndcMaxY * 0.5f + 0.5f) * TILES_Y), 0, TILES_Y - 1);
+        int z0 = GetSlice(minDepth);
+        int z1 = GetSlice(maxDepth);
+
+        float radiusSq = radius * radius;
+        for (int z = z0; z <= z1; z++)
+        {
+            for (int y = y0; y <= y1; y++)
+            {
+                for (int x = x0; x <= x1; x++)
+                {
+                    int cluster = (z * TILES_Y + y) * TILES_X + x;
+
+                    // Sphere vs cluster AABB
+                    glm::vec3 closest = glm::clamp(center, m_ClusterMin[cluster], m_ClusterMax[cluster]);
+                    glm::vec3 d = closest - center;
+                    if (glm::dot(d, d) > radiusSq) continue;
+
+                    m_Pairs.push_back((static_cast<uint64_t>(cluster) << 32) | lightIndex);
+                    m_ClusterRanges[cluster * 2 + 1]++;
+                }
+            }
+        }
+    }
+
+    // Counts -> offsets, then scatter the pairs into the flat index list
+    uint32_t offset = 0;
+    for (int cluster = 0; cluster < CLUSTER_COUNT; cluster++)
+    {
+        m_ClusterRanges[cluster * 2] = offset;
+        offset += m_ClusterRanges[cluster * 2 + 1];
+        m_ClusterRanges[cluster * 2 + 1] = 0;
+    }
+
+    m_LightIndices.resize(m_Pairs.size());
+    for (uint64_t pair : m_Pairs)
+    {
+        uint32_t cluster = static_cast<uint32_t>(pair >> 32);
+        uint32_t& count = m_ClusterRanges[cluster * 2 + 1];
+        m_LightIndices[m_ClusterRanges[cluster * 2] + count] = static_cast<uint32_t>(pair & 0xFFFFFFFFu);
+        count++;
+    }
+}
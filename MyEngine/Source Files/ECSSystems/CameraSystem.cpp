@@ -55,6 +55,13 @@ glm::mat4 CameraSystem::GetView() const{
     return glm::lookAt(transform->position, transform->position + camera->Front, camera->Up);
 }
 
+glm::vec3 CameraSystem::GetCameraPosition() const{
+    if(m_MainCam==UINT32_MAX) return glm::vec3(0.0f);
+    TransformComponent* transform = m_Coordinator->GetComponent<TransformComponent>(m_MainCam);
+    if(!transform) return glm::vec3(0.0f);
+    return transform->position;
+}
+
 glm::mat4 CameraSystem::GetCameraProjection() const{
     if(m_MainCam==UINT32_MAX) return glm::mat4();
     CameraComponent* camera = m_Coordinator->GetComponent<CameraComponent>(m_MainCam);
@@ -11,20 +11,12 @@
 
 void DebugGizmosSystem::Init()
 {
+    // Vertex data lives in the frame ring, attribute pointers are set per draw in Render
     glGenVertexArrays(1, &lineVAO);
-    glGenBuffers(1, &lineVBO);
 
     glBindVertexArray(lineVAO);
-    glBindBuffer(GL_ARRAY_BUFFER, lineVBO);
-
-    // Position attribute
     glEnableVertexAttribArray(0);
-    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(LineVertex), (void*)0);
-    // Color attribute
     glEnableVertexAttribArray(1);
-    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(LineVertex), (void*)offsetof(LineVertex, color));
-
-    glBindBuffer(GL_ARRAY_BUFFER, 0);
     glBindVertexArray(0);
 }
 
@@ -131,20 +123,29 @@ void DebugGizmosSystem::DrawBoxCollision(const Entity& entity)
 
 
 void DebugGizmosSystem::Render() {
-    if (lineVertices.empty()) return;
+    if (lineVertices.empty() || !m_FrameAllocator) return;
+    
+    GPUAllocation allocation = m_FrameAllocator->Upload(lineVertices.data(), lineVertices.size() * sizeof(LineVertex), sizeof(LineVertex));
+    lineVertices.clear();
+    if (!allocation) return;
 
     glEnable(GL_LINE_SMOOTH);
     glHint(GL_LINE_SMOOTH_HINT, GL_NICEST);
     glEnable(GL_BLEND);
     glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
     
-    glBindBuffer(GL_ARRAY_BUFFER, lineVBO);
-    glBufferData(GL_ARRAY_BUFFER, lineVertices.size() * sizeof(LineVertex), lineVertices.data(), GL_DYNAMIC_DRAW);
-
     glBindVertexArray(lineVAO);
-    glDrawArrays(GL_LINES, 0, (GLsizei)lineVertices.size());
+    glBindBuffer(GL_ARRAY_BUFFER, allocation.buffer);
 
-    lineVertices.clear();
+    // Position attribute
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(LineVertex), (void*)allocation.offset);
+    // Color attribute
+    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(LineVertex), (void*)(allocation.offset + offsetof(LineVertex, color)));
+
+    glDrawArrays(GL_LINES, 0, (GLsizei)(allocation.size / sizeof(LineVertex)));
+    
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glBindVertexArray(0);
 }
 
 void DebugGizmosSystem::Line(glm::vec3 start, glm::vec3 end, glm::vec3 color) {
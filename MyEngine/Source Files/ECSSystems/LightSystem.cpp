@@ -12,32 +12,62 @@
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtc/type_ptr.hpp>
+#include <algorithm>
+#include <cmath>
+
+namespace {
+    constexpr UniformID U_POINT_LIGHTS("u_PointLights");
+    constexpr UniformID U_CLUSTER_RANGES("u_ClusterRanges");
+    constexpr UniformID U_CLUSTER_LIGHT_INDICES("u_ClusterLightIndices");
+    
+    constexpr int POINT_LIGHT_UNIT = 4;
+    constexpr int CLUSTER_RANGE_UNIT = 5;
+    constexpr int LIGHT_INDEX_UNIT = 6;
+}
 
 void LightSystem::Init()
 {
+    m_PointLightBuffer.Create(GL_RGBA32F, 256 * 3 * sizeof(glm::vec4));
+    m_ClusterRangeBuffer.Create(GL_RG32UI, ClusterGrid::CLUSTER_COUNT * 2 * sizeof(uint32_t));
+    m_LightIndexBuffer.Create(GL_R32UI, ClusterGrid::CLUSTER_COUNT * 8 * sizeof(uint32_t));
 }
 
-void LightSystem::Render(Shader &shader)
+// Distance at which the attenuated intensity drops below LIGHT_CUTOFF:
+// constant + linear * d + quadratic * d^2 = maxIntensity / cutoff
+float LightSystem::ComputeLightRange(const LightComponent& light)
 {
-    if(!m_Coordinator) return;
+    glm::vec3 color = light.color * light.intensity;
+    float maxIntensity = std::max({ color.r, color.g, color.b });
+    float target = maxIntensity / LIGHT_CUTOFF - light.constant;
+    if (target <= 0.0f) return 0.0f;
     
-    std::vector<glm::vec4> positions;
-    std::vector<glm::vec4> diffuses;
-    std::vector<glm::vec4> speculars;
-    std::vector<glm::vec3> attenuations;
+    float range = MAX_LIGHT_RANGE;
+    if (light.quadratic > 0.0f)
+        range = (-light.linear + std::sqrt(light.linear * light.linear + 4.0f * light.quadratic * target)) / (2.0f * light.quadratic);
+    else if (light.linear > 0.0f)
+        range = target / light.linear;
+    
+    return std::min(range, MAX_LIGHT_RANGE);
+}
 
-    int count = 0;
-    shader.SetVec4("u_Light_ambient", glm::vec4(0.2f, 0.2f, 0.2f, 1.0f));
+void LightSystem::UploadLights(const glm::mat4& view, const glm::mat4& projection, const glm::vec2& viewportSize)
+{
+    if(!m_Coordinator || !m_FrameAllocator) return;
+    
+    int directionalCount = 0;
+    m_LightData.ambient = glm::vec4(0.1f, 0.1f, 0.1f, 1.0f);
+    m_PointLightData.clear();
+    m_ClusterLights.clear();
     
     for (auto const& entity : mEntities) {
-        if (count >= 10) break;
-
         auto* transform = m_Coordinator->GetComponent<TransformComponent>(entity);
         auto* light = m_Coordinator->GetComponent<LightComponent>(entity);
-        glm::vec4 posType;
+        glm::vec3 color = light->color * light->intensity;
 
         if (light->type == LightType::Directional)
         {
+            if (directionalCount >= MAX_DIRECTIONAL_LIGHTS) continue;
+            
             glm::mat4 rot = glm::mat4(1.0f);
             rot = glm::rotate(rot, glm::radians(transform->rotation.y), glm::vec3(0, 1, 0));
             rot = glm::rotate(rot, glm::radians(transform->rotation.x), glm::vec3(1, 0, 0));
@@ -45,53 +75,141 @@ void LightSystem::Render(Shader &shader)
 
             glm::vec3 direction = glm::vec3(rot * glm::vec4(0.0f, 0.0f, -1.0f, 0.0f));
             m_LastDirectionalDir = direction;
-            posType = glm::vec4(direction, 0.0f);
-        }
-        else {
-            posType = glm::vec4(transform->position, (float)light->type);
+            
+            m_LightData.direction[directionalCount] = glm::vec4(direction, 0.0f);
+            m_LightData.diffuse[directionalCount] = glm::vec4(color, 1.0f);
+            m_LightData.specular[directionalCount] = glm::vec4(color, 1.0f);
+            directionalCount++;
+            continue;
         }
-
-        positions.push_back(posType);
-        diffuses.push_back(glm::vec4(light->color * light->intensity, 1.0f));
-        speculars.push_back(glm::vec4(light->color * light->intensity, 1.0f));
-        attenuations.push_back(glm::vec3(light->constant, light->linear, light->quadratic));
         
-        count++;
+        // Point and spot lights (spots are lit as points)
+        float range = ComputeLightRange(*light);
+        if (range <= 0.0f) continue;
+        
+        m_PointLightData.push_back(glm::vec4(transform->position, range));
+        m_PointLightData.push_back(glm::vec4(color, 1.0f));
+        m_PointLightData.push_back(glm::vec4(light->constant, light->linear, light->quadratic, 0.0f));
+        m_ClusterLights.push_back({ glm::vec3(view * glm::vec4(transform->position, 1.0f)), range });
     }
 
-    shader.SetInt("u_LightCount", count);
-    shader.SetVec4("u_Light_ambient", glm::vec4(0.2f, 0.2f, 0.2f, 1.0f));
-    if (count == 0) {
-        shader.SetInt("u_LightCount", 1);
-        shader.SetVec4("u_Light_position[0]", glm::vec4(0.0f, -1.0f, 0.0f, 0.0f));
-        shader.SetVec4("u_Light_diffuse[0]", glm::vec4(1.0f, 1.0f, 1.0f, 1.0f));
+    // No lights in the scene: fall back to a white light pointing down
+    if (directionalCount == 0 && m_ClusterLights.empty()) {
+        m_LightData.direction[0] = glm::vec4(0.0f, -1.0f, 0.0f, 0.0f);
+        m_LightData.diffuse[0] = glm::vec4(1.0f, 1.0f, 1.0f, 1.0f);
+        m_LightData.specular[0] = glm::vec4(0.0f);
+        directionalCount = 1;
     }
-    else
+    
+    // CLUSTER ASSIGNMENT
+    bool hasCamera = projection[2][3] != 0.0f;
+    if (hasCamera) m_ClusterGrid.Build(projection, m_ClusterLights);
+    int clusteredCount = hasCamera ? static_cast<int>(m_ClusterLights.size()) : 0;
+    
+    if (clusteredCount > 0)
     {
-        shader.SetVec4Array("u_Light_position", positions);
-        shader.SetVec4Array("u_Light_diffuse", diffuses);
-        shader.SetVec4Array("u_Light_specular", speculars);
-        shader.SetVec3Array("u_Light_attenuation", attenuations);
+        m_PointLightBuffer.Upload(m_PointLightData.data(), m_PointLightData.size() * sizeof(glm::vec4));
+        m_ClusterRangeBuffer.Upload(m_ClusterGrid.GetClusterRanges().data(), m_ClusterGrid.GetClusterRanges().size() * sizeof(uint32_t));
+        m_LightIndexBuffer.Upload(m_ClusterGrid.GetLightIndices().data(), m_ClusterGrid.GetLightIndices().size() * sizeof(uint32_t));
     }
     
-    shader.SetVec4("u_Light_ambient", glm::vec4(0.1f, 0.1f, 0.1f, 1.0f));
+    m_LightData.count = glm::ivec4(directionalCount, clusteredCount, 0, 0);
+    m_LightData.clusterGrid = glm::ivec4(ClusterGrid::TILES_X, ClusterGrid::TILES_Y, ClusterGrid::SLICES_Z, 0);
+    m_LightData.clusterParams = glm::vec4(m_ClusterGrid.GetSliceScale(), m_ClusterGrid.GetSliceBias(),
+                                          1.0f / std::max(viewportSize.x, 1.0f), 1.0f / std::max(viewportSize.y, 1.0f));
+    
+    GPUAllocation allocation = m_FrameAllocator->Upload(&m_LightData, sizeof(LightUniforms), UniformBuffer::GetOffsetAlignment());
+    if (allocation) BindUniformRange(UniformBinding::Light, allocation);
+}
 
+void LightSystem::BindClusters(Shader& shader) const
+{
+    m_PointLightBuffer.Bind(POINT_LIGHT_UNIT);
+    m_ClusterRangeBuffer.Bind(CLUSTER_RANGE_UNIT);
+    m_LightIndexBuffer.Bind(LIGHT_INDEX_UNIT);
+    
+    shader.SetInt(U_POINT_LIGHTS, POINT_LIGHT_UNIT);
+    shader.SetInt(U_CLUSTER_RANGES, CLUSTER_RANGE_UNIT);
+    shader.SetInt(U_CLUSTER_LIGHT_INDICES, LIGHT_INDEX_UNIT);
 }
 
-glm::mat4 LightSystem::GetLightSpaceMatrix()
+// CASCADES
+
+void LightSystem::ComputeCascades(const glm::mat4& view, const glm::mat4& projection, int resolution, ShadowCascades& out) const
 {
-    glm::mat4 biasMatrix(
-        0.5, 0.0, 0.0, 0.0,
-        0.0, 0.5, 0.0, 0.0,
-        0.0, 0.0, 0.5, 0.0,
-        0.5, 0.5, 0.5, 1.0
-    );
+    // No camera yet (projection is not a perspective matrix)
+    if (projection[2][3] == 0.0f) {
+        for (glm::mat4& matrix : out.matrices) matrix = glm::mat4(1.0f);
+        out.splits = glm::vec4(0.0f);
+        return;
+    }
     
-    float orthoSize = 20.0f;
-    glm::mat4 lightProjection = glm::ortho(-orthoSize, orthoSize, -orthoSize, orthoSize, 1.0f, 50.0f);
+    // Clip planes back from the perspective matrix
+    float nearPlane = projection[3][2] / (projection[2][2] - 1.0f);
+    float farPlane = projection[3][2] / (projection[2][2] + 1.0f);
+    float shadowDistance = std::min(farPlane, MAX_SHADOW_DISTANCE);
     
-    glm::vec3 lightPos = -m_LastDirectionalDir * 20.0f;
-    glm::mat4 lightView = glm::lookAt(lightPos, glm::vec3(0.0f), glm::vec3(0.0f, 1.0f, 0.0f));
-
-    return biasMatrix * lightProjection * lightView;
+    // World space corners of the full frustum: near quad then far quad
+    glm::mat4 inverseViewProjection = glm::inverse(projection * view);
+    glm::vec3 corners[8];
+    for (int i = 0; i < 8; i++)
+    {
+        glm::vec4 ndc((i & 1) ? 1.0f : -1.0f, (i & 2) ? 1.0f : -1.0f, (i & 4) ? 1.0f : -1.0f, 1.0f);
+        glm::vec4 world = inverseViewProjection * ndc;
+        corners[i] = glm::vec3(world) / world.w;
+    }
+    
+    glm::vec3 lightDir = glm::normalize(m_LastDirectionalDir);
+    glm::vec3 up = std::abs(lightDir.y) > 0.99f ? glm::vec3(0.0f, 0.0f, 1.0f) : glm::vec3(0.0f, 1.0f, 0.0f);
+    glm::mat4 lightRotation = glm::lookAt(glm::vec3(0.0f), lightDir, up);
+    glm::mat4 inverseLightRotation = glm::inverse(lightRotation);
+    
+    float splitNear = nearPlane;
+    for (int c = 0; c < SHADOW_CASCADES; c++)
+    {
+        // Practical split: blend of logarithmic and uniform distribution
+        float p = float(c + 1) / SHADOW_CASCADES;
+        float logSplit = nearPlane * std::pow(shadowDistance / nearPlane, p);
+        float uniformSplit = nearPlane + (shadowDistance - nearPlane) * p;
+        float splitFar = CASCADE_SPLIT_LAMBDA * logSplit + (1.0f - CASCADE_SPLIT_LAMBDA) * uniformSplit;
+        
+        // Corners of the sub-frustum, interpolated along the frustum edges
+        float t0 = (splitNear - nearPlane) / (farPlane - nearPlane);
+        float t1 = (splitFar - nearPlane) / (farPlane - nearPlane);
+        glm::vec3 center(0.0f);
+        glm::vec3 subCorners[8];
+        for (int i = 0; i < 4; i++)
+        {
+            glm::vec3 edge = corners[i + 4] - corners[i];
+            subCorners[i] = corners[i] + edge * t0;
+            subCorners[i + 4] = corners[i] + edge * t1;
+            center += subCorners[i] + subCorners[i + 4];
+        }
+        center /= 8.0f;
+        
+        // Bounding sphere: size does not change when the camera rotates, so the box does not shimmer
+        float radius = 0.0f;
+        for (const glm::vec3& corner : subCorners)
+            radius = std::max(radius, glm::length(corner - center));
+        radius = std::ceil(radius * 16.0f) / 16.0f;
+        
+        // World anchored box: larger than the sphere by half an anchor step, its center moves in
+        // whole steps (a multiple of the texel size) in light space, depth included. The matrix,
+        // and with it the cached static shadow layer, only changes once the camera has moved a
+        // fraction of the cascade, not on every texel it crosses.
+        float halfExtent = radius * (1.0f + 0.5f * CASCADE_ANCHOR_STEP);
+        float texelSize = (2.0f * halfExtent) / resolution;
+        float anchorStep = std::max(std::floor(2.0f * (halfExtent - radius) / texelSize), 1.0f) * texelSize;
+        glm::vec3 lightSpaceCenter = glm::vec3(lightRotation * glm::vec4(center, 1.0f));
+        lightSpaceCenter = glm::round(lightSpaceCenter / anchorStep) * anchorStep;
+        center = glm::vec3(inverseLightRotation * glm::vec4(lightSpaceCenter, 1.0f));
+        
+        glm::vec3 eye = center - lightDir * (halfExtent + CASTER_DEPTH_PADDING);
+        glm::mat4 lightView = glm::lookAt(eye, center, up);
+        glm::mat4 lightProjection = glm::ortho(-halfExtent, halfExtent, -halfExtent, halfExtent, 0.0f, 2.0f * halfExtent + CASTER_DEPTH_PADDING);
+        
+        out.matrices[c] = lightProjection * lightView;
+        out.splits[c] = splitFar;
+        splitNear = splitFar;
+    }
 }
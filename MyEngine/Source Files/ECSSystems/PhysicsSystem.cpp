@@ -10,110 +10,903 @@
 #include "ECSSystems/TerrainSystem.h"
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
+#define GLM_ENABLE_EXPERIMENTAL
+#include <glm/gtx/euler_angles.hpp>
+#include <cmath>
+#include "JobSystem.h"
+
+namespace {
+
+// Transform rotations are degrees applied X, then Y, then Z (same as the model matrix)
+glm::quat EulerDegreesToQuat(const glm::vec3& degrees)
+{
+    glm::vec3 radians = glm::radians(degrees);
+    return glm::quat_cast(glm::eulerAngleXYZ(radians.x, radians.y, radians.z));
+}
+
+glm::vec3 QuatToEulerDegrees(const glm::quat& orientation)
+{
+    glm::vec3 radians;
+    glm::extractEulerAngleXYZ(glm::mat4_cast(orientation), radians.x, radians.y, radians.z);
+    return glm::degrees(radians);
+}
+
+}
 
 void PhysicsSystem::Init()
 {
     
 }
 
-// PHYSICS UPDATE LOOP
+void PhysicsSystem::OnEntityRemoved(Entity entity)
+{
+    m_Broadphase.RemoveProxy(entity);
+}
+
+// FIXED TIMESTEP
+// The frame delta only feeds the accumulator; the simulation always advances in steps of
+// m_FixedDelta, so its cost and results do not depend on the frame rate.
 void PhysicsSystem::Update(float deltaTime)
 {
     if(!m_Coordinator) return;
-        
-    for(Entity& entity : mEntities)
+
+    m_Accumulator += deltaTime;
+    int steps = 0;
+    while (m_Accumulator >= m_FixedDelta && steps < m_MaxSubsteps)
     {
-        RigidBodyComponent* rb = m_Coordinator->GetComponent<RigidBodyComponent>(entity);
-        TransformComponent* trans = m_Coordinator->GetComponent<TransformComponent>(entity);
-        if(!rb || !trans || rb->isStatic) continue;
-
-        // 1. gravity & acceleration
-        if(!rb->isKinematic) {
-            float gravity = -9.81f * rb->gravityScale;
-            rb->velocity.y += gravity * deltaTime;
-        }
-        rb->velocity += rb->acceleration * deltaTime;
+        Step(m_FixedDelta);
+        m_Accumulator -= m_FixedDelta;
+        steps++;
+    }
 
-        // 2. applying damping
-        float damping = std::pow(0.98f, deltaTime * 60.0f);
-        rb->velocity *= damping;
+    // After a hitch the backlog is dropped instead of being caught up over the next frames,
+    // which would only make those slower too (spiral of death)
+    if (m_Accumulator >= m_FixedDelta) m_Accumulator = std::fmod(m_Accumulator, m_FixedDelta);
 
-        glm::vec3 nextPos = trans->position + (rb->velocity * deltaTime);
+    Interpolate(m_Accumulator / m_FixedDelta);
+}
 
-        // 4. terrain collision (for now we can only have one terrain)
-        Entity terrainEntity = m_TerrainSystem->GetTerrainEntity();
-        if (terrainEntity != UINT32_MAX) {
-            float groundHeight = m_TerrainSystem->GetHeightAt(terrainEntity, nextPos.x, nextPos.z);
-            
-            float colliderOffset = 0.0f;
-            if(auto* box = m_Coordinator->GetComponent<BoxColliderComponent>(entity)) {
-                colliderOffset = box->extents.y;
-            }
+// Bodies are drawn between their last two states, one step behind the simulation
+void PhysicsSystem::Interpolate(float alpha)
+{
+    if (m_BodiesRevision != m_Coordinator->GetComponentRevision()) return;
 
-            if (nextPos.y - colliderOffset <= groundHeight + 0.001f)
-            {
-                nextPos.y = groundHeight + colliderOffset;
-                if (rb->velocity.y < 0) {
-                    rb->velocity.y = 0;
-                }
+    for (uint32_t body : m_AwakeBodies)
+    {
+        glm::vec3 rendered = glm::mix(m_World.GetPreviousPosition(body), m_World.GetPosition(body), alpha);
+        SetRenderOffset(m_Bodies[body], rendered - m_Bodies[body].transform->position);
+    }
+}
+
+// Our own revision bump is not an edit, unless the transform had been edited already
+void PhysicsSystem::SetRenderOffset(BodyLink& link, const glm::vec3& offset)
+{
+    bool synced = link.transform->revision == link.transformRevision;
+    link.transform->SetRenderOffset(offset);
+    if (synced) link.transformRevision = link.transform->revision;
+}
+
+// PHYSICS STEP
+void PhysicsSystem::Step(float deltaTime)
+{
+    // 1. ECS -> world, only for bodies edited since the last step
+    m_World.SavePreviousPositions();
+    SyncBodies();
+
+    // 2. contact manifolds at the current positions, grouped into islands of touching bodies
+    DetectCollisions();
+    m_Islands.Build(m_World, m_AwakeBodies, m_Manifolds);
+
+    // 3. gravity, forces and damping into velocities, WIDTH bodies at a time
+    m_World.IntegrateVelocities(deltaTime);
+
+    // 4. contact impulses (friction, restitution, penetration) on the new velocities, islands in parallel
+    m_Solver.Solve(m_World, m_Manifolds, m_Islands.GetIslands(), deltaTime);
+
+    // 5. positions and orientations from the solved velocities
+    m_World.IntegratePositions(deltaTime);
+
+    // 6. bullets pulled back to their first impact along the way, so they cannot tunnel
+    SweepBullets(deltaTime);
+
+    // 7. resting islands fall asleep
+    m_World.UpdateSleepTimers(deltaTime);
+    SleepIslands();
+
+    // 8. world -> ECS for the bodies that were simulated
+    WriteBackBodies();
+    m_QueriesStale = true;
+}
+
+// COLLISION DETECTION
+
+void PhysicsSystem::DetectCollisions()
+{
+    m_Manifolds.clear();
+
+    // BROADPHASE
+    // Every collider refreshes its proxy, the spatial hash then hands back the overlapping pairs
+    RefreshProxies();
+    for (const BodyLink& link : m_Bodies) if (link.collider) link.collider->isColliding = false;
+
+    // NARROWPHASE
+    m_SleepingPairs.clear();
+    for (const BroadphasePair& pair : m_Broadphase.FindPairs())
+    {
+        if (!AddBodyContacts(pair.a, pair.b)) m_SleepingPairs.push_back(pair);
+    }
 
-                rb->velocity.x *= 0.95f;
-                rb->velocity.z *= 0.95f;
+    // A body woken by a contact wakes the sleeping bodies it touches in turn, so a whole
+    // resting pile wakes up in the step something hits it
+    bool woken = true;
+    while (woken && !m_SleepingPairs.empty())
+    {
+        woken = false;
+        for (size_t i = 0; i < m_SleepingPairs.size(); )
+        {
+            if (AddBodyContacts(m_SleepingPairs[i].a, m_SleepingPairs[i].b))
+            {
+                m_SleepingPairs[i] = m_SleepingPairs.back();
+                m_SleepingPairs.pop_back();
+                woken = true;
             }
+            else i++;
         }
+    }
 
-        trans->SetPosition(nextPos);
+    // TERRAIN
+    // For now we can only have one terrain
+    TerrainSampler terrain = GetTerrainSampler();
+    if (!terrain) return;
 
-        // acc reset
-        rb->acceleration = glm::vec3(0.0f);
-        if (glm::length(rb->velocity) < 0.01f) rb->velocity = glm::vec3(0.0f);
+    for (uint32_t body = 0; body < m_Bodies.size(); body++)
+    {
+        const BodyLink& link = m_Bodies[body];
+        if (m_World.IsAwake(body)) AddTerrainContacts(terrain, body);
+        else if (link.collider && m_Solver.HasCachedContact(terrain.entity, link.entity)) link.collider->isColliding = true;
+    }
+}
 
-        // Update Bounding Boxes 
-        if(m_Coordinator->GetComponent<ColliderComponent>(entity)) {
-            UpdateBounds(entity);
+// Static colliders included, their bounds are only computed here
+void PhysicsSystem::RefreshProxies()
+{
+    for (const BodyLink& link : m_Bodies)
+    {
+        if (!link.collider) continue;
+        if (link.transform->isDirty || link.collider->isDirty) UpdateBounds(link.entity);
+        m_Broadphase.SetProxy(link.entity, link.collider->worldMin, link.collider->worldMax, link.rigidBody->isStatic);
+    }
+}
+
+bool PhysicsSystem::AddBodyContacts(Entity entityA, Entity entityB)
+{
+    uint32_t bodyA = m_BodyOfEntity[entityA];
+    uint32_t bodyB = m_BodyOfEntity[entityB];
+    if (bodyA == NO_BODY || bodyB == NO_BODY) return true;
+
+    // Fixed order per pair, so the warm starting cache finds it again next step.
+    // SphereBox wants the sphere first.
+    ColliderType typeA = m_Bodies[bodyA].collider->type;
+    ColliderType typeB = m_Bodies[bodyB].collider->type;
+    bool sphereFirst = typeA == ColliderType::Box && typeB == ColliderType::Sphere;
+    if (sphereFirst || (typeA == typeB && entityB < entityA))
+    {
+        std::swap(entityA, entityB);
+        std::swap(bodyA, bodyB);
+        std::swap(typeA, typeB);
+    }
+    const BodyLink& linkA = m_Bodies[bodyA];
+    const BodyLink& linkB = m_Bodies[bodyB];
+
+    // Resting pair, nothing to solve. The cache still knows whether they touch.
+    if (!m_World.IsAwake(bodyA) && !m_World.IsAwake(bodyB))
+    {
+        if (m_Solver.HasCachedContact(entityA, entityB)) linkA.collider->isColliding = linkB.collider->isColliding = true;
+        return false;
+    }
+
+    ContactManifold manifold;
+    manifold.a = entityA;
+    manifold.b = entityB;
+    manifold.bodyA = bodyA;
+    manifold.bodyB = bodyB;
+
+    // Dispatch to specific Narrowphase algorithms
+    bool touching = false;
+    CollisionBox boxA, boxB;
+    CollisionSphere sphereA, sphereB;
+    if (typeA == ColliderType::Box && typeB == ColliderType::Box)
+    {
+        if (GetCollisionBox(linkA, boxA) && GetCollisionBox(linkB, boxB)) touching = Narrowphase::BoxBox(boxA, boxB, manifold);
+    }
+    else if (typeA == ColliderType::Sphere && typeB == ColliderType::Sphere)
+    {
+        if (GetCollisionSphere(linkA, sphereA) && GetCollisionSphere(linkB, sphereB)) touching = Narrowphase::SphereSphere(sphereA, sphereB, manifold);
+    }
+    else if (typeA == ColliderType::Sphere && typeB == ColliderType::Box)
+    {
+        if (GetCollisionSphere(linkA, sphereA) && GetCollisionBox(linkB, boxB)) touching = Narrowphase::SphereBox(sphereA, boxB, manifold);
+    }
+    if (!touching) return true;
+
+    // Speculative points (still apart) feed the solver but are not a collision yet
+    for (int i = 0; i < manifold.pointCount; i++)
+    {
+        if (manifold.points[i].depth < 0.0f) continue;
+        linkA.collider->isColliding = linkB.collider->isColliding = true;
+        break;
+    }
+    if (linkA.collider->isTrigger || linkB.collider->isTrigger) return true;
+
+    manifold.friction = std::sqrt(linkA.collider->friction * linkB.collider->friction);
+    manifold.restitution = std::max(linkA.collider->bounciness, linkB.collider->bounciness);
+
+    // A moving body wakes whatever it runs into
+    WakeBody(bodyA);
+    WakeBody(bodyB);
+    m_Manifolds.push_back(manifold);
+    return true;
+}
+
+void PhysicsSystem::WakeBody(uint32_t body)
+{
+    if (m_World.IsAwake(body) || m_World.IsStatic(body)) return;
+    m_World.Wake(body);
+    m_AwakeBodies.push_back(body);
+}
+
+// SLEEP
+// Bodies are only put to sleep island by island: a box resting under one still moving
+// would otherwise lose its ground contact (pairs of sleepers are skipped) and drop.
+
+void PhysicsSystem::SleepIslands()
+{
+    const std::vector<uint32_t>& bodies = m_Islands.GetBodies();
+    for (const Island& island : m_Islands.GetIslands())
+    {
+        float restTime = PhysicsWorld::SLEEP_TIME;
+        for (uint32_t i = island.bodyStart; i < island.bodyStart + island.bodyCount; i++)
+            restTime = std::min(restTime, m_World.GetSleepTime(bodies[i]));
+        if (restTime < PhysicsWorld::SLEEP_TIME) continue;
+
+        for (uint32_t i = island.bodyStart; i < island.bodyStart + island.bodyCount; i++)
+            m_World.Sleep(bodies[i]);
+    }
+}
+
+// The terrain is body A (immovable), its normal the slope under the body. Boxes touch it with
+// their corners, spheres with their lowest point, bodies without a collider with their origin.
+void PhysicsSystem::AddTerrainContacts(const TerrainSampler& terrain, uint32_t body)
+{
+    if (m_World.GetInverseMass(body) == 0.0f) return;
+    const BodyLink& link = m_Bodies[body];
+
+    auto heightAt = [&](float x, float z) { return terrain.GetHeightAt(x, z); };
+
+    glm::vec3 position = m_World.GetPosition(body);
+    glm::vec3 normal = GetTerrainNormal(terrain, position.x, position.z);
+
+    ContactPoint points[8];
+    int count = 0;
+    auto addPoint = [&](const glm::vec3& point) {
+        float depth = (heightAt(point.x, point.z) - point.y) * normal.y;
+        if (depth < -Narrowphase::CONTACT_MARGIN) return;
+        points[count].position = point + normal * (depth * 0.5f);
+        points[count].depth = depth;
+        count++;
+    };
+
+    CollisionBox box;
+    CollisionSphere sphere;
+    if (GetCollisionBox(link, box))
+    {
+        for (int i = 0; i < 8; i++)
+        {
+            glm::vec3 corner = box.center;
+            corner += box.axes[0] * ((i & 1) ? box.halfExtents.x : -box.halfExtents.x);
+            corner += box.axes[1] * ((i & 2) ? box.halfExtents.y : -box.halfExtents.y);
+            corner += box.axes[2] * ((i & 4) ? box.halfExtents.z : -box.halfExtents.z);
+            addPoint(corner);
         }
     }
-    
-    // COLLISION DETECTION
-    // Right Now, brute force method, will switch to quad tree later
-    for (auto itA = mEntities.begin(); itA != mEntities.end(); ++itA) {
-        for (auto itB = std::next(itA); itB != mEntities.end(); ++itB) {
-            
-            auto* colliderA = m_Coordinator->GetComponent<ColliderComponent>(*itA);
-            auto* colliderB = m_Coordinator->GetComponent<ColliderComponent>(*itB);
-            
-            auto* rbA = m_Coordinator->GetComponent<RigidBodyComponent>(*itA);
-            auto* rbB = m_Coordinator->GetComponent<RigidBodyComponent>(*itB);
-            
-            if (rbA->isStatic && rbB->isStatic) continue;
-            
-            if (colliderA && colliderB)
+    else if (GetCollisionSphere(link, sphere)) addPoint(sphere.center - normal * sphere.radius);
+    else addPoint(position);
+    if (count == 0) return;
+
+    if (link.collider)
+    {
+        for (int i = 0; i < count; i++) if (points[i].depth >= 0.0f) link.collider->isColliding = true;
+        if (link.collider->isTrigger) return;
+    }
+
+    ContactManifold manifold;
+    manifold.a = terrain.entity;
+    manifold.b = link.entity;
+    manifold.bodyA = NO_BODY;
+    manifold.bodyB = body;
+    manifold.normal = normal;
+    manifold.friction = link.collider ? link.collider->friction : 0.5f;
+    manifold.restitution = link.collider ? link.collider->bounciness : 0.0f;
+    manifold.pointCount = Narrowphase::ReducePoints(points, count, normal);
+    std::copy(points, points + manifold.pointCount, manifold.points);
+    m_Manifolds.push_back(manifold);
+}
+
+// Central differences of the height, TERRAIN_NORMAL_STEP apart
+glm::vec3 PhysicsSystem::GetTerrainNormal(const TerrainSampler& terrain, float x, float z) const
+{
+    auto heightAt = [&](float x, float z) { return terrain.GetHeightAt(x, z); };
+    const float step = TERRAIN_NORMAL_STEP;
+    return glm::normalize(glm::vec3(heightAt(x - step, z) - heightAt(x + step, z),
+                                    2.0f * step,
+                                    heightAt(x, z - step) - heightAt(x, z + step)));
+}
+
+// For now we can only have one terrain
+TerrainSampler PhysicsSystem::GetTerrainSampler() const
+{
+    if (!m_TerrainSystem || m_TerrainSystem->GetTerrainEntity() == UINT32_MAX) return TerrainSampler();
+    return m_TerrainSystem->GetSampler(m_TerrainSystem->GetTerrainEntity());
+}
+
+// Collider world transforms carry position, rotation and scale; the shapes take the scale
+// out of the axes and put it into the extents
+bool PhysicsSystem::GetCollisionBox(const BodyLink& link, CollisionBox& box) const
+{
+    if (!link.collider || link.collider->type != ColliderType::Box || !link.box) return false;
+
+    const glm::mat4& world = link.collider->worldTransform;
+    for (int i = 0; i < 3; i++)
+    {
+        glm::vec3 axis = glm::vec3(world[i]);
+        float length = glm::length(axis);
+        if (length > 1e-6f) box.axes[i] = axis / length;
+        box.halfExtents[i] = link.box->extents[i] * length;
+    }
+    box.center = glm::vec3(world[3]);
+    return true;
+}
+
+bool PhysicsSystem::GetCollisionSphere(const BodyLink& link, CollisionSphere& sphere) const
+{
+    if (!link.collider || link.collider->type != ColliderType::Sphere || !link.sphere) return false;
+
+    // Same as the bounds: radius scaled by the largest scale component
+    const glm::vec3& scale = link.transform->scale;
+    sphere.center = glm::vec3(link.collider->worldTransform[3]);
+    sphere.radius = link.sphere->radius * std::max({ scale.x, scale.y, scale.z });
+    return true;
+}
+
+
+// CONTINUOUS COLLISION
+// Runs after integration. Colliders still hold the poses of the start of the step, so every
+// body's shape is swept from there along its own displacement of the step. A bullet that
+// hits something stops TARGET_GAP short of it, exchanges an impulse along the hit normal and
+// sweeps on with the rest of the step, up to CCD_MAX_SUBSTEPS times. Only bullets pay for
+// this, the world keeps its step size.
+
+void PhysicsSystem::SweepBullets(float deltaTime)
+{
+    // Hit bodies may wake and join the list, they are not bullets to sweep this step
+    size_t count = m_AwakeBodies.size();
+    TerrainSampler terrain = GetTerrainSampler();
+    for (size_t i = 0; i < count; i++)
+    {
+        uint32_t body = m_AwakeBodies[i];
+        if (m_Bodies[body].rigidBody->isBullet && m_World.GetInverseMass(body) > 0.0f) SweepBullet(body, terrain, deltaTime);
+    }
+}
+
+void PhysicsSystem::SweepBullet(uint32_t body, const TerrainSampler& terrain, float deltaTime)
+{
+    const BodyLink& link = m_Bodies[body];
+    SweepShape shape;
+    if (!GetSweepShape(link, shape) || link.collider->isTrigger) return;
+
+    glm::vec3 start = m_World.GetPreviousPosition(body);
+    if (glm::length(m_World.GetPosition(body) - start) < CCD_MOTION_THRESHOLD * shape.GetInnerRadius()) return;
+
+    glm::vec3 position = start;
+    glm::vec3 velocity = m_World.GetVelocity(body);
+    float time = 0.0f;      // Fraction of the step done
+
+    for (int substep = 0; substep < CCD_MAX_SUBSTEPS && time < 1.0f; substep++)
+    {
+        float remaining = 1.0f - time;
+        glm::vec3 motion = velocity * (deltaTime * remaining);
+        SweepShape moving = shape;
+        moving.Translate(position - start);
+
+        // Candidates overlapping the swept bounds, at their start of step bounds
+        glm::vec3 min, max;
+        moving.GetBounds(min, max);
+        m_SweepCandidates.clear();
+        m_Broadphase.Query(glm::min(min, min + motion), glm::max(max, max + motion), m_SweepCandidates);
+
+        TimeOfImpact first;
+        uint32_t hitBody = NO_BODY;
+        bool hit = false;
+        for (Entity entity : m_SweepCandidates)
+        {
+            uint32_t other = m_BodyOfEntity[entity];
+            if (other == NO_BODY || other == body) continue;
+            SweepShape target;
+            if (!GetSweepShape(m_Bodies[other], target) || m_Bodies[other].collider->isTrigger) continue;
+
+            // Relative to the other body, which moves along its own displacement meanwhile
+            glm::vec3 otherMotion = m_World.GetPosition(other) - m_World.GetPreviousPosition(other);
+            target.Translate(otherMotion * time);
+            TimeOfImpact impact;
+            if (CCD::ConservativeAdvancement(moving, target, motion - otherMotion * remaining, impact) && impact.fraction < first.fraction)
             {
-                ColliderType typeA = colliderA->type;
-                ColliderType typeB = colliderB->type;
-                
-                // Dispatch to specific Narrowphase algorithms
-                if (typeA == ColliderType::Box && typeB == ColliderType::Box)
-                {
-                    if(CheckBoxBoxCollision(*itA, *itB)) std::cout<<"Box Collided with Box\n";
-                }
-                else if (typeA == ColliderType::Sphere && typeB == ColliderType::Sphere)
-                {
-                    if(CheckSphereSphereCollision(*itA, *itB)) std::cout<<"Sphere Collided with Sphere\n";
-                }
-                else if (typeA == ColliderType::Sphere && typeB == ColliderType::Box)
-                {
-                    if(CheckSphereBoxCollision(*itA, *itB)) std::cout<<"Sphere Collided with Box\n";
-                }
-                else if (typeA == ColliderType::Box && typeB == ColliderType::Sphere)
-                {
-                    if(CheckSphereBoxCollision(*itB, *itA)) std::cout<<"Box Collided with Sphere\n";
-                }
+                first = impact;
+                hitBody = other;
+                hit = true;
             }
         }
+        TimeOfImpact impact;
+        if (terrain && SweepTerrain(terrain, moving, motion, impact) && impact.fraction < first.fraction)
+        {
+            first = impact;
+            hitBody = NO_BODY;
+            hit = true;
+        }
+
+        if (!hit)
+        {
+            position += motion;
+            break;
+        }
+        position += motion * first.fraction;
+        time += remaining * first.fraction;
+
+        // Impulse through the centers of mass, as if both were spheres. The bodies are within
+        // the contact margin now, spin and friction are left to the solver next step.
+        glm::vec3 otherVelocity = hitBody != NO_BODY ? m_World.GetVelocity(hitBody) : glm::vec3(0.0f);
+        float approach = glm::dot(velocity - otherVelocity, first.normal);
+        if (approach <= 0.0f) continue;
+
+        float invMass = m_World.GetInverseMass(body);
+        float otherInvMass = hitBody != NO_BODY ? m_World.GetInverseMass(hitBody) : 0.0f;
+        float bounciness = link.collider->bounciness;
+        if (hitBody != NO_BODY) bounciness = std::max(bounciness, m_Bodies[hitBody].collider->bounciness);
+        float restitution = approach > ContactSolver::RESTITUTION_THRESHOLD ? bounciness : 0.0f;
+
+        float impulse = (1.0f + restitution) * approach / (invMass + otherInvMass);
+        velocity -= first.normal * (impulse * invMass);
+        if (otherInvMass > 0.0f)
+        {
+            m_World.SetVelocity(hitBody, otherVelocity + first.normal * (impulse * otherInvMass));
+            WakeBody(hitBody);
+        }
+    }
+
+    m_World.SetPosition(body, position);
+    m_World.SetVelocity(body, velocity);
+}
+
+// Terrain contacts take over from the lowest point of the shape, shapes touching the ground
+// already are left to them
+bool PhysicsSystem::SweepTerrain(const TerrainSampler& terrain, const SweepShape& shape, const glm::vec3& motion, TimeOfImpact& hit) const
+{
+    float fraction;
+    if (!MarchTerrain(terrain, shape.GetLowestPoint(), motion, CCD::TARGET_GAP, TERRAIN_SWEEP_MAX_SAMPLES, fraction)) return false;
+
+    glm::vec3 point = shape.GetLowestPoint() + motion * fraction;
+    hit.fraction = fraction;
+    hit.normal = -GetTerrainNormal(terrain, point.x, point.z);
+    return true;
+}
+
+// Marches the point along the motion, about one terrain normal step at a time, and bisects the
+// first stretch that ends within gap of the ground. Only the part of the motion over the
+// footprint is marched, there is no ground outside it. False when it enters the footprint
+// on or below the ground.
+bool PhysicsSystem::MarchTerrain(const TerrainSampler& terrain, const glm::vec3& start, const glm::vec3& motion, float gap, int maxSamples, float& fraction) const
+{
+    glm::vec2 footprintMin, footprintMax;
+    terrain.GetFootprint(footprintMin, footprintMax);
+    float enter, exit;
+    if (!Queries::ClipSegmentXZ(start, motion, footprintMin, footprintMax, enter, exit)) return false;
+
+    auto above = [&](float t) {
+        glm::vec3 point = start + motion * t;
+        return point.y - terrain.GetHeightAt(point.x, point.z) > gap;
+    };
+    if (!above(enter)) return false;
+
+    float horizontal = glm::length(glm::vec2(motion.x, motion.z)) * (exit - enter);
+    int samples = std::clamp((int)std::ceil(horizontal / TERRAIN_NORMAL_STEP), 1, maxSamples);
+    float last = enter;
+    for (int i = 1; i <= samples; i++)
+    {
+        float t = enter + (exit - enter) * i / samples;
+        if (above(t))
+        {
+            last = t;
+            continue;
+        }
+
+        float low = last, high = t;
+        for (int k = 0; k < TERRAIN_SWEEP_BISECTIONS; k++)
+        {
+            float middle = 0.5f * (low + high);
+            if (above(middle)) low = middle;
+            else high = middle;
+        }
+        fraction = low;
+        return true;
+    }
+    return false;
+}
+
+bool PhysicsSystem::GetSweepShape(const BodyLink& link, SweepShape& shape) const
+{
+    shape.isSphere = GetCollisionSphere(link, shape.sphere);
+    return shape.isSphere || GetCollisionBox(link, shape.box);
+}
+
+// QUERIES
+// Rays walk the broadphase grid cell by cell and stop at the first cell whose exit lies beyond
+// the closest hit; shape casts and overlaps test the candidates in their (swept) bounds.
+
+void PhysicsSystem::UpdateQueries()
+{
+    if (!m_Coordinator) return;
+    if (m_BodiesRevision != m_Coordinator->GetComponentRevision() || m_Bodies.size() != mEntities.size())
+        RebuildBodies();
+    if (!m_QueriesStale) return;
+
+    RefreshProxies();
+    m_Broadphase.BuildGrid();
+    m_QueriesStale = false;
+}
+
+bool PhysicsSystem::Raycast(const glm::vec3& origin, const glm::vec3& direction, float maxDistance, RaycastHit& hit, bool hitTriggers)
+{
+    hit = RaycastHit();
+    float length = glm::length(direction);
+    if (length < 1e-6f || maxDistance <= 0.0f) return false;
+
+    UpdateQueries();
+    return CastRay(origin, direction / length, maxDistance, GetTerrainSampler(), hit, hitTriggers);
+}
+
+void PhysicsSystem::RaycastBatch(const std::vector<RaycastQuery>& rays, std::vector<RaycastHit>& hits, bool hitTriggers)
+{
+    UpdateQueries();
+    hits.assign(rays.size(), RaycastHit());
+    // Component lookups are not safe from the jobs
+    TerrainSampler terrain = GetTerrainSampler();
+
+    int groups = (int)((rays.size() + RAYCAST_BATCH_SIZE - 1) / RAYCAST_BATCH_SIZE);
+    JobSystem::Get().ParallelFor(groups, [&](int group) {
+        size_t end = std::min(rays.size(), (size_t)(group + 1) * RAYCAST_BATCH_SIZE);
+        for (size_t i = (size_t)group * RAYCAST_BATCH_SIZE; i < end; i++)
+        {
+            float length = glm::length(rays[i].direction);
+            if (length < 1e-6f || rays[i].maxDistance <= 0.0f) continue;
+            CastRay(rays[i].origin, rays[i].direction / length, rays[i].maxDistance, terrain, hits[i], hitTriggers);
+        }
+    });
+}
+
+bool PhysicsSystem::CastRay(const glm::vec3& origin, const glm::vec3& direction, float maxDistance, const TerrainSampler& terrain, RaycastHit& hit, bool hitTriggers) const
+{
+    m_Broadphase.Raycast(origin, direction, maxDistance, [&](Entity entity) {
+        const BodyLink* link = GetQueryBody(entity, hitTriggers);
+        SweepShape shape;
+        if (!link || !GetSweepShape(*link, shape)) return maxDistance;
+
+        float distance;
+        glm::vec3 normal;
+        bool hitShape = shape.isSphere ? Queries::RaySphere(origin, direction, maxDistance, shape.sphere, distance, normal)
+                                       : Queries::RayBox(origin, direction, maxDistance, shape.box, distance, normal);
+        if (hitShape && (hit.entity == UINT32_MAX || distance < maxDistance))
+        {
+            hit.entity = entity;
+            hit.distance = maxDistance = distance;
+            hit.normal = normal;
+        }
+        return maxDistance;
+    });
+
+    // Up to the closest collider hit
+    float fraction;
+    if (terrain && MarchTerrain(terrain, origin, direction * maxDistance, 0.0f, TERRAIN_RAY_MAX_SAMPLES, fraction))
+    {
+        glm::vec3 point = origin + direction * (maxDistance * fraction);
+        hit.entity = terrain.entity;
+        hit.distance = maxDistance * fraction;
+        hit.normal = GetTerrainNormal(terrain, point.x, point.z);
+    }
+
+    if (hit.entity == UINT32_MAX) return false;
+    hit.point = origin + direction * hit.distance;
+    return true;
+}
+
+// Conservative advancement from the sweep, so hits stop CCD::TARGET_GAP short of the surface
+bool PhysicsSystem::SphereCast(const glm::vec3& origin, float radius, const glm::vec3& direction, float maxDistance, RaycastHit& hit, bool hitTriggers)
+{
+    hit = RaycastHit();
+    float length = glm::length(direction);
+    if (length < 1e-6f || maxDistance <= 0.0f) return false;
+    UpdateQueries();
+
+    SweepShape sphere;
+    sphere.sphere.center = origin;
+    sphere.sphere.radius = radius;
+    glm::vec3 motion = direction / length * maxDistance;
+
+    glm::vec3 min, max;
+    sphere.GetBounds(min, max);
+    std::vector<Entity> candidates;
+    m_Broadphase.Query(glm::min(min, min + motion), glm::max(max, max + motion), candidates);
+
+    TimeOfImpact first;
+    for (Entity entity : candidates)
+    {
+        const BodyLink* link = GetQueryBody(entity, hitTriggers);
+        SweepShape target;
+        TimeOfImpact impact;
+        if (!link || !GetSweepShape(*link, target)) continue;
+        if (CCD::ConservativeAdvancement(sphere, target, motion, impact) && impact.fraction < first.fraction)
+        {
+            first = impact;
+            hit.entity = entity;
+        }
+    }
+
+    TerrainSampler terrain = GetTerrainSampler();
+    TimeOfImpact impact;
+    if (terrain && SweepTerrain(terrain, sphere, motion, impact) && impact.fraction < first.fraction)
+    {
+        first = impact;
+        hit.entity = terrain.entity;
+    }
+
+    if (hit.entity == UINT32_MAX) return false;
+    hit.distance = first.fraction * maxDistance;
+    hit.normal = -first.normal;
+    hit.point = origin + motion * first.fraction + first.normal * radius;
+    return true;
+}
+
+void PhysicsSystem::OverlapSphere(const glm::vec3& center, float radius, std::vector<Entity>& results, bool hitTriggers)
+{
+    SweepShape sphere;
+    sphere.sphere.center = center;
+    sphere.sphere.radius = radius;
+    UpdateQueries();
+    Overlap(sphere, GetTerrainSampler(), results, hitTriggers);
+}
+
+void PhysicsSystem::OverlapBox(const glm::vec3& center, const glm::vec3& halfExtents, const glm::vec3& rotation, std::vector<Entity>& results, bool hitTriggers)
+{
+    SweepShape box;
+    box.isSphere = false;
+    box.box.center = center;
+    box.box.halfExtents = glm::abs(halfExtents);
+    glm::mat3 axes = glm::mat3_cast(EulerDegreesToQuat(rotation));
+    for (int i = 0; i < 3; i++) box.box.axes[i] = axes[i];
+    UpdateQueries();
+    Overlap(box, GetTerrainSampler(), results, hitTriggers);
+}
+
+// Candidates from the grid, kept when the shapes touch. The terrain counts once the lowest
+// point of the shape is below the ground.
+void PhysicsSystem::Overlap(const SweepShape& shape, const TerrainSampler& terrain, std::vector<Entity>& results, bool hitTriggers) const
+{
+    glm::vec3 min, max;
+    shape.GetBounds(min, max);
+    results.clear();
+    m_Broadphase.Query(min, max, results);
+
+    size_t count = 0;
+    for (Entity entity : results)
+    {
+        const BodyLink* link = GetQueryBody(entity, hitTriggers);
+        SweepShape target;
+        glm::vec3 normal;
+        if (link && GetSweepShape(*link, target) && CCD::Distance(shape, target, normal) <= 0.0f) results[count++] = entity;
+    }
+    results.resize(count);
+
+    if (!terrain) return;
+    glm::vec3 lowest = shape.GetLowestPoint();
+    if (terrain.Contains(lowest.x, lowest.z) && lowest.y <= terrain.GetHeightAt(lowest.x, lowest.z)) results.push_back(terrain.entity);
+}
+
+const PhysicsSystem::BodyLink* PhysicsSystem::GetQueryBody(Entity entity, bool hitTriggers) const
+{
+    uint32_t body = entity < m_BodyOfEntity.size() ? m_BodyOfEntity[entity] : NO_BODY;
+    if (body == NO_BODY) return nullptr;
+
+    const BodyLink& link = m_Bodies[body];
+    if (!link.collider || (link.collider->isTrigger && !hitTriggers)) return nullptr;
+    return &link;
+}
+
+// BODIES
+// Component pointers are cached per body and only looked up again when the coordinator's
+// component revision changes (components added or removed anywhere, entities destroyed).
+
+void PhysicsSystem::RebuildBodies()
+{
+    // Old links may point at moved components, go through the coordinator once
+    for (const BodyLink& link : m_Bodies)
+    {
+        if (auto* transform = m_Coordinator->GetComponent<TransformComponent>(link.entity))
+            transform->SetRenderOffset(glm::vec3(0.0f));
+    }
+
+    // Bodies keep their sleep state across the rebuild, by entity
+    struct SleepState { bool awake; float sleepTime; };
+    std::vector<SleepState> sleepStates(m_Bodies.size());
+    for (uint32_t body = 0; body < m_Bodies.size(); body++)
+        sleepStates[body] = { m_World.IsAwake(body), m_World.GetSleepTime(body) };
+    std::vector<uint32_t> oldBodyOfEntity;
+    oldBodyOfEntity.swap(m_BodyOfEntity);
+
+    m_QueriesStale = true;
+    m_World.Clear();
+    m_Bodies.clear();
+    m_Bodies.reserve(mEntities.size());
+    m_BodyOfEntity.assign(MAX_ENTITIES, NO_BODY);
+
+    for (Entity entity : mEntities)
+    {
+        BodyLink link;
+        link.entity = entity;
+        link.rigidBody = m_Coordinator->GetComponent<RigidBodyComponent>(entity);
+        link.transform = m_Coordinator->GetComponent<TransformComponent>(entity);
+        link.collider = m_Coordinator->GetComponent<ColliderComponent>(entity);
+        link.box = m_Coordinator->GetComponent<BoxColliderComponent>(entity);
+        link.sphere = m_Coordinator->GetComponent<SphereColliderComponent>(entity);
+
+        const RigidBodyComponent* rb = link.rigidBody;
+        link.transformRevision = link.transform->revision;
+        link.velocity = rb->velocity;
+        link.angularVelocity = rb->angularVelocity;
+        link.orientation = EulerDegreesToQuat(link.transform->rotation);
+
+        uint32_t body = m_World.AddBody(link.transform->position, rb->velocity);
+        m_World.SetOrientation(body, link.orientation);
+        m_Bodies.push_back(link);
+        m_BodyOfEntity[entity] = body;
+        SyncBodyType(body);
+        if (!rb->freezeRotation) m_World.SetAngularVelocity(body, rb->angularVelocity);
+
+        // New bodies start awake
+        uint32_t oldBody = entity < oldBodyOfEntity.size() ? oldBodyOfEntity[entity] : NO_BODY;
+        if (oldBody == NO_BODY || oldBody >= sleepStates.size()) continue;
+        if (!sleepStates[oldBody].awake) m_World.Sleep(body);
+        m_World.SetSleepTime(body, sleepStates[oldBody].sleepTime);
+    }
+
+    // Cached contacts follow their entities to the new indices, so stacks keep their warm start.
+    // Bodies that lost a contact partner wake up, they may have been resting on it.
+    std::vector<uint32_t> orphaned;
+    m_Solver.RemapBodies(m_BodyOfEntity, orphaned);
+    for (uint32_t body : orphaned) m_World.Wake(body);
+    m_BodiesRevision = m_Coordinator->GetComponentRevision();
+}
+
+// Mass, body type and the inertia derived from them and the collider shape
+void PhysicsSystem::SyncBodyType(uint32_t body)
+{
+    BodyLink& link = m_Bodies[body];
+    const RigidBodyComponent* rb = link.rigidBody;
+    link.mass = rb->mass;
+    link.gravityScale = rb->gravityScale;
+    link.isStatic = rb->isStatic;
+    link.isKinematic = rb->isKinematic;
+    link.freezeRotation = rb->freezeRotation;
+    m_World.SetBodyType(body, rb->mass, rb->gravityScale, rb->isStatic, rb->isKinematic);
+
+    // Solid box and sphere tensors; bodies without a collider shape do not rotate
+    glm::vec3 inertia(0.0f);
+    if (!rb->isStatic && !rb->isKinematic && !rb->freezeRotation && rb->mass > 0.0f)
+    {
+        const glm::vec3& scale = link.transform->scale;
+        if (link.collider && link.collider->type == ColliderType::Box && link.box)
+        {
+            glm::vec3 h = glm::abs(link.box->extents * scale);
+            inertia = rb->mass / 3.0f * glm::vec3(h.y * h.y + h.z * h.z, h.x * h.x + h.z * h.z, h.x * h.x + h.y * h.y);
+        }
+        else if (link.collider && link.collider->type == ColliderType::Sphere && link.sphere)
+        {
+            float r = link.sphere->radius * std::max({ scale.x, scale.y, scale.z });
+            inertia = glm::vec3(0.4f * rb->mass * r * r);
+        }
     }
+
+    glm::vec3 inverseInertia(0.0f);
+    for (int i = 0; i < 3; i++) if (inertia[i] > 1e-6f) inverseInertia[i] = 1.0f / inertia[i];
+    m_World.SetInverseInertia(body, inverseInertia);
+    if (rb->freezeRotation) m_World.SetAngularVelocity(body, glm::vec3(0.0f));
 }
 
+// Copies whatever scripts or the inspector changed on the components into the world,
+// and wakes those bodies
+void PhysicsSystem::SyncBodies()
+{
+    if (m_BodiesRevision != m_Coordinator->GetComponentRevision() || m_Bodies.size() != mEntities.size())
+        RebuildBodies();
+    else
+    {
+        // Interpolation of the last step is over, bodies still moving get a new offset
+        for (uint32_t body : m_AwakeBodies) SetRenderOffset(m_Bodies[body], glm::vec3(0.0f));
+    }
+
+    m_AwakeBodies.clear();
+    for (uint32_t body = 0; body < m_Bodies.size(); body++)
+    {
+        BodyLink& link = m_Bodies[body];
+        RigidBodyComponent* rb = link.rigidBody;
+        bool wake = false;
+        bool retype = link.collider && link.collider->isDirty;     // Shape edited, inertia changes
+
+        if (link.transform->revision != link.transformRevision)
+        {
+            m_World.Teleport(body, link.transform->position);
+            link.orientation = EulerDegreesToQuat(link.transform->rotation);
+            m_World.SetOrientation(body, link.orientation);
+            link.transformRevision = link.transform->revision;
+            wake = retype = true;
+        }
+        if (rb->velocity != link.velocity)
+        {
+            m_World.SetVelocity(body, rb->velocity);
+            link.velocity = rb->velocity;
+            wake = true;
+        }
+        if (rb->angularVelocity != link.angularVelocity)
+        {
+            if (!rb->freezeRotation) m_World.SetAngularVelocity(body, rb->angularVelocity);
+            link.angularVelocity = rb->angularVelocity;
+            wake = true;
+        }
+        if (rb->acceleration != glm::vec3(0.0f))
+        {
+            m_World.AddAcceleration(body, rb->acceleration);
+            rb->acceleration = glm::vec3(0.0f);
+            wake = true;
+        }
+        if (rb->mass != link.mass || rb->gravityScale != link.gravityScale || rb->isStatic != link.isStatic ||
+            rb->isKinematic != link.isKinematic || rb->freezeRotation != link.freezeRotation)
+            wake = retype = true;
+
+        if (retype) SyncBodyType(body);
+        if (wake) m_World.Wake(body);
+        if (m_World.IsAwake(body)) m_AwakeBodies.push_back(body);
+    }
+}
+
+void PhysicsSystem::WriteBackBodies()
+{
+    for (uint32_t body : m_AwakeBodies)
+    {
+        BodyLink& link = m_Bodies[body];
+        link.transform->SetPosition(m_World.GetPosition(body));
+
+        // Euler angles only when the body actually turned, the conversion is not exact
+        glm::quat orientation = m_World.GetOrientation(body);
+        if (orientation != link.orientation)
+        {
+            link.transform->SetRotation(QuatToEulerDegrees(orientation));
+            link.orientation = orientation;
+        }
+        link.transformRevision = link.transform->revision;
+
+        link.velocity = m_World.GetVelocity(body);
+        link.rigidBody->velocity = link.velocity;
+        link.angularVelocity = m_World.GetAngularVelocity(body);
+        link.rigidBody->angularVelocity = link.angularVelocity;
+    }
+}
 
 // Updates the min/max bounds of a collider when the object moves or rotates.
 void PhysicsSystem::UpdateBounds(Entity entity) {
@@ -125,6 +918,7 @@ void PhysicsSystem::UpdateBounds(Entity entity) {
          
     // Only recalculate if the object actually moved
     if(transform->isDirty || collider->isDirty){
+        m_QueriesStale = true;
         glm::mat4 entityMatrix = GetWorldMatrix(transform);
         collider->worldTransform = glm::translate(entityMatrix, collider->center);
         collider->worldInverse = glm::inverse(collider->worldTransform);
@@ -169,232 +963,6 @@ void PhysicsSystem::UpdateBounds(Entity entity) {
     collider->isDirty = false;
 }
 
-// SAT PROJECTION
-// Helper function for Separating Axis Theorem.
-
-void PhysicsSystem::ProjectBox(const ColliderComponent* col, const BoxColliderComponent* box, const glm::vec3& axis, float& min, float& max)
-{
-
-    glm::vec3 worldRight = glm::vec3(col->worldTransform[0]);
-    glm::vec3 worldUp    = glm::vec3(col->worldTransform[1]);
-    glm::vec3 worldForward = glm::vec3(col->worldTransform[2]);
-    glm::vec3 worldCenter = glm::vec3(col->worldTransform[3]);
-
-    float centerProj = glm::dot(worldCenter, axis);
-
-    // Calculate projected radius
-    float radius =  box->extents.x * std::abs(glm::dot(worldRight, axis)) +
-                    box->extents.y * std::abs(glm::dot(worldUp, axis)) +
-                    box->extents.z * std::abs(glm::dot(worldForward, axis));
-
-    min = centerProj - radius;
-    max = centerProj + radius;
-}
-
-// BOX vs BOX COLLISION (Separating Axis Theorem)
-// First we see using AABB, then if needed we check using SAT
-bool PhysicsSystem::CheckBoxBoxCollision(Entity entityA, Entity entityB) {
-    if(!m_Coordinator) return;
-    
-    auto* colA = m_Coordinator->GetComponent<ColliderComponent>(entityA);
-    auto* colB = m_Coordinator->GetComponent<ColliderComponent>(entityB);
-    colA->isColliding = false;
-    colB->isColliding = false;
-    
-    if(entityA == entityB) return false;
-    auto* boxA = m_Coordinator->GetComponent<BoxColliderComponent>(entityA);
-    auto* boxB = m_Coordinator->GetComponent<BoxColliderComponent>(entityB);
-    
-    if(!boxA || !boxB) return false;
-         
-    // 1. Broadphase check (AABB)
-    // Fast fail: If the world-aligned boxes don't touch, the rotated ones definitely don't.
-    if (colA->worldMax.x < colB->worldMin.x || colA->worldMin.x > colB->worldMax.x ||
-        colA->worldMax.y < colB->worldMin.y || colA->worldMin.y > colB->worldMax.y ||
-        colA->worldMax.z < colB->worldMin.z || colA->worldMin.z > colB->worldMax.z)
-    {
-        return false;
-    }
-    
-    int counter = 0;
-    glm::vec3 axes[15];
-    
-    // 3 Face Normals from A
-    axes[counter++] = glm::normalize(glm::vec3(colA->worldTransform[0]));
-    axes[counter++] = glm::normalize(glm::vec3(colA->worldTransform[1]));
-    axes[counter++] = glm::normalize(glm::vec3(colA->worldTransform[2]));
-
-    // 3 Face Normals from B
-    axes[counter++] = glm::normalize(glm::vec3(colB->worldTransform[0]));
-    axes[counter++] = glm::normalize(glm::vec3(colB->worldTransform[1]));
-    axes[counter++] = glm::normalize(glm::vec3(colB->worldTransform[2]));
-    
-    // 9 Edge Cross Products (Edges of A crossed with Edges of B)
-    for (int i = 0; i < 3; i++) {
-        for (int j = 0; j < 3; j++) {
-            glm::vec3 cross = glm::cross(axes[i], axes[3 + j]);
-            if (glm::length(cross) > 0.001f) {
-                axes[counter++] = glm::normalize(cross);
-            }
-        }
-    }
-    
-    float minOverlap = FLT_MAX;
-    glm::vec3 collisionNormal;
-
-    // Test all axes
-    for(int i = 0; i < counter; ++i) {
-        float minA, maxA, minB, maxB;
-        ProjectBox(colA, boxA, axes[i], minA, maxA);
-        ProjectBox(colB, boxB, axes[i], minB, maxB);
-
-        // Gap found! No collision.
-        if (maxA < minB || maxB < minA) return false;
-
-        // Calculate overlap
-        float overlap = std::min(maxA, maxB) - std::max(minA, minB);
-        
-        // MTV (Minimum Translation Vector) Logic
-        // We want to push the object out along the minimum overlap axis
-        if (overlap < minOverlap) {
-            minOverlap = overlap;
-            collisionNormal = axes[i];
-        }
-    }
-
-    // COLLISION RESOLUTION
-    // All Axis Overlapped. Now we push objects apart.
-    if (minOverlap > 0.0001f) {
-         
-        // Ensure normal points from A to B
-        glm::vec3 centerA = glm::vec3(colA->worldTransform[3]);
-        glm::vec3 centerB = glm::vec3(colB->worldTransform[3]);
-        glm::vec3 dir = centerB - centerA;
-         
-        if (glm::length(collisionNormal) < 0.0001f) collisionNormal = glm::vec3(0, 1, 0);
-        else collisionNormal = glm::normalize(collisionNormal);
-         
-        if (glm::dot(dir, collisionNormal) < 0)
-            collisionNormal = -collisionNormal;
-         
-        auto* transformA = m_Coordinator->GetComponent<TransformComponent>(entityA);
-        auto* transformB = m_Coordinator->GetComponent<TransformComponent>(entityB);
-        auto* rbA = m_Coordinator->GetComponent<RigidBodyComponent>(entityA);
-        auto* rbB = m_Coordinator->GetComponent<RigidBodyComponent>(entityB);
-         
-        float invMassA = (rbA && !rbA->isStatic) ? 1.0f / rbA->mass : 0.0f;
-        float invMassB = (rbB && !rbB->isStatic) ? 1.0f / rbB->mass : 0.0f;
-         
-        float totalInvMass = invMassA + invMassB;
-         
-        if (totalInvMass > 0.0001f) {
-            float percent = 0.8f;
-            float slop = 0.01f;
-             
-            glm::vec3 push = collisionNormal * (std::max(minOverlap - slop, 0.0f) / totalInvMass) * percent;
-             
-            if (invMassA > 0) transformA->SetPosition(transformA->position - push * invMassA);
-            if (invMassB > 0) transformB->SetPosition(transformB->position + push * invMassB);
-        }
-         
-        // Reflection (Bouncing)
-        if (rbA && !rbA->isStatic && !rbA->isKinematic) {
-            float velAlongNormal = glm::dot(rbA->velocity, collisionNormal);
-            // Only reflect if moving towards the collider
-            if (velAlongNormal > 0) {
-                rbA->velocity = glm::reflect(rbA->velocity, collisionNormal) * colA->bounciness;
-            }
-        }
-        if (rbA && !rbA->isStatic && !rbA->isKinematic)
-            rbA->velocity = glm::reflect(rbA->velocity, collisionNormal) * colA->bounciness;
-         
-        colA->isColliding = true;
-        colB->isColliding = true;
-        return true;
-    }
-    return false;
-    
-}
-
-// SPHERE vs SPHERE
-// Simple distance check
-bool PhysicsSystem::CheckSphereSphereCollision(Entity entityA, Entity entityB) {
-    if(!m_Coordinator) return;
-    
-    auto* colA = m_Coordinator->GetComponent<ColliderComponent>(entityA);
-    auto* colB = m_Coordinator->GetComponent<ColliderComponent>(entityB);
-    auto* sphereA = m_Coordinator->GetComponent<SphereColliderComponent>(entityA);
-    auto* sphereB = m_Coordinator->GetComponent<SphereColliderComponent>(entityB);
-
-    if (!sphereA || !sphereB) return false;
-
-    glm::vec3 posA = glm::vec3(colA->worldTransform[3]);
-    glm::vec3 posB = glm::vec3(colB->worldTransform[3]);
-
-    glm::vec3 delta = posA - posB;
-    // Compare distance squared with radius squared
-    float distSq = glm::dot(delta, delta);
-    float sumRadii = sphereA->radius + sphereB->radius;
-
-    if (distSq < (sumRadii * sumRadii)) {
-        colA->isColliding = true;
-        colB->isColliding = true;
-        return true;
-    }
-
-    return false;
-}
-
-// SPHERE vs BOX
-// Find Closest Point on AABB -> Distance Check.
-bool PhysicsSystem::CheckSphereBoxCollision(Entity sphereEnt, Entity boxEnt) {
-    if(!m_Coordinator) return;
-    
-    auto* sphereCol = m_Coordinator->GetComponent<ColliderComponent>(sphereEnt);
-    auto* sphereData = m_Coordinator->GetComponent<SphereColliderComponent>(sphereEnt);
-    auto* boxCol = m_Coordinator->GetComponent<ColliderComponent>(boxEnt);
-    auto* boxData = m_Coordinator->GetComponent<BoxColliderComponent>(boxEnt);
-    
-    // Transform Sphere Center into Box's Local Coordinate Space
-    glm::mat4 boxInv = boxCol->worldInverse;
-    glm::vec3 sphereCenterWorld = glm::vec3(sphereCol->worldTransform[3]);
-    glm::vec3 localSphereCenter = glm::vec3(boxInv * glm::vec4(sphereCenterWorld, 1.0f));
-    
-    // Find closest point on the Box to the Sphere center (Clamp)
-    glm::vec3 closestPoint;
-    closestPoint.x = glm::clamp(localSphereCenter.x, -boxData->extents.x, boxData->extents.x);
-    closestPoint.y = glm::clamp(localSphereCenter.y, -boxData->extents.y, boxData->extents.y);
-    closestPoint.z = glm::clamp(localSphereCenter.z, -boxData->extents.z, boxData->extents.z);
-    
-    // Check distance
-    float distance = glm::distance(localSphereCenter, closestPoint);
-    
-    if (distance < sphereData->radius) {
-        float overlap = sphereData->radius - distance;
-         
-        // Calculate collision normal in Local Space
-        glm::vec3 localNormal = glm::normalize(localSphereCenter - closestPoint);
-         
-        // Transform normal back to World Space
-        glm::vec3 worldNormal = glm::normalize(glm::vec3(boxCol->worldTransform * glm::vec4(localNormal, 0.0f)));
-         
-        
-        auto* sphereTransform = m_Coordinator->GetComponent<TransformComponent>(sphereEnt);
-        sphereTransform->SetPosition(sphereTransform->position + worldNormal * overlap);
-         
-        // Bounce
-        auto* rb = m_Coordinator->GetComponent<RigidBodyComponent>(sphereEnt);
-        if(rb && !rb->isKinematic) {
-            rb->velocity = glm::reflect(rb->velocity, worldNormal) * sphereCol->bounciness;
-        }
-         
-        sphereCol->isColliding = true;
-        boxCol->isColliding = true;
-        return true;
-    }
-    return false;
-}
-
 glm::mat4 PhysicsSystem::GetWorldMatrix(const TransformComponent* transform) {
     if(!transform) return;
     glm::mat4 model = glm::mat4(1.0f);
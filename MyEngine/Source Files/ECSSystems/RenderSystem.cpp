@@ -8,14 +8,27 @@
 #include "ECSSystems/RenderSystem.h"
 #include "ECS/Coordinator.h"
 #include "AssetManager.h"
+#include "MeshPool.h"
 #include "GLAD/include/glad/glad.h"
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtc/type_ptr.hpp>
+#include <cstring>
 
+namespace {
+    constexpr UniformID U_INSTANCED("u_Instanced");
+    constexpr UniformID U_MAIN_TEXTURE("mainTexture");
+    constexpr UniformID U_NORMAL_MAP("normalMap");
+    constexpr UniformID U_SPECULAR_MAP("specularMap");
+}
 
 void RenderSystem::Init()
 {
+    // Material records are bound by range, so each one starts on the required alignment
+    GLint alignment = UniformBuffer::GetOffsetAlignment();
+    m_MaterialStride = (sizeof(MaterialUniforms) + alignment - 1) / alignment * alignment;
+    
+    MeshPool::Get().Init();
 }
 
 // MESH UPLOAD TO GPU
@@ -38,7 +51,7 @@ void RenderSystem::UploadMeshIfNeeded(Entity e, MeshComponent* mc)
     
     // DATA
     // Layout: [PosX, PosY, PosZ, NormX, NormY, NormZ, U, V, TanX, TanY, TanZ]
-    // Stride: 11 floats
+    // Stride: 11 floats (MeshPool::VERTEX_FLOATS)
     
     std::vector<float> gpuVertices;
     std::vector<uint32_t> gpuIndices;
@@ -67,53 +80,33 @@ void RenderSystem::UploadMeshIfNeeded(Entity e, MeshComponent* mc)
         gpuVertices.push_back(v.tangent.z);
     }
 
-    // Flatten face indices for EBO
-    for (const auto& face : mesh->faces)
+    // Flatten face indices
+    // With LODs, every level is appended to the same index range and drawn by offset.
+    if (mesh->lods.empty())
     {
-        for (int index : face.vertexIndices)
-            gpuIndices.push_back(index);
+        for (const auto& face : mesh->faces)
+        {
+            for (int index : face.vertexIndices)
+                gpuIndices.push_back(index);
+        }
+        mesh->indexCount = static_cast<int>(gpuIndices.size());
+    }
+    else
+    {
+        for (auto& lod : mesh->lods)
+        {
+            lod.firstIndex = static_cast<uint32_t>(gpuIndices.size());
+            lod.indexCount = static_cast<uint32_t>(lod.indices.size());
+            gpuIndices.insert(gpuIndices.end(), lod.indices.begin(), lod.indices.end());
+        }
+        mesh->indexCount = static_cast<int>(mesh->lods[0].indexCount);
     }
-
-    mesh->indexCount = static_cast<int>(gpuIndices.size());
     int verticesSize = static_cast<int>(gpuVertices.size());
 
     std::cout<<"[GPU Upload] Mesh Uploaded: " << mesh->indexCount << " Indices || " << verticesSize << " Vertices" << std::endl;
     
-    // Generate OpenGL Buffers
-    glGenVertexArrays(1, &mesh->VAO);
-    glGenBuffers(1, &mesh->VBO);
-    glGenBuffers(1, &mesh->EBO);
-
-    glBindVertexArray(mesh->VAO);
-
-    // Upload Vertex Data
-    glBindBuffer(GL_ARRAY_BUFFER, mesh->VBO);
-    glBufferData(GL_ARRAY_BUFFER, gpuVertices.size() * sizeof(float), gpuVertices.data(), GL_STATIC_DRAW);
-
-    // Upload Index Data
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, mesh->EBO);
-    glBufferData(GL_ELEMENT_ARRAY_BUFFER, gpuIndices.size() * sizeof(uint32_t), gpuIndices.data(), GL_STATIC_DRAW);
-
-    int stride = 11 * sizeof(float);
-    
-    // 1. Position
-    glEnableVertexAttribArray(0);
-    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, stride, (void*)0);
-
-    // 2. Normal
-    glEnableVertexAttribArray(1);
-    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, stride, (void*)(3 * sizeof(float)));
-
-    // 3. UV
-    glEnableVertexAttribArray(2);
-    glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, stride, (void*)(6 * sizeof(float)));
-    
-    // 4. Tangent
-    glEnableVertexAttribArray(3);
-    glVertexAttribPointer(3, 3, GL_FLOAT, GL_FALSE, stride, (void*)(8 * sizeof(float)));
-
-    glBindBuffer(GL_ARRAY_BUFFER, 0);
-    glBindVertexArray(0);
+    // Sub-allocate from the global pool (frees the old range on re-upload)
+    if (!MeshPool::Get().Upload(mesh, gpuVertices, gpuIndices)) return;
 
     mesh->uploaded = true;
 }
@@ -121,7 +114,7 @@ void RenderSystem::UploadMeshIfNeeded(Entity e, MeshComponent* mc)
 glm::mat4 RenderSystem::BuildModelMatrix(TransformComponent* t)
 {
     glm::mat4 model(1.0f);
-    model = glm::translate(model, t->position);
+    model = glm::translate(model, t->position + t->renderOffset);
     model = glm::rotate(model, glm::radians(t->rotation.x), glm::vec3(1, 0, 0));
     model = glm::rotate(model, glm::radians(t->rotation.y), glm::vec3(0, 1, 0));
     model = glm::rotate(model, glm::radians(t->rotation.z), glm::vec3(0, 0, 1));
@@ -130,93 +123,416 @@ glm::mat4 RenderSystem::BuildModelMatrix(TransformComponent* t)
     return model;
 }
 
-// RENDER LOOP
-// Iterates over all entities with a Mesh + Transform and draw.
+// LOD SELECTION
+// Projects the world space bounding sphere and picks a level by the fraction
+// of the screen height it covers.
+
+int RenderSystem::SelectLOD(const Mesh* mesh, const glm::mat4& model, const glm::vec3& cameraPos, float projScale) const
+{
+    if (mesh->lods.size() <= 1) return 0;
+    
+    glm::vec3 worldCenter = glm::vec3(model * glm::vec4(mesh->boundsCenter, 1.0f));
+    float maxScale = std::max({ glm::length(glm::vec3(model[0])), glm::length(glm::vec3(model[1])), glm::length(glm::vec3(model[2])) });
+    float worldRadius = mesh->boundsRadius * maxScale;
+    
+    float distance = glm::length(worldCenter - cameraPos);
+    if (distance <= worldRadius) return 0;
+    
+    float screenCoverage = worldRadius * projScale / distance;
+    
+    int lod = 0;
+    int maxLod = static_cast<int>(mesh->lods.size()) - 1;
+    while (lod < maxLod && lod < 3 && screenCoverage < LOD_SCREEN_THRESHOLDS[lod]) lod++;
+    return lod;
+}
+
+// WORLD BOUNDS
+// Model matrix and world AABB are cached on the MeshComponent and only rebuilt
+// when the transform revision or the mesh changes.
+
+bool RenderSystem::UpdateWorldBounds(TransformComponent* t, MeshComponent* mc, const Mesh* mesh)
+{
+    if (!t->isDirty && mc->boundsRevision == t->revision && mc->boundsMeshID == mc->meshID) return false;
+    
+    mc->worldTransform = BuildModelMatrix(t);
+    mc->worldBounds = mesh->bounds.Transformed(mc->worldTransform);
+    mc->boundsRevision = t->revision;
+    mc->boundsMeshID = mc->meshID;
+    return true;
+}
+
+void RenderSystem::OnEntityRemoved(Entity entity)
+{
+    if (m_SceneBVH.Contains(entity) && !IsDynamicCaster(entity)) m_StaticCastersChanged = true;
+    m_SceneBVH.Remove(entity);
+}
+
+// SHADOW CASTERS
+// Anything physics or a script can move is drawn into the shadow map every frame,
+// the rest is cached and only redrawn when it changes.
+
+bool RenderSystem::IsDynamicCaster(Entity e) const
+{
+    return e < m_DynamicCasters.size() && m_DynamicCasters[e];
+}
 
-void RenderSystem::Render(Shader& shader)
+bool RenderSystem::ConsumeStaticCasterChanges()
+{
+    bool changed = m_StaticCastersChanged;
+    m_StaticCastersChanged = false;
+    return changed;
+}
+
+void RenderSystem::SyncSceneBounds()
 {
     if(!m_Coordinator) return;
     
+    // Start of a new frame
+    m_LastFrameStats = m_FrameStats;
+    m_FrameStats = RenderStats();
+    
+    m_DynamicCasters.resize(MAX_ENTITIES, 0);
+    m_DynamicCasterCount = 0;
+    
     for (Entity e : mEntities)
     {
         TransformComponent* transform = m_Coordinator->GetComponent<TransformComponent>(e);
         MeshComponent* meshComp  = m_Coordinator->GetComponent<MeshComponent>(e);
+        
+        RigidBodyComponent* rigidBody = m_Coordinator->GetComponent<RigidBodyComponent>(e);
+        bool dynamic = (rigidBody && !rigidBody->isStatic) || m_Coordinator->GetComponent<ScriptComponent>(e);
+        
+        // Switching sides adds/removes it from the cached static map
+        if (m_DynamicCasters[e] != dynamic && m_SceneBVH.Contains(e)) m_StaticCastersChanged = true;
+        m_DynamicCasters[e] = dynamic;
 
         UploadMeshIfNeeded(e, meshComp);
+        
+        Mesh* mesh = nullptr;
+        if (meshComp->meshID != UINT32_MAX)
+            mesh = static_cast<Mesh*>(AssetManager::Get().GetAsset(AssetType::Mesh, meshComp->meshID).Data);
+        
+        // Not drawable (yet): keep it out of the tree
+        if (!mesh || !mesh->uploaded) {
+            if (!dynamic && m_SceneBVH.Contains(e)) m_StaticCastersChanged = true;
+            m_SceneBVH.Remove(e);
+            meshComp->boundsMeshID = UINT32_MAX;
+            continue;
+        }
+        
+        if (dynamic) m_DynamicCasterCount++;
+        
+        if (UpdateWorldBounds(transform, meshComp, mesh)) {
+            m_SceneBVH.Update(e, meshComp->worldBounds);
+            if (!dynamic) m_StaticCastersChanged = true;
+        }
+    }
+    
+    if (m_SceneBVH.NeedsRebuild()) m_SceneBVH.Rebuild();
+}
+
+// CULLING
+// The BVH rejects/accepts whole subtrees, leaves that straddle the frustum are
+// batch tested on their exact bounds. Camera passes then drop what last frame's
+// Hi-Z pyramid occludes. Result goes to m_VisibleEntities.
+
+uint32_t RenderSystem::CullVisible(const glm::mat4& cullMatrix, bool occlusion)
+{
+    m_Frustum.Extract(cullMatrix);
+    m_VisibleEntities.clear();
+    m_CullEntities.clear();
+    m_SceneBVH.QueryFrustum(m_Frustum, m_VisibleEntities, &m_CullEntities);
+    
+    m_CullCenterX.clear(); m_CullCenterY.clear(); m_CullCenterZ.clear();
+    m_CullExtentX.clear(); m_CullExtentY.clear(); m_CullExtentZ.clear();
+    
+    for (Entity e : m_CullEntities)
+    {
+        const AABB& bounds = m_Coordinator->GetComponent<MeshComponent>(e)->worldBounds;
+        glm::vec3 center = bounds.GetCenter();
+        glm::vec3 extents = bounds.GetExtents();
+        m_CullCenterX.push_back(center.x); m_CullCenterY.push_back(center.y); m_CullCenterZ.push_back(center.z);
+        m_CullExtentX.push_back(extents.x); m_CullExtentY.push_back(extents.y); m_CullExtentZ.push_back(extents.z);
+    }
+    
+    m_CullVisible.resize(m_CullEntities.size());
+    m_Frustum.CullAABBs(m_CullCenterX.data(), m_CullCenterY.data(), m_CullCenterZ.data(),
+                        m_CullExtentX.data(), m_CullExtentY.data(), m_CullExtentZ.data(),
+                        m_CullEntities.size(), m_CullVisible.data());
+    
+    for (size_t i = 0; i < m_CullEntities.size(); i++)
+        if (m_CullVisible[i]) m_VisibleEntities.push_back(m_CullEntities[i]);
+    
+    // Occlusion against last frame's depth pyramid
+    if (!occlusion || !m_OcclusionBuffer || !m_OcclusionBuffer->IsReady()) return 0;
+    
+    size_t kept = 0;
+    for (Entity e : m_VisibleEntities)
+    {
+        if (m_OcclusionBuffer->IsOccluded(m_Coordinator->GetComponent<MeshComponent>(e)->worldBounds)) continue;
+        m_VisibleEntities[kept++] = e;
+    }
+    uint32_t occluded = static_cast<uint32_t>(m_VisibleEntities.size() - kept);
+    m_VisibleEntities.resize(kept);
+    return occluded;
+}
+
+// MATERIAL TABLE
+// Entities with identical material values share one index, so their packets
+// sort together and the material is bound once.
+
+uint32_t RenderSystem::GetMaterialIndex(const Material& material)
+{
+    MaterialKey key { material.albedoID, material.normalID, material.specID,
+                      material.Ambient, material.Diffuse, material.Specular, material.Shininess, material.Opacity };
+    
+    auto it = m_MaterialLookup.find(key);
+    if (it != m_MaterialLookup.end()) return it->second;
+    
+    MaterialBinding binding;
+    binding.material = &material;
+    
+    const uint32_t textureIDs[3] = { material.albedoID, material.normalID, material.specID };
+    for (int unit = 0; unit < 3; unit++)
+    {
+        if (textureIDs[unit] == UINT32_MAX) continue;
+        AssetHandle handle = AssetManager::Get().GetAsset(AssetType::Texture, textureIDs[unit]);
+        if (handle.IsReady && handle.Data)
+            binding.textures[unit] = static_cast<TextureData*>(handle.Data)->TextureObject;
+    }
+    
+    uint32_t index = static_cast<uint32_t>(m_Materials.size());
+    m_Materials.push_back(binding);
+    m_MaterialLookup.emplace(key, index);
+    return index;
+}
 
-        glm::mat4 model = BuildModelMatrix(transform);
-        shader.SetMatrix4(model, "transformMatrix");
+// RENDER LOOP
+// Cull -> gather packets -> sort by key -> submit with minimal state changes.
+
+void RenderSystem::Render(Shader& shader, const glm::mat4& cullMatrix, RenderPass pass, CasterFilter filter)
+{
+    if(!m_Coordinator || !m_FrameAllocator) return;
+    
+    // Camera data for LOD selection. Shadow pass uses the same LODs as the main view.
+    glm::vec3 cameraPos(0.0f);
+    float projScale = 0.0f;
+    if (m_CameraSystem) {
+        cameraPos = m_CameraSystem->GetCameraPosition();
+        projScale = m_CameraSystem->GetCameraProjection()[1][1];
+    }
+    
+    // Light views are never occlusion culled, the Hi-Z holds camera depth
+    uint32_t occluded = CullVisible(cullMatrix, pass != RenderPass::Shadow);
+    if (pass == RenderPass::Opaque) m_FrameStats.occluded += occluded;
+    
+    // 1. Gather
+    bool useMaterials = pass != RenderPass::Shadow && pass != RenderPass::Depth;
+    m_Queue.Clear();
+    m_Materials.clear();
+    m_MaterialLookup.clear();
+    
+    for (Entity e : m_VisibleEntities)
+    {
+        if (filter != CasterFilter::All && IsDynamicCaster(e) != (filter == CasterFilter::Dynamic)) continue;
+        
+        MeshComponent* meshComp = m_Coordinator->GetComponent<MeshComponent>(e);
         
-        // Upload Material
-        shader.SetVec3("u_Material.ambient", meshComp->material.Ambient);
-        shader.SetVec3("u_Material.diffuse", meshComp->material.Diffuse);
-        shader.SetVec3("u_Material.specular", meshComp->material.Specular);
-        shader.SetFloat("u_Material.shininess", meshComp->material.Shininess);
+        // Blended materials only go through the transparent pass, shadows take everything
+        if (pass != RenderPass::Shadow && (meshComp->material.Opacity < 1.0f) != (pass == RenderPass::Transparent)) continue;
+        
+        Mesh* mesh = static_cast<Mesh*>(AssetManager::Get().GetAsset(AssetType::Mesh, meshComp->meshID).Data);
+        if (!mesh || !mesh->uploaded) continue;
         
-        bool hasAlbedo = false;
-        bool hasSpec = false;
-        bool hasNormal = false;
+        DrawPacket packet;
+        packet.entity = e;
+        packet.mesh = mesh;
+        packet.indexCount = static_cast<uint32_t>(mesh->indexCount);
+        int lodIndex = 0;
+        if (!mesh->lods.empty() && m_CameraSystem) {
+            lodIndex = SelectLOD(mesh, meshComp->worldTransform, cameraPos, projScale);
+            const MeshLOD& lod = mesh->lods[lodIndex];
+            packet.indexCount = lod.indexCount;
+            packet.firstIndex = lod.firstIndex;
+        }
+        packet.firstIndex += mesh->baseIndex;
         
+        packet.materialIndex = useMaterials ? GetMaterialIndex(meshComp->material) : 0;
         
-        // TEXTURE BINDING
+        // View depth of the bounds center, remapped to [0, 1] for the key
+        glm::vec4 clip = cullMatrix * glm::vec4(meshComp->worldBounds.GetCenter(), 1.0f);
+        float depth = clip.w > 0.0f ? (clip.z / clip.w) * 0.5f + 0.5f : 0.0f;
         
-        // 1. Albedo Map -> Unit 0
-        if (meshComp->material.albedoID != UINT32_MAX)
+        // Mesh bits = pool handle + LOD so packets that can share an instanced draw end up adjacent.
+        // Only 16 bits fit the key: handles past that alias, batching checks the packets themselves.
+        uint32_t meshBits = (mesh->poolHandle << 2) | static_cast<uint32_t>(lodIndex);
+        packet.sortKey = RenderQueue::MakeKey(pass, shader.shaderProgram, packet.materialIndex, meshBits, depth);
+        m_Queue.Push(packet);
+    }
+    
+    // 2. Sort
+    m_Queue.Sort();
+    
+    // 3. Instance data in sorted order, so every batch is a contiguous range.
+    // Written straight into this frame's ring segment, no buffer (re)allocation.
+    GPUAllocation instances = m_FrameAllocator->Allocate(m_Queue.Size() * sizeof(glm::mat4), sizeof(glm::mat4));
+    if (instances)
+    {
+        glm::mat4* instanceData = reinterpret_cast<glm::mat4*>(instances.data);
+        for (size_t i = 0; i < m_Queue.Size(); i++)
+            instanceData[i] = m_Coordinator->GetComponent<MeshComponent>(m_Queue[i].entity)->worldTransform;
+        m_FrameAllocator->Commit(instances);
+    }
+    
+    // 4. Material records for the pass, one allocation
+    GPUAllocation materials;
+    if (useMaterials && !m_Materials.empty())
+    {
+        materials = m_FrameAllocator->Allocate(m_Materials.size() * m_MaterialStride, m_MaterialStride);
+        for (size_t i = 0; materials && i < m_Materials.size(); i++)
         {
-           AssetHandle albedoHandle = AssetManager::Get().GetAsset(AssetType::Texture, meshComp->material.albedoID);
-           if(albedoHandle.IsReady && albedoHandle.Data)
-           {
-               TextureData* albedoTex = static_cast<TextureData*>(albedoHandle.Data);
-               glActiveTexture(GL_TEXTURE0);
-               glBindTexture(GL_TEXTURE_2D, albedoTex->TextureObject);
-               glUniform1i(glGetUniformLocation(shader.shaderProgram, "mainTexture"), 0);
-               hasAlbedo = true;
-           }
+            const Material& material = *m_Materials[i].material;
+            const unsigned int* textures = m_Materials[i].textures;
+            
+            MaterialUniforms record;
+            record.ambient = glm::vec4(material.Ambient, 1.0f);
+            record.diffuse = glm::vec4(material.Diffuse, material.Opacity);
+            record.specular = glm::vec4(material.Specular, material.Shininess);
+            record.flags = glm::ivec4(textures[0] != 0, textures[1] != 0, textures[2] != 0, 0);
+            std::memcpy(materials.data + i * m_MaterialStride, &record, sizeof(record));
         }
+        m_FrameAllocator->Commit(materials);
+    }
+    
+    // 5. Build draw commands. A command is a run of packets sharing material, mesh and LOD;
+    // a group is a run of commands sharing the material, submitted with one multi draw.
+    // Transparent packets stay one command each, in back-to-front order.
+    bool mergeInstances = pass != RenderPass::Transparent;
+    m_DrawCommands.clear();
+    m_CommandGroups.clear();
+    
+    size_t batchStart = 0;
+    while (batchStart < m_Queue.Size())
+    {
+        const DrawPacket& packet = m_Queue[batchStart];
         
-        // 2. Normal Map -> Unit 1
-        if (meshComp->material.normalID != UINT32_MAX)
+        size_t batchEnd = batchStart + 1;
+        while (mergeInstances && batchEnd < m_Queue.Size() &&
+               RenderQueue::GetMaterialBits(m_Queue[batchEnd].sortKey) == RenderQueue::GetMaterialBits(packet.sortKey) &&
+               RenderQueue::GetMeshBits(m_Queue[batchEnd].sortKey) == RenderQueue::GetMeshBits(packet.sortKey) &&
+               m_Queue[batchEnd].mesh == packet.mesh &&
+               m_Queue[batchEnd].firstIndex == packet.firstIndex &&
+               m_Queue[batchEnd].materialIndex == packet.materialIndex)
+            batchEnd++;
+        
+        DrawElementsIndirectCommand command;
+        command.count = packet.indexCount;
+        command.instanceCount = static_cast<uint32_t>(batchEnd - batchStart);
+        command.firstIndex = packet.firstIndex;
+        command.baseVertex = static_cast<int32_t>(packet.mesh->baseVertex);
+        command.baseInstance = static_cast<uint32_t>(batchStart);
+        
+        if (m_CommandGroups.empty() || m_CommandGroups.back().materialIndex != packet.materialIndex)
+            m_CommandGroups.push_back({ packet.materialIndex, static_cast<uint32_t>(m_DrawCommands.size()), 0 });
+        m_CommandGroups.back().commandCount++;
+        m_DrawCommands.push_back(command);
+        
+        m_FrameStats.instances += command.instanceCount;
+        m_FrameStats.triangles += (command.count / 3) * command.instanceCount;
+        
+        batchStart = batchEnd;
+    }
+    
+    if (m_DrawCommands.empty()) return;
+    
+    bool multiDraw = MeshPool::SupportsMultiDrawIndirect();
+    GPUAllocation commands;
+    if (multiDraw)
+    {
+        commands = m_FrameAllocator->Upload(m_DrawCommands.data(), m_DrawCommands.size() * sizeof(DrawElementsIndirectCommand));
+        multiDraw = static_cast<bool>(commands);
+    }
+    
+    // 6. Submit
+    shader.SetBool(true, U_INSTANCED);
+    if (useMaterials) {
+        // Sampler units never change, set once per pass
+        shader.SetInt(U_MAIN_TEXTURE, 0);
+        shader.SetInt(U_NORMAL_MAP, 1);
+        shader.SetInt(U_SPECULAR_MAP, 2);
+    }
+    
+    // Every mesh lives in the pool, one VAO for the whole pass
+    glBindVertexArray(MeshPool::Get().GetVAO());
+    glBindBuffer(GL_ARRAY_BUFFER, instances.buffer);
+    m_FrameStats.meshBinds++;
+    
+    if (multiDraw)
+    {
+        // Base instance offsets the instance attributes, so they are pointed at the allocation once
+        SetInstanceAttributes(instances.offset);
+        glBindBuffer(GL_DRAW_INDIRECT_BUFFER, commands.buffer);
+    }
+    
+    uint32_t boundMaterial = UINT32_MAX;
+    unsigned int boundTextures[3] = { 0, 0, 0 };
+    
+    for (const CommandGroup& group : m_CommandGroups)
+    {
+        if (useMaterials && group.materialIndex != boundMaterial)
         {
-           AssetHandle normalHandle = AssetManager::Get().GetAsset(AssetType::Texture, meshComp->material.normalID);
-           if(normalHandle.IsReady && normalHandle.Data)
-           {
-               TextureData* normalTex = static_cast<TextureData*>(normalHandle.Data);
-               glActiveTexture(GL_TEXTURE1);
-               glBindTexture(GL_TEXTURE_2D, normalTex->TextureObject);
-               glUniform1i(glGetUniformLocation(shader.shaderProgram, "normalMap"), 1);
-               hasNormal = true;
-           }
+            const MaterialBinding& binding = m_Materials[group.materialIndex];
+            glBindBufferRange(GL_UNIFORM_BUFFER, static_cast<GLuint>(UniformBinding::Material), materials.buffer,
+                              materials.offset + group.materialIndex * m_MaterialStride, sizeof(MaterialUniforms));
+            
+            // Albedo -> Unit 0, Normal -> Unit 1, Specular -> Unit 2
+            for (int unit = 0; unit < 3; unit++)
+            {
+                unsigned int texture = binding.textures[unit];
+                if (texture == 0 || texture == boundTextures[unit]) continue;
+                glActiveTexture(GL_TEXTURE0 + unit);
+                glBindTexture(GL_TEXTURE_2D, texture);
+                boundTextures[unit] = texture;
+                m_FrameStats.textureBinds++;
+            }
+            
+            boundMaterial = group.materialIndex;
+            m_FrameStats.materialBinds++;
         }
         
-        // 3. Specular Map -> Unit 2
-        if (meshComp->material.specID != UINT32_MAX)
+        if (multiDraw)
         {
-           AssetHandle specHandle = AssetManager::Get().GetAsset(AssetType::Texture, meshComp->material.specID);
-           if(specHandle.IsReady && specHandle.Data)
-           {
-               TextureData* specTex = static_cast<TextureData*>(specHandle.Data);
-               glActiveTexture(GL_TEXTURE2);
-               glBindTexture(GL_TEXTURE_2D, specTex->TextureObject);
-               glUniform1i(glGetUniformLocation(shader.shaderProgram, "specularMap"), 2);
-               hasSpec = true;
-           }
+            glMultiDrawElementsIndirect(GL_TRIANGLES, GL_UNSIGNED_INT,
+                                        (void*)(commands.offset + group.firstCommand * sizeof(DrawElementsIndirectCommand)),
+                                        group.commandCount, 0);
+            m_FrameStats.drawCalls++;
+            continue;
         }
         
-        // Set Shader Flags so GPU knows what textures do we have
-        shader.SetBool(hasSpec, "u_HasSpecularMap");
-        shader.SetBool(hasAlbedo, "u_HasTexture");
-        shader.SetBool(hasNormal, "u_HasNormalMap");
-        
-        // DRAW
-        Mesh* mesh = static_cast<Mesh*>(AssetManager::Get().GetAsset(AssetType::Mesh, meshComp->meshID).Data);
-        if (mesh && mesh->uploaded)
+        // Fallback (GL 4.1): one draw per command, instance attributes re-pointed at its range
+        for (uint32_t i = 0; i < group.commandCount; i++)
         {
-            glBindVertexArray(mesh->VAO);
-            glDrawElements(GL_TRIANGLES, mesh->indexCount, GL_UNSIGNED_INT, 0);
-            glBindVertexArray(0);
+            const DrawElementsIndirectCommand& command = m_DrawCommands[group.firstCommand + i];
+            SetInstanceAttributes(instances.offset + command.baseInstance * sizeof(glm::mat4));
+            glDrawElementsInstancedBaseVertex(GL_TRIANGLES, command.count, GL_UNSIGNED_INT,
+                                              (void*)(command.firstIndex * sizeof(uint32_t)),
+                                              command.instanceCount, command.baseVertex);
+            m_FrameStats.drawCalls++;
         }
     }
 
+    if (multiDraw) glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
     glBindVertexArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    
+    // Other users of the shader (terrain) draw with the transformMatrix uniform
+    shader.SetBool(false, U_INSTANCED);
 }
 
+// Expects the pool VAO and the instance buffer to be bound
+void RenderSystem::SetInstanceAttributes(size_t offset)
+{
+    for (int column = 0; column < 4; column++)
+        glVertexAttribPointer(INSTANCE_ATTRIB + column, 4, GL_FLOAT, GL_FALSE, sizeof(glm::mat4),
+                              (void*)(offset + column * sizeof(glm::vec4)));
+}
@@ -17,6 +17,8 @@ void ScriptSystem::Init()
 
 void ScriptSystem::Update(float deltaTime)
 {
+    m_ScriptManager->BeginTransformEdits();
+    
     for (auto const& entity : mEntities)
     {
         auto* script = m_Coordinator->GetComponent<ScriptComponent>(entity);
@@ -50,4 +52,7 @@ void ScriptSystem::Update(float deltaTime)
             }
         }
     }
+    
+    // Teleports and edits made through the fields reach physics and the bounds
+    m_ScriptManager->CommitTransformEdits();
 }
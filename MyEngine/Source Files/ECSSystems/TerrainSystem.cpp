@@ -9,13 +9,26 @@
 #include "AssetManager.h"
 #include "ECS/Coordinator.h"
 #include "Shader.h"
+#include "JobSystem.h"
+#include "Math/SIMD.h"
+#include "TerrainStreamer.h"
 #include "stb_image.h"
 
 #include "GLAD/include/glad/glad.h"
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cfloat>
+#include <filesystem>
 
-
+namespace {
+    constexpr UniformID U_TERRAIN_DISPLACED("u_TerrainDisplaced");
+    constexpr UniformID U_HEIGHT_MAP("u_HeightMap");
+    constexpr UniformID U_TERRAIN_PARAMS("u_TerrainParams");
+    constexpr UniformID U_TRANSFORM_MATRIX("transformMatrix");
+    constexpr UniformID U_MAIN_TEXTURE("mainTexture");
+}
 
 void TerrainSystem::Init(){
     
@@ -24,23 +37,155 @@ void TerrainSystem::Init(){
 void TerrainSystem::CreateTerrain(Entity entity) {
     auto* terrain = m_Coordinator->GetComponent<TerrainComponent>(entity);
     if(terrain->heightmapPath.empty()) return;
+    ReleaseTerrain(terrain);
+
+    if (terrain->streamed)
+    {
+        if (OpenStreamedTerrain(terrain)) m_TerrainEntity = entity;
+        return;
+    }
 
     int channels;
+    
+    if (m_RenderMode == TerrainRenderMode::Displaced)
+    {
+        unsigned short* data16 = AssetManager::Get().GetTextureManager().LoadRawData16(terrain->heightmapPath, terrain->width, terrain->height, channels);
+        if (!data16) return;
+        
+        terrain->heightData.resize(terrain->width * terrain->height);
+        const int width = terrain->width, height = terrain->height;
+        float* heights = terrain->heightData.data();
+        JobSystem::Get().ParallelFor((height + CHUNK_QUADS - 1) / CHUNK_QUADS, [&](int band) {
+            int begin = band * CHUNK_QUADS * width;
+            int end = std::min(begin + CHUNK_QUADS * width, width * height);
+            for (int i = begin; i < end; i++) heights[i] = data16[i] * (1.0f / 65535.0f);
+        });
+        
+        GenerateDisplaced(entity, data16);
+        stbi_image_free(data16);
+        return;
+    }
 
     unsigned char* data = AssetManager::Get().GetTextureManager().LoadRawData(terrain->heightmapPath, terrain->width, terrain->height, channels);
 
     if (data) {
         terrain->heightData.resize(terrain->width * terrain->height);
-        for (int i = 0; i < terrain->width * terrain->height; i++) {
-            terrain->heightData[i] = data[i] / 255.0f;
-        }
+        
+        // Bands of CHUNK_QUADS rows, same split as the mesh generation
+        const int width = terrain->width, height = terrain->height;
+        float* heights = terrain->heightData.data();
+        JobSystem::Get().ParallelFor((height + CHUNK_QUADS - 1) / CHUNK_QUADS, [&](int band) {
+            int begin = band * CHUNK_QUADS * width;
+            int end = std::min(begin + CHUNK_QUADS * width, width * height);
+            for (int i = begin; i < end; i++) heights[i] = data[i] * (1.0f / 255.0f);
+        });
         stbi_image_free(data);
     }
 
     GenerateMesh(entity);
 }
 
-void TerrainSystem::Render(Shader& shader){
+// GPU data of a previous build, so recreating a terrain does not leak it
+void TerrainSystem::ReleaseTerrain(TerrainComponent* terrain) {
+    if (terrain->VBO) glDeleteBuffers(1, &terrain->VBO);
+    if (terrain->VAO) glDeleteVertexArrays(1, &terrain->VAO);
+    if (terrain->heightTexture) glDeleteTextures(1, &terrain->heightTexture);
+    terrain->VAO = 0;
+    terrain->VBO = 0;
+    terrain->heightTexture = 0;
+    terrain->streamer.reset();
+    terrain->dirty = TerrainDirtyRect();
+}
+
+// STREAMING
+
+// Builds the tile pyramid next to the heightmap when it is missing or older than the heightmap
+bool TerrainSystem::OpenStreamedTerrain(TerrainComponent* terrain)
+{
+    namespace fs = std::filesystem;
+    std::string tilePath = terrain->heightmapPath + ".metile";
+    
+    std::error_code ec;
+    bool stale = !fs::exists(tilePath, ec) ||
+                 fs::last_write_time(tilePath, ec) < fs::last_write_time(terrain->heightmapPath, ec);
+    if (stale && !TerrainTileFile::Build(terrain->heightmapPath, tilePath)) return false;
+    
+    if (!m_ChunkIndexBuffer) BuildChunkIndexBuffer();
+    
+    auto streamer = std::make_shared<TerrainStreamer>();
+    if (!streamer->Open(tilePath, m_ChunkIndexBuffer)) return false;
+    
+    terrain->streamer = streamer;
+    terrain->width = streamer->GetWidth();
+    terrain->height = streamer->GetHeight();
+    terrain->heightData.clear();
+    terrain->heightData.shrink_to_fit();
+    terrain->chunks.clear();
+    terrain->quadtree.clear();
+    terrain->isInitialized = true;
+    return true;
+}
+
+void TerrainSystem::SetRenderMode(TerrainRenderMode mode){
+    if (mode == m_RenderMode) return;
+    m_RenderMode = mode;
+    for (auto const& entity : mEntities)
+        m_Coordinator->GetComponent<TerrainComponent>(entity)->isInitialized = false;
+}
+
+void TerrainSystem::Update(){
+    glm::vec3 cameraPos = m_CameraSystem ? m_CameraSystem->GetCameraPosition() : glm::vec3(0.0f);
+    
+    for (auto const& entity : mEntities) {
+        auto* terrain = m_Coordinator->GetComponent<TerrainComponent>(entity);
+        if (!terrain->isInitialized) continue;
+        
+        if (!terrain->streamer)
+        {
+            if (terrain->terrainScale != terrain->builtScale || terrain->maxHeight != terrain->builtMaxHeight)
+                terrain->dirty.Expand(0, 0, terrain->width - 1, terrain->height - 1);
+            if (!terrain->dirty.IsEmpty()) FlushEdits(terrain);
+            continue;
+        }
+        
+        // Selection runs in terrain space, the refine distance matches SelectLOD's LOD 0 distance
+        glm::mat4 model = GetWorldMatrix(m_Coordinator->GetComponent<TransformComponent>(entity));
+        glm::vec3 cameraLocal = glm::vec3(glm::inverse(model) * glm::vec4(cameraPos, 1.0f));
+        float refineDistance = CHUNK_QUADS * terrain->terrainScale * LOD_DISTANCE;
+        
+        terrain->streamer->Update(*terrain, cameraLocal, refineDistance);
+    }
+}
+
+// Every resident tile is a chunk sized mesh at its level's resolution, so all use LOD 0 indices
+void TerrainSystem::RenderStreamed(const TerrainComponent* terrain, const glm::mat4& model)
+{
+    m_DrawCounts[0].clear();
+    m_DrawOffsets[0].clear();
+    m_DrawBaseVertices[0].clear();
+    
+    for (const TerrainStreamer::DrawTile& tile : terrain->streamer->GetDrawList())
+    {
+        if (!m_Frustum.IntersectsAABB(tile.bounds.Transformed(model))) continue;
+        m_DrawCounts[0].push_back(m_LODRanges[0].count);
+        m_DrawOffsets[0].push_back((const void*)(m_LODRanges[0].first * sizeof(GLushort)));
+        m_DrawBaseVertices[0].push_back(tile.baseVertex);
+    }
+    if (m_DrawCounts[0].empty()) return;
+    
+    glBindVertexArray(terrain->streamer->GetVAO());
+    glMultiDrawElementsBaseVertex(GL_TRIANGLES, m_DrawCounts[0].data(), GL_UNSIGNED_SHORT,
+                                  m_DrawOffsets[0].data(), (GLsizei)m_DrawCounts[0].size(),
+                                  m_DrawBaseVertices[0].data());
+    glBindVertexArray(0);
+}
+
+void TerrainSystem::Render(Shader& shader, const glm::mat4& cullMatrix){
+    
+    if (!m_ChunkIndexBuffer) BuildChunkIndexBuffer();
+    
+    glm::vec3 cameraPos = m_CameraSystem ? m_CameraSystem->GetCameraPosition() : glm::vec3(0.0f);
+    m_Frustum.Extract(cullMatrix);
 
     for (auto const& entity : mEntities) {
         auto* terrain = m_Coordinator->GetComponent<TerrainComponent>(entity);
@@ -51,10 +196,59 @@ void TerrainSystem::Render(Shader& shader){
             if(terrain->heightmapPath.empty()) continue;
             CreateTerrain(entity);
         }
+        bool streamed = terrain->streamer != nullptr;
+        bool displaced = !streamed && m_RenderMode == TerrainRenderMode::Displaced;
+        if(!streamed && terrain->quadtree.empty()) continue;
         
 
         glm::mat4 model = GetWorldMatrix(transform);
-        shader.SetMatrix4(model, "transformMatrix");
+        
+        // 1. Visible chunks, grouped by LOD
+        for (int lod = 0; lod < LOD_COUNT; lod++) {
+            m_DrawCounts[lod].clear();
+            m_DrawOffsets[lod].clear();
+            m_DrawBaseVertices[lod].clear();
+            m_DrawChunks[lod].clear();
+        }
+        
+        float chunkWorldSize = CHUNK_QUADS * terrain->terrainScale * std::max(transform->scale.x, transform->scale.z);
+        
+        // Stack entries are node indices, negated (minus one) when the node is known to be fully inside
+        m_NodeStack.clear();
+        if (!streamed) m_NodeStack.push_back(0);
+        while (!m_NodeStack.empty())
+        {
+            int32_t entry = m_NodeStack.back();
+            m_NodeStack.pop_back();
+            bool inside = entry < 0;
+            const TerrainQuadNode& node = terrain->quadtree[inside ? -entry - 1 : entry];
+            
+            AABB worldBounds = node.bounds.Transformed(model);
+            if (!inside)
+            {
+                Frustum::TestResult result = m_Frustum.ClassifyAABB(worldBounds);
+                if (result == Frustum::TestResult::Outside) continue;
+                inside = result == Frustum::TestResult::Inside;
+            }
+            
+            if (node.chunk >= 0)
+            {
+                int lod = SelectLOD(worldBounds, chunkWorldSize, cameraPos);
+                if (displaced) {
+                    m_DrawChunks[lod].push_back(node.chunk);
+                    continue;
+                }
+                m_DrawCounts[lod].push_back(m_LODRanges[lod].count);
+                m_DrawOffsets[lod].push_back((const void*)(m_LODRanges[lod].first * sizeof(GLushort)));
+                m_DrawBaseVertices[lod].push_back(terrain->chunks[node.chunk].baseVertex);
+                continue;
+            }
+            
+            for (int32_t child : node.children)
+                if (child >= 0) m_NodeStack.push_back(inside ? -child - 1 : child);
+        }
+        
+        shader.SetMatrix4(model, U_TRANSFORM_MATRIX);
 
 
 
@@ -67,76 +261,296 @@ void TerrainSystem::Render(Shader& shader){
                TextureData* albedoTex = static_cast<TextureData*>(albedoHandle.Data);
                glActiveTexture(GL_TEXTURE0);
                glBindTexture(GL_TEXTURE_2D, albedoTex->TextureObject);
-               glUniform1i(glGetUniformLocation(shader.shaderProgram, "mainTexture"), 0);
+               shader.SetInt(U_MAIN_TEXTURE, 0);
                hasAlbedo = true;
            }
         }
         
-        shader.SetBool(hasAlbedo, "u_HasTexture");
-        shader.SetBool(false, "u_HasNormalMap");
+        // Default material, only the albedo flag varies
+        Material defaultMaterial;
+        MaterialUniforms material;
+        material.ambient = glm::vec4(defaultMaterial.Ambient, 1.0f);
+        material.diffuse = glm::vec4(defaultMaterial.Diffuse, defaultMaterial.Opacity);
+        material.specular = glm::vec4(defaultMaterial.Specular, defaultMaterial.Shininess);
+        material.flags = glm::ivec4(hasAlbedo, 0, 0, 0);
+        
+        if (!m_MaterialBuffer.IsValid()) m_MaterialBuffer.Create(sizeof(MaterialUniforms), UniformBinding::Material);
+        if (m_UploadedAlbedoFlag != (int)hasAlbedo) {
+            m_MaterialBuffer.Upload(&material, sizeof(MaterialUniforms));
+            m_UploadedAlbedoFlag = hasAlbedo;
+        }
+        m_MaterialBuffer.Bind();
         
         
+        // Skirts face outwards and down, draw both sides
         glDisable(GL_CULL_FACE);
         
+        if (streamed || displaced)
+        {
+            if (streamed) RenderStreamed(terrain, model);
+            else RenderDisplaced(shader, terrain);
+            glEnable(GL_CULL_FACE);
+            continue;
+        }
+        
+        // 2. One multi draw per LOD, every chunk reads the same index range
         glBindVertexArray(terrain->VAO);
-        glDrawElements(GL_TRIANGLE_STRIP, terrain->indexCount, GL_UNSIGNED_INT, 0);
+        for (int lod = 0; lod < LOD_COUNT; lod++)
+        {
+            if (m_DrawCounts[lod].empty()) continue;
+            glMultiDrawElementsBaseVertex(GL_TRIANGLES, m_DrawCounts[lod].data(), GL_UNSIGNED_SHORT,
+                                          m_DrawOffsets[lod].data(), (GLsizei)m_DrawCounts[lod].size(),
+                                          m_DrawBaseVertices[lod].data());
+        }
         
         glBindVertexArray(0);
         glEnable(GL_CULL_FACE);
     }
 }
 
-void TerrainSystem::GenerateMesh(Entity entity) {
-    auto* terrain = m_Coordinator->GetComponent<TerrainComponent>(entity);
-    std::vector<Vertex> vertices;
-    std::vector<unsigned int> indices;
+int TerrainSystem::SelectLOD(const AABB& worldBounds, float chunkWorldSize, const glm::vec3& cameraPos) const
+{
+    float distance = std::sqrt(worldBounds.DistanceSq(cameraPos));
+    float threshold = chunkWorldSize * LOD_DISTANCE;
+    
+    int lod = 0;
+    while (lod + 1 < LOD_COUNT && distance > threshold)
+    {
+        lod++;
+        threshold *= 2.0f;
+    }
+    return lod;
+}
 
-    // 1. Vertices + Normals
-    for (int z = 0; z < terrain->height; z++) {
-        for (int x = 0; x < terrain->width; x++) {
-            float y = terrain->heightData[z * terrain->width + x] * terrain->maxHeight;
-            
-            Vertex v;
+// CHUNK INDICES
+// Built once, shared by every chunk of every terrain. Vertex layout of a chunk:
+// grid vertex (x, z) at z * CHUNK_VERTS + x, then the 4 skirts of CHUNK_VERTS vertices each
+// (z = 0 edge, z = max edge, x = 0 edge, x = max edge).
+
+void TerrainSystem::BuildChunkIndexBuffer()
+{
+    std::vector<GLushort> indices;
     
-            v.position = glm::vec3(x * terrain->terrainScale, y, z * terrain->terrainScale);
-            v.uv = glm::vec2((float)x / (terrain->width - 1), (float)z / (terrain->height - 1));
-            
-            float hL = (x > 0) ? terrain->heightData[z * terrain->width + (x - 1)] : y;
-            float hR = (x < terrain->width - 1) ? terrain->heightData[z * terrain->width + (x + 1)] : y;
-            float hD = (z > 0) ? terrain->heightData[(z - 1) * terrain->width + x] : y;
-            float hU = (z < terrain->height - 1) ? terrain->heightData[(z + 1) * terrain->width + x] : y;
+    auto gridIndex = [](int x, int z) { return (GLushort)(z * CHUNK_VERTS + x); };
+    auto skirtIndex = [](int edge, int i) { return (GLushort)(CHUNK_GRID_VERTICES + edge * CHUNK_VERTS + i); };
+    
+    for (int lod = 0; lod < LOD_COUNT; lod++)
+    {
+        int step = 1 << lod;
+        m_LODRanges[lod].first = (GLsizei)indices.size();
+        
+        for (int z = 0; z < CHUNK_QUADS; z += step)
+        {
+            for (int x = 0; x < CHUNK_QUADS; x += step)
+            {
+                GLushort a = gridIndex(x, z), b = gridIndex(x + step, z);
+                GLushort c = gridIndex(x, z + step), d = gridIndex(x + step, z + step);
+                indices.insert(indices.end(), { a, c, b, b, c, d });
+            }
+        }
+        
+        // Skirts: a strip of quads from each border edge down to its skirt vertices
+        for (int edge = 0; edge < 4; edge++)
+        {
+            for (int i = 0; i < CHUNK_QUADS; i += step)
+            {
+                GLushort g0, g1;
+                switch (edge) {
+                    case 0:  g0 = gridIndex(i, 0);           g1 = gridIndex(i + step, 0); break;
+                    case 1:  g0 = gridIndex(i, CHUNK_QUADS); g1 = gridIndex(i + step, CHUNK_QUADS); break;
+                    case 2:  g0 = gridIndex(0, i);           g1 = gridIndex(0, i + step); break;
+                    default: g0 = gridIndex(CHUNK_QUADS, i); g1 = gridIndex(CHUNK_QUADS, i + step); break;
+                }
+                GLushort k0 = skirtIndex(edge, i), k1 = skirtIndex(edge, i + step);
+                indices.insert(indices.end(), { g0, k0, g1, g1, k0, k1 });
+            }
+        }
+        
+        m_LODRanges[lod].count = (GLsizei)indices.size() - m_LODRanges[lod].first;
+    }
+    
+    glGenBuffers(1, &m_ChunkIndexBuffer);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_ChunkIndexBuffer);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(GLushort), indices.data(), GL_STATIC_DRAW);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+}
 
-            v.normal = glm::normalize(glm::vec3(hL - hR, 2.0f, hD - hU));
+// NORMALS
+// Central differences on the scaled heights, n = ((hL - hR) * maxHeight, 2 * terrainScale, (hD - hU) * maxHeight).
+// Neighbours outside the map fall back to the centre height. Four grid points per step where
+// all of them and their left/right neighbours are inside the row, scalar otherwise.
+
+void TerrainSystem::ComputeNormalRow(const TerrainComponent* terrain, int gx0, int gz, int count, glm::vec3* outNormals) const
+{
+    const int width = terrain->width;
+    const float* row = terrain->heightData.data() + gz * width;
+    const float* rowDown = gz > 0 ? row - width : row;
+    const float* rowUp = gz < terrain->height - 1 ? row + width : row;
+    const float heightScale = terrain->maxHeight;
+    const float up = 2.0f * terrain->terrainScale;
+    
+    const simd::float4 heightScale4 = simd::Set1(heightScale);
+    const simd::float4 up4 = simd::Set1(up);
+    const simd::float4 upSq4 = simd::Set1(up * up);
+    const simd::float4 one4 = simd::Set1(1.0f);
+    
+    int x = 0;
+    while (x < count)
+    {
+        int gx = gx0 + x;
+        if (x + simd::WIDTH <= count && gx >= 1 && gx + simd::WIDTH < width)
+        {
+            simd::float4 dx = simd::Mul(simd::Sub(simd::Load(row + gx - 1), simd::Load(row + gx + 1)), heightScale4);
+            simd::float4 dz = simd::Mul(simd::Sub(simd::Load(rowDown + gx), simd::Load(rowUp + gx)), heightScale4);
+            simd::float4 lengthSq = simd::MulAdd(dx, dx, simd::MulAdd(dz, dz, upSq4));
+            simd::float4 invLength = simd::Div(one4, simd::Sqrt(lengthSq));
             
-            vertices.push_back(v);
+            float nx[simd::WIDTH], ny[simd::WIDTH], nz[simd::WIDTH];
+            simd::Store(nx, simd::Mul(dx, invLength));
+            simd::Store(ny, simd::Mul(up4, invLength));
+            simd::Store(nz, simd::Mul(dz, invLength));
+            for (int k = 0; k < simd::WIDTH; k++) outNormals[x + k] = glm::vec3(nx[k], ny[k], nz[k]);
+            x += simd::WIDTH;
+            continue;
         }
+        
+        // Map border, or past it for chunks hanging over the edge (clamped like their positions)
+        int cx = std::min(gx, width - 1);
+        float y = row[cx];
+        float hL = cx > 0 ? row[cx - 1] : y;
+        float hR = cx < width - 1 ? row[cx + 1] : y;
+        outNormals[x] = glm::normalize(glm::vec3((hL - hR) * heightScale, up, (rowDown[cx] - rowUp[cx]) * heightScale));
+        x++;
     }
+}
+
+// CHUNK VERTICES
+// Shared by the full build and by edits, which rebuild only the rows they touched
+
+namespace {
+    Vertex MakeTerrainVertex(const TerrainComponent* terrain, int gx, int gz, const glm::vec3& normal)
+    {
+        gx = std::min(gx, terrain->width - 1);
+        gz = std::min(gz, terrain->height - 1);
+        
+        Vertex v;
+        v.position = glm::vec3(gx * terrain->terrainScale, terrain->heightData[gz * terrain->width + gx] * terrain->maxHeight, gz * terrain->terrainScale);
+        v.normal = normal;
+        v.uv = glm::vec2((float)gx / (terrain->width - 1), (float)gz / (terrain->height - 1));
+        v.tangent = glm::vec3(0.0f);
+        return v;
+    }
+}
 
-    // 2. Indices logic
-    for (int z = 0; z < terrain->height - 1; z++) {
-        for (int x = 0; x < terrain->width; x++) {
-            indices.push_back(z * terrain->width + x);
-            indices.push_back((z + 1) * terrain->width + x);
+// Bounds from the heights alone. Skirts hang below the lowest point of the chunk by its height
+// range, deep enough to cover the gap to any coarser neighbour.
+void TerrainSystem::ComputeChunkBounds(TerrainComponent* terrain, int cx, int cz) const
+{
+    TerrainChunk& chunk = terrain->chunks[cz * terrain->chunksX + cx];
+    int x0 = cx * CHUNK_QUADS, x1 = std::min(x0 + CHUNK_QUADS, terrain->width - 1);
+    int z0 = cz * CHUNK_QUADS, z1 = std::min(z0 + CHUNK_QUADS, terrain->height - 1);
+    
+    float minY = FLT_MAX, maxY = -FLT_MAX;
+    for (int z = z0; z <= z1; z++) {
+        const float* row = terrain->heightData.data() + z * terrain->width;
+        for (int x = x0; x <= x1; x++) {
+            minY = std::min(minY, row[x]);
+            maxY = std::max(maxY, row[x]);
         }
-        if (z < terrain->height - 2) {
-            indices.push_back((z + 1) * terrain->width + (terrain->width - 1));
-            indices.push_back((z + 1) * terrain->width);
+    }
+    minY *= terrain->maxHeight;
+    maxY *= terrain->maxHeight;
+    
+    chunk.skirtDepth = (maxY - minY) + terrain->terrainScale;
+    chunk.bounds.min = glm::vec3(x0 * terrain->terrainScale, minY - chunk.skirtDepth, z0 * terrain->terrainScale);
+    chunk.bounds.max = glm::vec3(x1 * terrain->terrainScale, maxY, z1 * terrain->terrainScale);
+}
+
+// Grid rows z0 .. z1 (inclusive, chunk local) into out, row z0 first
+void TerrainSystem::FillChunkRows(const TerrainComponent* terrain, int cx, int cz, int z0, int z1, Vertex* out) const
+{
+    glm::vec3 normals[CHUNK_VERTS];
+    for (int z = z0; z <= z1; z++) {
+        int gz = std::min(cz * CHUNK_QUADS + z, terrain->height - 1);
+        ComputeNormalRow(terrain, cx * CHUNK_QUADS, gz, CHUNK_VERTS, normals);
+        
+        Vertex* row = out + (z - z0) * CHUNK_VERTS;
+        for (int x = 0; x < CHUNK_VERTS; x++)
+            row[x] = MakeTerrainVertex(terrain, cx * CHUNK_QUADS + x, gz, normals[x]);
+    }
+}
+
+// The 4 skirts (4 * CHUNK_VERTS vertices), border vertices pushed down by skirtDepth
+void TerrainSystem::FillChunkSkirts(const TerrainComponent* terrain, int cx, int cz, float skirtDepth, Vertex* out) const
+{
+    for (int edge = 0; edge < 4; edge++) {
+        for (int i = 0; i < CHUNK_VERTS; i++) {
+            int x = edge == 2 ? 0 : edge == 3 ? CHUNK_QUADS : i;
+            int z = edge == 0 ? 0 : edge == 1 ? CHUNK_QUADS : i;
+            int gx = cx * CHUNK_QUADS + x;
+            int gz = std::min(cz * CHUNK_QUADS + z, terrain->height - 1);
+            
+            glm::vec3 normal;
+            ComputeNormalRow(terrain, gx, gz, 1, &normal);
+            Vertex& skirt = out[edge * CHUNK_VERTS + i];
+            skirt = MakeTerrainVertex(terrain, gx, gz, normal);
+            skirt.position.y -= skirtDepth;
         }
     }
-    terrain->indexCount = (unsigned int)indices.size();
+}
+
+size_t TerrainSystem::BuildMesh(TerrainComponent* terrain, std::unique_ptr<Vertex[]>& outVertices) {
+    terrain->chunksX = (terrain->width - 2) / CHUNK_QUADS + 1;
+    terrain->chunksZ = (terrain->height - 2) / CHUNK_QUADS + 1;
+    int chunkCount = terrain->chunksX * terrain->chunksZ;
+    
+    // Every vertex is written below, so the buffer is left uninitialized
+    size_t vertexCount = (size_t)chunkCount * CHUNK_VERTEX_COUNT;
+    outVertices.reset(new Vertex[vertexCount]);
+    Vertex* vertices = outVertices.get();
+    terrain->chunks.assign(chunkCount, TerrainChunk());
+
+    // 1. Vertices + Normals, one job per row of chunks (bands write disjoint vertex ranges).
+    // Chunks hanging over the map edge repeat the last row/column, which only produces
+    // degenerate triangles.
+    JobSystem::Get().ParallelFor(terrain->chunksZ, [&](int cz) {
+        for (int cx = 0; cx < terrain->chunksX; cx++) {
+            int chunkIndex = cz * terrain->chunksX + cx;
+            TerrainChunk& chunk = terrain->chunks[chunkIndex];
+            chunk.baseVertex = chunkIndex * CHUNK_VERTEX_COUNT;
+            Vertex* chunkVertices = vertices + chunk.baseVertex;
+            
+            ComputeChunkBounds(terrain, cx, cz);
+            FillChunkRows(terrain, cx, cz, 0, CHUNK_QUADS, chunkVertices);
+            FillChunkSkirts(terrain, cx, cz, chunk.skirtDepth, chunkVertices + CHUNK_GRID_VERTICES);
+        }
+    });
 
-    // 3. OpenGL Buffer Setup
+    // 2. Quadtree over the chunk grid
+    terrain->quadtree.clear();
+    BuildQuadtree(terrain, 0, 0, terrain->chunksX, terrain->chunksZ);
+    return vertexCount;
+}
+
+void TerrainSystem::GenerateMesh(Entity entity) {
+    auto* terrain = m_Coordinator->GetComponent<TerrainComponent>(entity);
+    if (terrain->width < 2 || terrain->height < 2) return;
+    
+    std::unique_ptr<Vertex[]> vertices;
+    size_t vertexCount = BuildMesh(terrain, vertices);
+
+    // 3. OpenGL Buffer Setup (indices come from the shared chunk index buffer)
+    if (!m_ChunkIndexBuffer) BuildChunkIndexBuffer();
+    
     glGenVertexArrays(1, &terrain->VAO);
     glGenBuffers(1, &terrain->VBO);
-    glGenBuffers(1, &terrain->EBO);
 
     glBindVertexArray(terrain->VAO);
 
     glBindBuffer(GL_ARRAY_BUFFER, terrain->VBO);
-    glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(Vertex), vertices.data(), GL_STATIC_DRAW);
+    glBufferData(GL_ARRAY_BUFFER, vertexCount * sizeof(Vertex), vertices.get(), GL_DYNAMIC_DRAW);   // Patched by edits
 
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, terrain->EBO);
-    glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(unsigned int), indices.data(), GL_STATIC_DRAW);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_ChunkIndexBuffer);
 
     // Position
     glEnableVertexAttribArray(0);
@@ -149,17 +563,347 @@ void TerrainSystem::GenerateMesh(Entity entity) {
     glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, uv));
 
     glBindVertexArray(0);
+    terrain->builtScale = terrain->terrainScale;
+    terrain->builtMaxHeight = terrain->maxHeight;
+    terrain->dirty = TerrainDirtyRect();
     terrain->isInitialized = true;
     m_TerrainEntity = entity;
+}
+
+// DISPLACED TERRAIN
 
+// Chunk bounds from the heightmap, the quadtree and the height texture. No vertices.
+void TerrainSystem::GenerateDisplaced(Entity entity, const uint16_t* heights) {
+    auto* terrain = m_Coordinator->GetComponent<TerrainComponent>(entity);
+    if (terrain->width < 2 || terrain->height < 2) return;
+    
+    terrain->chunksX = (terrain->width - 2) / CHUNK_QUADS + 1;
+    terrain->chunksZ = (terrain->height - 2) / CHUNK_QUADS + 1;
+    terrain->chunks.assign(terrain->chunksX * terrain->chunksZ, TerrainChunk());
+    
+    // 1. Bounds, same as the baked vertices would give (one job per row of chunks)
+    JobSystem::Get().ParallelFor(terrain->chunksZ, [&](int cz) {
+        for (int cx = 0; cx < terrain->chunksX; cx++) ComputeChunkBounds(terrain, cx, cz);
+    });
+    
+    // 2. Quadtree over the chunk grid
+    terrain->quadtree.clear();
+    BuildQuadtree(terrain, 0, 0, terrain->chunksX, terrain->chunksZ);
+    
+    // 3. Height texture, fetched per texel (no filtering)
+    glGenTextures(1, &terrain->heightTexture);
+    glBindTexture(GL_TEXTURE_2D, terrain->heightTexture);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 2);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_R16, terrain->width, terrain->height, 0, GL_RED, GL_UNSIGNED_SHORT, heights);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glBindTexture(GL_TEXTURE_2D, 0);
+    
+    if (!m_ChunkIndexBuffer) BuildChunkIndexBuffer();
+    if (!m_PatchVAO) BuildPatch();
+    
+    terrain->builtScale = terrain->terrainScale;
+    terrain->builtMaxHeight = terrain->maxHeight;
+    terrain->dirty = TerrainDirtyRect();
+    terrain->isInitialized = true;
+    m_TerrainEntity = entity;
 }
 
-float TerrainSystem::GetHeightAt(Entity entity, float worldX, float worldZ) {
+// Shared by every displaced terrain, indexed with the chunk index buffer
+void TerrainSystem::BuildPatch() {
+    std::vector<glm::vec3> patch(CHUNK_VERTEX_COUNT);
+    for (int z = 0; z < CHUNK_VERTS; z++)
+        for (int x = 0; x < CHUNK_VERTS; x++)
+            patch[z * CHUNK_VERTS + x] = glm::vec3((float)x, 0.0f, (float)z);
+    
+    for (int edge = 0; edge < 4; edge++) {
+        for (int i = 0; i < CHUNK_VERTS; i++) {
+            int x = edge == 2 ? 0 : edge == 3 ? CHUNK_QUADS : i;
+            int z = edge == 0 ? 0 : edge == 1 ? CHUNK_QUADS : i;
+            patch[CHUNK_GRID_VERTICES + edge * CHUNK_VERTS + i] = glm::vec3((float)x, -1.0f, (float)z);
+        }
+    }
+    
+    glGenVertexArrays(1, &m_PatchVAO);
+    glGenBuffers(1, &m_PatchVBO);
+    
+    glBindVertexArray(m_PatchVAO);
+    glBindBuffer(GL_ARRAY_BUFFER, m_PatchVBO);
+    glBufferData(GL_ARRAY_BUFFER, patch.size() * sizeof(glm::vec3), patch.data(), GL_STATIC_DRAW);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_ChunkIndexBuffer);
+    
+    // Position (grid point + skirt flag)
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(glm::vec3), (void*)0);
+    // Per chunk instance, pointed at the frame's instance range before each draw
+    glEnableVertexAttribArray(PATCH_INSTANCE_ATTRIBUTE);
+    glVertexAttribDivisor(PATCH_INSTANCE_ATTRIBUTE, 1);
+    
+    glBindVertexArray(0);
+}
+
+// One instanced draw per LOD, the visible chunks of a LOD are a contiguous instance range
+void TerrainSystem::RenderDisplaced(Shader& shader, const TerrainComponent* terrain) {
+    size_t instanceCount = 0;
+    for (int lod = 0; lod < LOD_COUNT; lod++) instanceCount += m_DrawChunks[lod].size();
+    if (instanceCount == 0 || !m_FrameAllocator) return;
+    
+    GPUAllocation instances = m_FrameAllocator->Allocate(instanceCount * sizeof(glm::vec4), sizeof(glm::vec4));
+    if (!instances) return;
+    
+    size_t lodFirst[LOD_COUNT];
+    glm::vec4* instanceData = reinterpret_cast<glm::vec4*>(instances.data);
+    size_t written = 0;
+    for (int lod = 0; lod < LOD_COUNT; lod++) {
+        lodFirst[lod] = written;
+        for (int32_t chunk : m_DrawChunks[lod]) {
+            instanceData[written++] = glm::vec4((float)((chunk % terrain->chunksX) * CHUNK_QUADS),
+                                                (float)((chunk / terrain->chunksX) * CHUNK_QUADS),
+                                                terrain->chunks[chunk].skirtDepth, 0.0f);
+        }
+    }
+    m_FrameAllocator->Commit(instances);
+    
+    glActiveTexture(GL_TEXTURE0 + HEIGHT_MAP_UNIT);
+    glBindTexture(GL_TEXTURE_2D, terrain->heightTexture);
+    shader.SetInt(U_HEIGHT_MAP, HEIGHT_MAP_UNIT);
+    shader.SetVec4(U_TERRAIN_PARAMS, glm::vec4(terrain->terrainScale, terrain->maxHeight, 0.0f, 0.0f));
+    shader.SetBool(true, U_TERRAIN_DISPLACED);
+    
+    glBindVertexArray(m_PatchVAO);
+    glBindBuffer(GL_ARRAY_BUFFER, instances.buffer);
+    for (int lod = 0; lod < LOD_COUNT; lod++) {
+        if (m_DrawChunks[lod].empty()) continue;
+        glVertexAttribPointer(PATCH_INSTANCE_ATTRIBUTE, 4, GL_FLOAT, GL_FALSE, sizeof(glm::vec4),
+                              (void*)(instances.offset + lodFirst[lod] * sizeof(glm::vec4)));
+        glDrawElementsInstanced(GL_TRIANGLES, m_LODRanges[lod].count, GL_UNSIGNED_SHORT,
+                                (const void*)(m_LODRanges[lod].first * sizeof(GLushort)),
+                                (GLsizei)m_DrawChunks[lod].size());
+    }
+    glBindVertexArray(0);
+    
+    shader.SetBool(false, U_TERRAIN_DISPLACED);
+}
+
+// EDITING
+
+void TerrainSystem::ApplyBrush(Entity entity, const glm::vec3& worldPosition, const TerrainBrush& brush, float deltaTime) {
     auto* terrain = m_Coordinator->GetComponent<TerrainComponent>(entity);
     auto* transform = m_Coordinator->GetComponent<TransformComponent>(entity);
+    if (!terrain || !transform || terrain->streamer || terrain->heightData.empty()) return;
+    
+    // Same mapping as GetHeightAt: translation and scale, no rotation
+    float texelX = terrain->terrainScale * transform->scale.x;
+    float texelZ = terrain->terrainScale * transform->scale.z;
+    float centerX = (worldPosition.x - transform->position.x) / texelX;
+    float centerZ = (worldPosition.z - transform->position.z) / texelZ;
+    float radiusX = brush.radius / texelX;
+    float radiusZ = brush.radius / texelZ;
+    if (radiusX <= 0.0f || radiusZ <= 0.0f) return;
+    
+    const int width = terrain->width, height = terrain->height;
+    int x0 = std::max(0, (int)std::floor(centerX - radiusX)), x1 = std::min(width - 1, (int)std::ceil(centerX + radiusX));
+    int z0 = std::max(0, (int)std::floor(centerZ - radiusZ)), z1 = std::min(height - 1, (int)std::ceil(centerZ + radiusZ));
+    if (x0 > x1 || z0 > z1) return;
     
-    if (!terrain || terrain->heightData.empty()) return 0.0f;
+    // Smooth averages the heights from before this stroke, rectangle + 1 texel border
+    int sx0 = std::max(0, x0 - 1), sx1 = std::min(width - 1, x1 + 1);
+    int sz0 = std::max(0, z0 - 1), sz1 = std::min(height - 1, z1 + 1);
+    int sourceWidth = sx1 - sx0 + 1;
+    if (brush.mode == TerrainBrushMode::Smooth) {
+        m_BrushSource.resize((size_t)sourceWidth * (sz1 - sz0 + 1));
+        for (int z = sz0; z <= sz1; z++)
+            std::copy_n(terrain->heightData.data() + z * width + sx0, sourceWidth, m_BrushSource.data() + (z - sz0) * sourceWidth);
+    }
+    auto source = [&](int x, int z) {
+        x = std::clamp(x, sx0, sx1);
+        z = std::clamp(z, sz0, sz1);
+        return m_BrushSource[(z - sz0) * sourceWidth + (x - sx0)];
+    };
     
+    float amount = brush.strength * deltaTime;
+    for (int z = z0; z <= z1; z++) {
+        for (int x = x0; x <= x1; x++) {
+            float dx = (x - centerX) / radiusX, dz = (z - centerZ) / radiusZ;
+            float distanceSq = dx * dx + dz * dz;
+            if (distanceSq >= 1.0f) continue;
+            
+            float weight = amount * (1.0f - distanceSq) * (1.0f - distanceSq);   // Smooth falloff to the rim
+            float& h = terrain->heightData[z * width + x];
+            switch (brush.mode) {
+                case TerrainBrushMode::Raise:   h += weight; break;
+                case TerrainBrushMode::Lower:   h -= weight; break;
+                case TerrainBrushMode::Flatten: h += (brush.targetHeight - h) * std::min(weight, 1.0f); break;
+                case TerrainBrushMode::Smooth: {
+                    float average = 0.0f;
+                    for (int j = -1; j <= 1; j++)
+                        for (int i = -1; i <= 1; i++) average += source(x + i, z + j);
+                    h += (average / 9.0f - h) * std::min(weight, 1.0f);
+                    break;
+                }
+            }
+            h = std::clamp(h, 0.0f, 1.0f);
+        }
+    }
+    
+    terrain->dirty.Expand(x0, z0, x1, z1);
+}
+
+void TerrainSystem::MarkDirty(Entity entity, int minX, int minZ, int maxX, int maxZ) {
+    auto* terrain = m_Coordinator->GetComponent<TerrainComponent>(entity);
+    if (!terrain || terrain->streamer || terrain->heightData.empty()) return;
+    
+    minX = std::max(minX, 0);
+    minZ = std::max(minZ, 0);
+    maxX = std::min(maxX, terrain->width - 1);
+    maxZ = std::min(maxZ, terrain->height - 1);
+    if (minX <= maxX && minZ <= maxZ) terrain->dirty.Expand(minX, minZ, maxX, maxZ);
+}
+
+// Rebuilds what the dirty rectangle touches: the rows of every chunk containing a dirty texel
+// (plus one texel around it, whose normals changed) and those chunks' skirts and bounds.
+void TerrainSystem::FlushEdits(TerrainComponent* terrain) {
+    const int width = terrain->width, height = terrain->height;
+    int minX = std::max(0, terrain->dirty.minX - 1), maxX = std::min(width - 1, terrain->dirty.maxX + 1);
+    int minZ = std::max(0, terrain->dirty.minZ - 1), maxZ = std::min(height - 1, terrain->dirty.maxZ + 1);
+    terrain->dirty = TerrainDirtyRect();
+    terrain->builtScale = terrain->terrainScale;
+    terrain->builtMaxHeight = terrain->maxHeight;
+    
+    // Neighbouring chunks share their border row/column, so a texel can be in up to 4 chunks
+    int cx0 = std::max(0, (minX - 1) / CHUNK_QUADS), cx1 = std::min(terrain->chunksX - 1, maxX / CHUNK_QUADS);
+    int cz0 = std::max(0, (minZ - 1) / CHUNK_QUADS), cz1 = std::min(terrain->chunksZ - 1, maxZ / CHUNK_QUADS);
+    
+    bool displaced = terrain->heightTexture != 0;
+    if (displaced)
+    {
+        // Only the texel rectangle, the vertex shaders pick the rest up
+        int rectWidth = maxX - minX + 1, rectHeight = maxZ - minZ + 1;
+        m_EditTexels.resize((size_t)rectWidth * rectHeight);
+        for (int z = 0; z < rectHeight; z++) {
+            const float* row = terrain->heightData.data() + (minZ + z) * width + minX;
+            for (int x = 0; x < rectWidth; x++)
+                m_EditTexels[z * rectWidth + x] = (uint16_t)(std::clamp(row[x], 0.0f, 1.0f) * 65535.0f + 0.5f);
+        }
+        
+        glBindTexture(GL_TEXTURE_2D, terrain->heightTexture);
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 2);
+        glTexSubImage2D(GL_TEXTURE_2D, 0, minX, minZ, rectWidth, rectHeight, GL_RED, GL_UNSIGNED_SHORT, m_EditTexels.data());
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+        glBindTexture(GL_TEXTURE_2D, 0);
+    }
+    else
+    {
+        glBindBuffer(GL_ARRAY_BUFFER, terrain->VBO);
+        m_EditVertices.resize(CHUNK_VERTEX_COUNT);
+    }
+    
+    for (int cz = cz0; cz <= cz1; cz++) {
+        for (int cx = cx0; cx <= cx1; cx++) {
+            ComputeChunkBounds(terrain, cx, cz);
+            if (displaced) continue;
+            
+            const TerrainChunk& chunk = terrain->chunks[cz * terrain->chunksX + cx];
+            
+            // Rows past the map edge repeat the last one
+            int z0 = std::max(0, minZ - cz * CHUNK_QUADS);
+            int z1 = maxZ == height - 1 ? CHUNK_QUADS : std::min(CHUNK_QUADS, maxZ - cz * CHUNK_QUADS);
+            FillChunkRows(terrain, cx, cz, z0, z1, m_EditVertices.data());
+            glBufferSubData(GL_ARRAY_BUFFER, (GLintptr)(chunk.baseVertex + z0 * CHUNK_VERTS) * sizeof(Vertex),
+                            (GLsizeiptr)(z1 - z0 + 1) * CHUNK_VERTS * sizeof(Vertex), m_EditVertices.data());
+            
+            // Skirts follow the border heights and the chunk's height range
+            FillChunkSkirts(terrain, cx, cz, chunk.skirtDepth, m_EditVertices.data());
+            glBufferSubData(GL_ARRAY_BUFFER, (GLintptr)(chunk.baseVertex + CHUNK_GRID_VERTICES) * sizeof(Vertex),
+                            (GLsizeiptr)4 * CHUNK_VERTS * sizeof(Vertex), m_EditVertices.data());
+        }
+    }
+    
+    if (!displaced) glBindBuffer(GL_ARRAY_BUFFER, 0);
+    RefitQuadtree(terrain, 0);
+}
+
+// Leaves take their chunk's bounds, inner nodes the union of their children
+AABB TerrainSystem::RefitQuadtree(TerrainComponent* terrain, int nodeIndex) {
+    TerrainQuadNode& node = terrain->quadtree[nodeIndex];
+    if (node.chunk >= 0) {
+        node.bounds = terrain->chunks[node.chunk].bounds;
+        return node.bounds;
+    }
+    
+    AABB bounds;
+    for (int32_t child : node.children)
+        if (child >= 0) bounds.Expand(RefitQuadtree(terrain, child));
+    node.bounds = bounds;
+    return bounds;
+}
+
+// Returns the node index. Leaves hold one chunk, inner nodes split their chunk range in four.
+int TerrainSystem::BuildQuadtree(TerrainComponent* terrain, int x0, int z0, int x1, int z1) {
+    int nodeIndex = (int)terrain->quadtree.size();
+    terrain->quadtree.emplace_back();
+    
+    if (x1 - x0 == 1 && z1 - z0 == 1) {
+        int chunk = z0 * terrain->chunksX + x0;
+        terrain->quadtree[nodeIndex].chunk = chunk;
+        terrain->quadtree[nodeIndex].bounds = terrain->chunks[chunk].bounds;
+        return nodeIndex;
+    }
+    
+    int midX = (x0 + x1 + 1) / 2;
+    int midZ = (z0 + z1 + 1) / 2;
+    const int ranges[4][4] = {
+        { x0, z0, midX, midZ }, { midX, z0, x1, midZ },
+        { x0, midZ, midX, z1 }, { midX, midZ, x1, z1 }
+    };
+    
+    AABB bounds;
+    for (int i = 0; i < 4; i++) {
+        const int* r = ranges[i];
+        if (r[0] >= r[2] || r[1] >= r[3]) continue;
+        int child = BuildQuadtree(terrain, r[0], r[1], r[2], r[3]);
+        terrain->quadtree[nodeIndex].children[i] = child;   // Re-indexed, the vector may have grown
+        bounds.Expand(terrain->quadtree[child].bounds);
+    }
+    terrain->quadtree[nodeIndex].bounds = bounds;
+    return nodeIndex;
+}
+
+float TerrainSystem::GetHeightAt(Entity entity, float worldX, float worldZ) {
+    TerrainSampler sampler = GetSampler(entity);
+    return sampler ? sampler.GetHeightAt(worldX, worldZ) : 0.0f;
+}
+
+TerrainSampler TerrainSystem::GetSampler(Entity entity) {
+    TerrainSampler sampler;
+    auto* terrain = m_Coordinator->GetComponent<TerrainComponent>(entity);
+    if (!terrain || (terrain->heightData.empty() && !terrain->streamer)) return sampler;
+    
+    sampler.entity = entity;
+    sampler.terrain = terrain;
+    sampler.transform = m_Coordinator->GetComponent<TransformComponent>(entity);
+    return sampler;
+}
+
+// TERRAIN SAMPLER
+
+void TerrainSampler::GetFootprint(glm::vec2& min, glm::vec2& max) const {
+    float effectiveScaleX = terrain->terrainScale * transform->scale.x;
+    float effectiveScaleZ = terrain->terrainScale * transform->scale.z;
+    min = glm::vec2(transform->position.x, transform->position.z);
+    max = min + glm::vec2((terrain->width - 1) * effectiveScaleX, (terrain->height - 1) * effectiveScaleZ);
+}
+
+bool TerrainSampler::Contains(float worldX, float worldZ) const {
+    glm::vec2 min, max;
+    GetFootprint(min, max);
+    return worldX >= min.x && worldX < max.x && worldZ >= min.y && worldZ < max.y;
+}
+
+float TerrainSampler::GetHeightAt(float worldX, float worldZ) const {
     float localX = worldX - transform->position.x;
     float localZ = worldZ - transform->position.z;
     
@@ -174,6 +918,14 @@ float TerrainSystem::GetHeightAt(Entity entity, float worldX, float worldZ) {
     
     if (x0 < 0 || x0 >= terrain->width - 1 || z0 < 0 || z0 >= terrain->height - 1) return 0.0f;
     
+    // Streamed: finest resident tile, 0 where nothing covering the point is loaded yet
+    if (terrain->streamer)
+    {
+        float height01 = 0.0f;
+        if (!terrain->streamer->SampleHeight(gridX, gridZ, height01)) return 0.0f;
+        return (height01 * terrain->maxHeight * transform->scale.y) + transform->position.y;
+    }
+    
     float dx = gridX - (float)x0;
     float dz = gridZ - (float)z0;
     
@@ -246,6 +246,34 @@ void EditorContext::ViewportToolbar()
 
     ImGui::SameLine();
     
+    // Opaque shading path
+    bool isDeferred = m_EngineContext->GetRenderMode() == RenderMode::Deferred;
+    if (ImGui::Button(isDeferred ? "DEFERRED" : "FORWARD"))
+        m_EngineContext->SetRenderMode(isDeferred ? RenderMode::Forward : RenderMode::Deferred);
+
+    ImGui::SameLine();
+    bool prepass = m_EngineContext->GetDepthPrepass();
+    if (ImGui::Checkbox("Prepass", &prepass)) m_EngineContext->SetDepthPrepass(prepass);
+
+    ImGui::SameLine();
+    bool occlusion = m_EngineContext->GetOcclusionCulling();
+    if (ImGui::Checkbox("Occlusion", &occlusion)) m_EngineContext->SetOcclusionCulling(occlusion);
+
+    ImGui::SameLine();
+    auto terrainSystem = m_EngineContext->GetTerrainSystem();
+    bool gpuTerrain = terrainSystem->GetRenderMode() == TerrainRenderMode::Displaced;
+    if (ImGui::Checkbox("GPU Terrain", &gpuTerrain))
+        terrainSystem->SetRenderMode(gpuTerrain ? TerrainRenderMode::Displaced : TerrainRenderMode::Baked);
+
+    ImGui::SameLine();
+    auto physicsSystem = m_EngineContext->GetPhysicsSystem();
+    int physicsRate = (int)std::round(physicsSystem->GetFixedRate());
+    ImGui::SetNextItemWidth(60.0f);
+    if (ImGui::DragInt("Physics Hz", &physicsRate, 1.0f, 10, 240))
+        physicsSystem->SetFixedRate((float)physicsRate);
+
+    ImGui::SameLine();
+    
     float buttonSize = 50.0f;
     ImGui::SetCursorPosX((ImGui::GetWindowWidth() - buttonSize) * 0.5f);
     
@@ -271,6 +299,14 @@ void EditorContext::ViewportToolbar()
 void EditorContext::DisplayFPS(){
     int FPS = m_EngineContext ? m_EngineContext->GetFPS() : 0;
     std::string fpsText = std::to_string(FPS) + " FPS";
+    
+    // Render stats of the last frame
+    if (m_EngineContext && m_EngineContext->GetRenderSystem()) {
+        const RenderStats& stats = m_EngineContext->GetRenderSystem()->GetStats();
+        uint32_t binds = stats.materialBinds + stats.textureBinds + stats.meshBinds;
+        fpsText = std::to_string(stats.drawCalls) + " draws | " + std::to_string(binds) + " binds | " + fpsText;
+        if (stats.occluded > 0) fpsText = std::to_string(stats.occluded) + " occluded | " + fpsText;
+    }
     ImVec2 textSize = ImGui::CalcTextSize(fpsText.c_str());
 
     // to the right
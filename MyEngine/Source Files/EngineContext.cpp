@@ -6,6 +6,7 @@
 //
 
 #include "EngineContext.h"
+#include "MeshPool.h"
 #include "Scene.h"
 #include "EditorContext.h"
 #include "JobSystem.h"
@@ -117,6 +118,9 @@ void EngineContext::OnEngineLoaded()
     scriptSystem->Init();
     
     physicsSystem->SetTerrainSystem(terrainSystem);
+    scriptSystem->SetPhysicsSystem(physicsSystem);
+    renderSystem->SetCameraSystem(cameraSystem);
+    terrainSystem->SetCameraSystem(cameraSystem);
 
     // 3. Setup Scene & Rendering Context
     m_Scene = new Scene(*m_Coordinator, renderSystem, cameraSystem);
@@ -124,7 +128,14 @@ void EngineContext::OnEngineLoaded()
     m_ShaderManager->Init();
 
     InitViewportFramebuffer(2048, 2048);
+    InitGBuffer(2048, 2048);
+    m_HiZ.Create(2048, 2048);
     InitShadowMap();
+    m_FrameRing.Create(FRAME_RING_SIZE);
+    renderSystem->SetFrameAllocator(&m_FrameRing);
+    lightSystem->SetFrameAllocator(&m_FrameRing);
+    debugSystem->SetFrameAllocator(&m_FrameRing);
+    terrainSystem->SetFrameAllocator(&m_FrameRing);
 
     // 4. Load the actual scene data
     OnEditMode();
@@ -135,36 +146,94 @@ void EngineContext::OnEngineLoaded()
 }
 
 /**
- * @brief Configures the Shadow Map Framebuffer (FBO).
+ * @brief Configures the Shadow Map Framebuffers (cached static + per-frame composite).
  */
 void EngineContext::InitShadowMap() {
-    glGenFramebuffers(1, &m_DepthMapFBO);
+    CreateShadowTarget(m_DepthMapFBOs, m_DepthMapTexture);
+    CreateShadowTarget(m_StaticDepthMapFBOs, m_StaticDepthMapTexture);
+    m_ShadowTexture = m_DepthMapTexture;
+    m_StaticShadowValid = false;
+}
 
-    // Create Depth Texture
-    glGenTextures(1, &m_DepthMapTexture);
-    glBindTexture(GL_TEXTURE_2D, m_DepthMapTexture);
-    glTexImage2D(GL_TEXTURE_2D, 0, GL_DEPTH_COMPONENT, SHADOW_WIDTH, SHADOW_HEIGHT, 0, GL_DEPTH_COMPONENT, GL_FLOAT, NULL);
+void EngineContext::CreateShadowTarget(unsigned int* fbos, unsigned int& textureArray) {
+    // Create Depth Texture Array (fixed format, the static map is blitted into the composite)
+    glGenTextures(1, &textureArray);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, textureArray);
+    glTexImage3D(GL_TEXTURE_2D_ARRAY, 0, GL_DEPTH_COMPONENT24, SHADOW_WIDTH, SHADOW_HEIGHT, SHADOW_CASCADES, 0, GL_DEPTH_COMPONENT, GL_FLOAT, NULL);
     
     // Set texture parameters for shadow sampling
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_BORDER);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_BORDER);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_BORDER);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_BORDER);
     
     float borderColor[] = { 1.0f, 1.0f, 1.0f, 1.0f };
-    glTexParameterfv(GL_TEXTURE_2D, GL_TEXTURE_BORDER_COLOR, borderColor);
+    glTexParameterfv(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_BORDER_COLOR, borderColor);
 
-    // Attach texture to Framebuffer
-    glBindFramebuffer(GL_FRAMEBUFFER, m_DepthMapFBO);
-    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_TEXTURE_2D, m_DepthMapTexture, 0);
-    
-    // Not rendering color data
-    glDrawBuffer(GL_NONE);
-    glReadBuffer(GL_NONE);
+    // One framebuffer per cascade layer
+    glGenFramebuffers(SHADOW_CASCADES, fbos);
+    for (int cascade = 0; cascade < SHADOW_CASCADES; cascade++)
+    {
+        glBindFramebuffer(GL_FRAMEBUFFER, fbos[cascade]);
+        glFramebufferTextureLayer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, textureArray, 0, cascade);
+        
+        // Not rendering color data
+        glDrawBuffer(GL_NONE);
+        glReadBuffer(GL_NONE);
+    }
 
     glBindFramebuffer(GL_FRAMEBUFFER, 0);
 }
 
+/**
+ * @brief Cascaded shadow pass with static caster caching.
+ * Each cascade is culled and drawn with its own light matrix. The static layer is only redrawn
+ * when a static caster changed or the cascade moved to its next world anchor (see
+ * LightSystem::ComputeCascades), not every frame the camera moves. Dynamic casters are drawn
+ * on top of a copy of it; with none in the scene the cached array is sampled directly.
+ */
+void EngineContext::RenderShadows(Shader& shadowShader, const ShadowCascades& cascades) {
+    shadowShader.Use();
+    glViewport(0, 0, SHADOW_WIDTH, SHADOW_HEIGHT);
+    
+    // Casters in front of the light's near plane are clamped instead of clipped
+    glEnable(GL_DEPTH_CLAMP);
+    
+    bool staticChanged = renderSystem->ConsumeStaticCasterChanges() || !m_StaticShadowValid;
+    bool hasDynamicCasters = renderSystem->GetDynamicCasterCount() > 0;
+    
+    for (int cascade = 0; cascade < SHADOW_CASCADES; cascade++)
+    {
+        const glm::mat4& cascadeMatrix = cascades.matrices[cascade];
+        shadowShader.SetInt("u_Cascade", cascade);
+        
+        if (staticChanged || cascadeMatrix != m_CachedCascadeMatrices[cascade])
+        {
+            glBindFramebuffer(GL_FRAMEBUFFER, m_StaticDepthMapFBOs[cascade]);
+            glClear(GL_DEPTH_BUFFER_BIT); // Only clearing depth, no color
+            renderSystem->Render(shadowShader, cascadeMatrix, RenderPass::Shadow, CasterFilter::Static);
+            m_CachedCascadeMatrices[cascade] = cascadeMatrix;
+        }
+        
+        if (hasDynamicCasters)
+        {
+            // Composite: start from the cached depth, then add the moving casters
+            glBindFramebuffer(GL_READ_FRAMEBUFFER, m_StaticDepthMapFBOs[cascade]);
+            glBindFramebuffer(GL_DRAW_FRAMEBUFFER, m_DepthMapFBOs[cascade]);
+            glBlitFramebuffer(0, 0, SHADOW_WIDTH, SHADOW_HEIGHT, 0, 0, SHADOW_WIDTH, SHADOW_HEIGHT, GL_DEPTH_BUFFER_BIT, GL_NEAREST);
+            
+            glBindFramebuffer(GL_FRAMEBUFFER, m_DepthMapFBOs[cascade]);
+            renderSystem->Render(shadowShader, cascadeMatrix, RenderPass::Shadow, CasterFilter::Dynamic);
+        }
+    }
+    
+    m_StaticShadowValid = true;
+    m_ShadowTexture = hasDynamicCasters ? m_DepthMapTexture : m_StaticDepthMapTexture;
+    
+    glDisable(GL_DEPTH_CLAMP);
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+}
+
 /**
  * @brief Initializes the Off-Screen Framebuffer.
  * Instead of rendering directly to the window, we render to this texture (`m_ViewportTexture`).
@@ -197,6 +266,123 @@ void EngineContext::InitViewportFramebuffer(int width, int height){
     glBindFramebuffer(GL_FRAMEBUFFER, 0);
 }
 
+/**
+ * @brief Creates the deferred G-buffer: world position + ambient, normal + shininess, albedo + specular.
+ * Has its own depth so the opaque depth can be blitted into the viewport for the forward passes after it.
+ */
+void EngineContext::InitGBuffer(int width, int height){
+    glGenFramebuffers(1, &m_gBuffer);
+    glBindFramebuffer(GL_FRAMEBUFFER, m_gBuffer);
+    
+    auto createTarget = [width, height](unsigned int& texture, GLint internalFormat, GLenum type, GLenum attachment){
+        glGenTextures(1, &texture);
+        glBindTexture(GL_TEXTURE_2D, texture);
+        glTexImage2D(GL_TEXTURE_2D, 0, internalFormat, width, height, 0, GL_RGBA, type, nullptr);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+        glFramebufferTexture2D(GL_FRAMEBUFFER, attachment, GL_TEXTURE_2D, texture, 0);
+    };
+    
+    createTarget(m_gPosition, GL_RGBA16F, GL_FLOAT, GL_COLOR_ATTACHMENT0);
+    createTarget(m_gNormal, GL_RGBA16F, GL_FLOAT, GL_COLOR_ATTACHMENT1);
+    createTarget(m_gAlbedoSpec, GL_RGBA8, GL_UNSIGNED_BYTE, GL_COLOR_ATTACHMENT2);
+    
+    const GLenum attachments[3] = { GL_COLOR_ATTACHMENT0, GL_COLOR_ATTACHMENT1, GL_COLOR_ATTACHMENT2 };
+    glDrawBuffers(3, attachments);
+    
+    // Same format as the viewport RBO so the depth can be blitted across
+    glGenRenderbuffers(1, &m_gDepthRBO);
+    glBindRenderbuffer(GL_RENDERBUFFER, m_gDepthRBO);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH24_STENCIL8, width, height);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT, GL_RENDERBUFFER, m_gDepthRBO);
+    
+    if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
+        std::cout << "ERROR::FRAMEBUFFER:: G-buffer incomplete!" << std::endl;
+    
+    glGenVertexArrays(1, &m_FullscreenVAO);
+    
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+}
+
+/**
+ * @brief Binds what every lit shader samples besides materials: the shadow cascades and the light clusters.
+ */
+void EngineContext::BindSceneLighting(Shader& shader){
+    // Shadow Map (matrices come from the FrameData block)
+    glActiveTexture(GL_TEXTURE3);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, m_ShadowTexture);
+    shader.SetInt("shadowMap", 3);
+    lightSystem->BindClusters(shader);
+}
+
+/**
+ * @brief Camera depth prepass into the bound framebuffer, through the shadow depth shader.
+ * Leaves the depth test on GL_EQUAL with writes off, so the following opaque pass only
+ * shades the visible fragment of each pixel. The caller restores GL_LESS afterwards.
+ */
+void EngineContext::RenderDepthPrepass(Shader& depthShader){
+    depthShader.Use();
+    depthShader.SetInt("u_Cascade", -1);
+    glColorMask(GL_FALSE, GL_FALSE, GL_FALSE, GL_FALSE);
+    
+    terrainSystem->Render(depthShader, m_FrameData.viewProjection);
+    renderSystem->Render(depthShader, m_FrameData.viewProjection, RenderPass::Depth);
+    
+    glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
+    glDepthFunc(GL_EQUAL);
+    glDepthMask(GL_FALSE);
+}
+
+/**
+ * @brief Deferred opaque path.
+ * Geometry pass writes the G-buffer, then one fullscreen triangle lights every covered pixel
+ * (point lights come from the same cluster grid as forward). The G-buffer depth is copied into
+ * the viewport so gizmos and transparents are depth tested against the opaque scene.
+ * Expects m_ViewportFBO to be cleared already.
+ */
+void EngineContext::RenderDeferred(Shader& gBufferShader, Shader& lightingShader, Shader* depthShader){
+    // Geometry
+    glBindFramebuffer(GL_FRAMEBUFFER, m_gBuffer);
+    glViewport(0, 0, m_ViewportWidth, m_ViewportHeight);
+    glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
+    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+    
+    if (depthShader) RenderDepthPrepass(*depthShader);
+    
+    gBufferShader.Use();
+    terrainSystem->Render(gBufferShader, m_FrameData.viewProjection);
+    renderSystem->Render(gBufferShader, m_FrameData.viewProjection, RenderPass::Opaque);
+    glDepthFunc(GL_LESS);
+    glDepthMask(GL_TRUE);
+    
+    // Lighting (background pixels are discarded, the sky clear stays)
+    glBindFramebuffer(GL_FRAMEBUFFER, m_ViewportFBO);
+    glDisable(GL_DEPTH_TEST);
+    
+    lightingShader.Use();
+    const unsigned int targets[3] = { m_gPosition, m_gNormal, m_gAlbedoSpec };
+    const char* samplers[3] = { "gPosition", "gNormal", "gAlbedoSpec" };
+    for (int unit = 0; unit < 3; unit++)
+    {
+        glActiveTexture(GL_TEXTURE0 + unit);
+        glBindTexture(GL_TEXTURE_2D, targets[unit]);
+        lightingShader.SetInt(samplers[unit], unit);
+    }
+    BindSceneLighting(lightingShader);
+    
+    glBindVertexArray(m_FullscreenVAO);
+    glDrawArrays(GL_TRIANGLES, 0, 3);
+    glBindVertexArray(0);
+    
+    glEnable(GL_DEPTH_TEST);
+    
+    // Opaque depth for everything drawn after this
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, m_gBuffer);
+    glBindFramebuffer(GL_DRAW_FRAMEBUFFER, m_ViewportFBO);
+    glBlitFramebuffer(0, 0, m_ViewportWidth, m_ViewportHeight, 0, 0, m_ViewportWidth, m_ViewportHeight, GL_DEPTH_BUFFER_BIT, GL_NEAREST);
+    glBindFramebuffer(GL_FRAMEBUFFER, m_ViewportFBO);
+}
+
 void EngineContext::InitWindow(int width, int height, const char* title){
     glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 4);
     glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 1);
@@ -247,7 +433,7 @@ void EngineContext::OnReleaseCamControl(){
  * @brief The Main Engine Loop.
  * 1. Calculates Delta Time.
  * 2. PASS 1: Renders the Shadow Map.
- * 3. PASS 2: Renders the Main Scene to Off-screen FBO.
+ * 3. PASS 2: Renders the Main Scene to Off-screen FBO (forward or deferred opaque, then forward transparents).
  * 4. PASS 3: Renders the Editor UI (ImGui) to the Window.
  */
 void EngineContext::Draw(){
@@ -284,23 +470,29 @@ void EngineContext::Draw(){
             ProcessMessages();
             m_Scene->SyncLoadedAssets();
             cameraSystem->Update();
+            terrainSystem->Update();
+            m_FrameRing.BeginFrame();
+            if (m_OcclusionCulling) m_HiZ.Resolve();
+            renderSystem->SyncSceneBounds();
+            
+            // Per-frame uniforms (FrameData block), shared by the shadow and main passes
+            m_FrameData.view = cameraSystem->GetView();
+            m_FrameData.projection = cameraSystem->GetCameraProjection();
+            m_FrameData.viewProjection = m_FrameData.projection * m_FrameData.view;
+            lightSystem->UploadLights(m_FrameData.view, m_FrameData.projection, glm::vec2(m_ViewportWidth, m_ViewportHeight));
+            lightSystem->ComputeCascades(m_FrameData.view, m_FrameData.projection, SHADOW_WIDTH, m_ShadowCascades);
+            for (int cascade = 0; cascade < SHADOW_CASCADES; cascade++)
+                m_FrameData.cascadeMatrices[cascade] = m_ShadowCascades.matrices[cascade];
+            m_FrameData.cascadeSplits = m_ShadowCascades.splits;
+            m_FrameData.eyePosition = glm::vec4(cameraSystem->GetCameraPosition(), 1.0f);
+            GPUAllocation frameUniforms = m_FrameRing.Upload(&m_FrameData, sizeof(FrameUniforms), UniformBuffer::GetOffsetAlignment());
+            if (frameUniforms) BindUniformRange(UniformBinding::Frame, frameUniforms);
 
             // PASS 1: Shadow Mapping
             // Render the scene from the Light's perspective into the Depth Buffer
 
             Shader* shadowShader = m_ShaderManager->Get("ShadowMap");
-            if (shadowShader) {
-                shadowShader->Use();
-                glm::mat4 lightSpaceMatrix = lightSystem->GetLightSpaceMatrix();
-                shadowShader->SetMatrix4(lightSpaceMatrix, "shadowMapMatrix");
-
-                glViewport(0, 0, SHADOW_WIDTH, SHADOW_HEIGHT);
-                glBindFramebuffer(GL_FRAMEBUFFER, m_DepthMapFBO);
-                glClear(GL_DEPTH_BUFFER_BIT); // Only clearing depth, no color
-
-                renderSystem->Render(*shadowShader);
-                glBindFramebuffer(GL_FRAMEBUFFER, 0);
-            }
+            if (shadowShader) RenderShadows(*shadowShader, m_ShadowCascades);
             
             // PASS 2: Main Scene Rendering
             // Render the scene to the custom Framebuffer (m_ViewportFBO)
@@ -312,25 +504,39 @@ void EngineContext::Draw(){
             glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
             
             Shader* mainShader = m_ShaderManager->Get("Main");
-            if(mainShader){
-                mainShader->Use();
-                
-                // Upload Camera Matrices
-                mainShader->SetMatrix4(cameraSystem->GetView(), "viewMatrix");
-                mainShader->SetMatrix4(cameraSystem->GetCameraProjection(), "projectionMatrix");
-
-                // Upload Shadow Matrix & Map
-                glm::mat4 lightSpaceMatrix = lightSystem->GetLightSpaceMatrix();
-                mainShader->SetMatrix4(lightSpaceMatrix, "shadowMapMatrix");
+            Shader* gBufferShader = m_ShaderManager->Get("GBuffer");
+            Shader* lightingShader = m_ShaderManager->Get("DeferredLighting");
+            bool deferred = m_RenderMode == RenderMode::Deferred && gBufferShader && lightingShader;
+            
+            Shader* depthShader = m_DepthPrepass ? shadowShader : nullptr;
+            
+            if(deferred){
+                RenderDeferred(*gBufferShader, *lightingShader, depthShader);
+            }
+            else if(mainShader){
+                if(depthShader) RenderDepthPrepass(*depthShader);
                 
-                glActiveTexture(GL_TEXTURE3);
-                glBindTexture(GL_TEXTURE_2D, m_DepthMapTexture);
-                mainShader->SetInt("shadowMap", 3);
+                mainShader->Use();
+                BindSceneLighting(*mainShader);
                 
                 // Draw Scene
-                terrainSystem->Render(*mainShader);
-                renderSystem->Render(*mainShader);
-                lightSystem->Render(*mainShader);
+                terrainSystem->Render(*mainShader, m_FrameData.viewProjection);
+                renderSystem->Render(*mainShader, m_FrameData.viewProjection, RenderPass::Opaque);
+                glDepthFunc(GL_LESS);
+                glDepthMask(GL_TRUE);
+            }
+            
+            // Transparents: forward shaded and blended over the opaque result, back to front
+            if(mainShader){
+                mainShader->Use();
+                if(deferred) BindSceneLighting(*mainShader);
+                
+                glEnable(GL_BLEND);
+                glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+                glDepthMask(GL_FALSE);
+                renderSystem->Render(*mainShader, m_FrameData.viewProjection, RenderPass::Transparent);
+                glDepthMask(GL_TRUE);
+                glDisable(GL_BLEND);
             }
 
             if(bControllingCamera) cameraSystem->ProcessInput(m_Window, m_DeltaTime);
@@ -360,8 +566,13 @@ void EngineContext::Draw(){
                 scriptSystem->Update(m_DeltaTime);
             }
             
+            // Depth pyramid for next frame's occlusion culling (gizmos do not write depth)
+            Shader* hiZShader = m_ShaderManager->Get("HiZDownsample");
+            if(m_OcclusionCulling && hiZShader) m_HiZ.Build(*hiZShader, m_ViewportFBO, m_FrameData.viewProjection);
+            
             //Unbinding
             glBindFramebuffer(GL_FRAMEBUFFER, 0);
+            m_FrameRing.EndFrame();
             
             // Editor UI
             m_EditorContext->RenderEditor();
@@ -373,6 +584,9 @@ void EngineContext::Draw(){
 }
 
 void EngineContext::Cleanup(){
+    m_FrameRing.Destroy();
+    m_HiZ.Destroy();
+    MeshPool::Get().Shutdown();
     delete m_Scene;
     delete m_ShaderManager;
     delete m_EditorContext;
@@ -407,6 +621,7 @@ void EngineContext::SetState(EngineState newState)
     {
         std::cout << "Saving scene before play..." << std::endl;
         GetScene()->Save();
+        physicsSystem->ResetAccumulator();
     }
 
     // 2. Returning to EDIT mode: Reset everything by loading the saved state
@@ -418,12 +633,20 @@ void EngineContext::SetState(EngineState newState)
     m_State = newState;
 }
 
+void EngineContext::SetOcclusionCulling(bool enabled)
+{
+    if (enabled && !m_OcclusionCulling) m_HiZ.Invalidate();
+    m_OcclusionCulling = enabled;
+    renderSystem->SetOcclusionBuffer(enabled ? &m_HiZ : nullptr);
+}
+
 void EngineContext::OnEditMode()
 {
     std::string startScenePath = Project::GetActiveAbsoluteScenePath();
     if (!startScenePath.empty()) {
         m_Scene->Load(startScenePath);
         cameraSystem->Init();
+        m_HiZ.Invalidate();
 
     }
 }
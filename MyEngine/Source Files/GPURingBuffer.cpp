@@ -0,0 +1,188 @@
+//
+//  GPURingBuffer.cpp
+//  MyEngine
+//
+//  Created by Priyanshu Kaushik on 19/10/2026.
+//
+
+#include "GPURingBuffer.h"
+#include <iostream>
+#include <algorithm>
+
+void GPURingBuffer::Create(GLsizeiptr frameSize)
+{
+    m_FrameSize = frameSize;
+    m_Persistent = GLAD_GL_ARB_buffer_storage != 0;
+    CreateStorage();
+
+    std::cout << "[GPU Ring] " << (m_Persistent ? "Persistent mapped" : "Orphaning fallback")
+              << ", " << (m_FrameSize / 1024) << " KB per frame" << std::endl;
+}
+
+void GPURingBuffer::CreateStorage()
+{
+    glGenBuffers(1, &m_Buffer);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, m_Buffer);
+
+    if (m_Persistent)
+    {
+        GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+        glBufferStorage(GL_COPY_WRITE_BUFFER, m_FrameSize * FRAME_COUNT, nullptr, flags);
+        m_Mapped = static_cast<uint8_t*>(glMapBufferRange(GL_COPY_WRITE_BUFFER, 0, m_FrameSize * FRAME_COUNT, flags));
+    }
+    else
+    {
+        glBufferData(GL_COPY_WRITE_BUFFER, m_FrameSize, nullptr, GL_STREAM_DRAW);
+        m_Staging.resize(m_FrameSize);
+    }
+
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+    m_FrameOffset = 0;
+}
+
+void GPURingBuffer::Destroy()
+{
+    for (int i = 0; i < FRAME_COUNT; i++) WaitForFence(i);
+    ReleaseOverflow();
+
+    if (m_Buffer)
+    {
+        if (m_Mapped) {
+            glBindBuffer(GL_COPY_WRITE_BUFFER, m_Buffer);
+            glUnmapBuffer(GL_COPY_WRITE_BUFFER);
+            glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+        }
+        glDeleteBuffers(1, &m_Buffer);
+    }
+    m_Buffer = 0;
+    m_Mapped = nullptr;
+    m_Staging.clear();
+}
+
+void GPURingBuffer::WaitForFence(int segment)
+{
+    GLsync& fence = m_Fences[segment];
+    if (!fence) return;
+
+    // 1ms slices, flushing on the first try so the fence is guaranteed to signal
+    GLbitfield flags = GL_SYNC_FLUSH_COMMANDS_BIT;
+    while (true)
+    {
+        GLenum result = glClientWaitSync(fence, flags, 1000000);
+        if (result == GL_ALREADY_SIGNALED || result == GL_CONDITION_SATISFIED || result == GL_WAIT_FAILED) break;
+        flags = 0;
+    }
+    glDeleteSync(fence);
+    fence = nullptr;
+}
+
+// FRAME
+
+void GPURingBuffer::BeginFrame()
+{
+    // Last frame overflowed: nothing of this frame is handed out yet, so the ring can be
+    // recreated at the size it needed (once every segment is idle)
+    ReleaseOverflow();
+    if (m_FrameNeeded > m_FrameSize)
+    {
+        GLsizeiptr frameSize = m_FrameNeeded + m_FrameNeeded / 2;
+        Destroy();
+        m_FrameSize = frameSize;
+        m_Segment = 0;
+        CreateStorage();
+    }
+    m_FrameNeeded = 0;
+    m_FrameOffset = 0;
+
+    if (m_Persistent)
+    {
+        m_Segment = (m_Segment + 1) % FRAME_COUNT;
+        WaitForFence(m_Segment);
+    }
+    else
+    {
+        // Orphan: the driver hands out fresh storage while the GPU still reads last frame's
+        glBindBuffer(GL_COPY_WRITE_BUFFER, m_Buffer);
+        glBufferData(GL_COPY_WRITE_BUFFER, m_FrameSize, nullptr, GL_STREAM_DRAW);
+        glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+    }
+}
+
+void GPURingBuffer::EndFrame()
+{
+    if (!m_Persistent) return;
+    m_Fences[m_Segment] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+}
+
+// ALLOCATION
+
+GPUAllocation GPURingBuffer::Allocate(GLsizeiptr size, GLsizeiptr alignment)
+{
+    GPUAllocation allocation;
+    if (!m_Buffer || size <= 0) return allocation;
+
+    GLsizeiptr offset = (m_FrameOffset + alignment - 1) / alignment * alignment;
+    m_FrameNeeded += size + alignment;
+
+    // Frame overflow: earlier ranges may already be bound, the ring is left alone until BeginFrame
+    if (offset + size > m_FrameSize) return AllocateOverflow(size, alignment);
+
+    GLintptr segmentBase = m_Persistent ? m_Segment * m_FrameSize : 0;
+
+    allocation.buffer = m_Buffer;
+    allocation.offset = segmentBase + offset;
+    allocation.size = size;
+    allocation.data = m_Persistent ? m_Mapped + segmentBase + offset : m_Staging.data() + offset;
+
+    m_FrameOffset = offset + size;
+    return allocation;
+}
+
+// OVERFLOW
+
+GPUAllocation GPURingBuffer::AllocateOverflow(GLsizeiptr size, GLsizeiptr alignment)
+{
+    GLsizeiptr offset = 0;
+    if (!m_Overflow.empty())
+        offset = (m_Overflow.back().offset + alignment - 1) / alignment * alignment;
+
+    // New chunk when the last one is full; chunks never move, so handed out pointers stay valid
+    if (m_Overflow.empty() || offset + size > m_Overflow.back().size)
+    {
+        OverflowChunk chunk;
+        chunk.size = std::max(size, m_FrameSize);
+        chunk.staging.resize(chunk.size);
+        glGenBuffers(1, &chunk.buffer);
+        glBindBuffer(GL_COPY_WRITE_BUFFER, chunk.buffer);
+        glBufferData(GL_COPY_WRITE_BUFFER, chunk.size, nullptr, GL_STREAM_DRAW);
+        glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+        m_Overflow.push_back(std::move(chunk));
+        offset = 0;
+    }
+
+    OverflowChunk& chunk = m_Overflow.back();
+    GPUAllocation allocation;
+    allocation.buffer = chunk.buffer;
+    allocation.offset = offset;
+    allocation.size = size;
+    allocation.data = chunk.staging.data() + offset;
+    chunk.offset = offset + size;
+    return allocation;
+}
+
+// GL defers deleting a buffer until the draws that read it are done
+void GPURingBuffer::ReleaseOverflow()
+{
+    for (OverflowChunk& chunk : m_Overflow) glDeleteBuffers(1, &chunk.buffer);
+    m_Overflow.clear();
+}
+
+void GPURingBuffer::Commit(const GPUAllocation& allocation)
+{
+    // Persistently mapped ring ranges are visible already, overflow chunks are always staged
+    if (!allocation || (m_Persistent && allocation.buffer == m_Buffer)) return;
+
+    glBindBuffer(GL_COPY_WRITE_BUFFER, allocation.buffer);
+    glBufferSubData(GL_COPY_WRITE_BUFFER, allocation.offset, allocation.size, allocation.data);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+}
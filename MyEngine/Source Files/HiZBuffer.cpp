@@ -0,0 +1,258 @@
+//
+//  HiZBuffer.cpp
+//  MyEngine
+//
+//  Created by Priyanshu Kaushik on 19/10/2026.
+//
+
+#include "HiZBuffer.h"
+#include "Shader.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+void HiZBuffer::Create(int width, int height)
+{
+    m_Width = width;
+    m_Height = height;
+
+    // Depth copy, same format as the viewport renderbuffer so it can be blitted
+    glGenTextures(1, &m_DepthCopyTexture);
+    glBindTexture(GL_TEXTURE_2D, m_DepthCopyTexture);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_DEPTH24_STENCIL8, width, height, 0, GL_DEPTH_STENCIL, GL_UNSIGNED_INT_24_8, nullptr);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+
+    glGenFramebuffers(1, &m_DepthCopyFBO);
+    glBindFramebuffer(GL_FRAMEBUFFER, m_DepthCopyFBO);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT, GL_TEXTURE_2D, m_DepthCopyTexture, 0);
+    glDrawBuffer(GL_NONE);
+    glReadBuffer(GL_NONE);
+
+    // GPU levels, halving until the readback size is reached
+    m_LevelSizes.clear();
+    glm::ivec2 size(std::max(1, width / 2), std::max(1, height / 2));
+    while (true)
+    {
+        m_LevelSizes.push_back(size);
+        if (std::max(size.x, size.y) <= READBACK_SIZE) break;
+        size = glm::ivec2(std::max(1, size.x / 2), std::max(1, size.y / 2));
+    }
+
+    glGenTextures(1, &m_PyramidTexture);
+    glBindTexture(GL_TEXTURE_2D, m_PyramidTexture);
+    for (size_t level = 0; level < m_LevelSizes.size(); level++)
+        glTexImage2D(GL_TEXTURE_2D, (GLint)level, GL_R32F, m_LevelSizes[level].x, m_LevelSizes[level].y, 0, GL_RED, GL_FLOAT, nullptr);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST_MIPMAP_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, (GLint)m_LevelSizes.size() - 1);
+
+    m_LevelFBOs.resize(m_LevelSizes.size());
+    glGenFramebuffers((GLsizei)m_LevelFBOs.size(), m_LevelFBOs.data());
+    for (size_t level = 0; level < m_LevelFBOs.size(); level++)
+    {
+        glBindFramebuffer(GL_FRAMEBUFFER, m_LevelFBOs[level]);
+        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, m_PyramidTexture, (GLint)level);
+    }
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+
+    glGenVertexArrays(1, &m_FullscreenVAO);
+
+    const glm::ivec2& readbackSize = m_LevelSizes.back();
+    glGenBuffers(1, &m_ReadbackPBO);
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, m_ReadbackPBO);
+    glBufferData(GL_PIXEL_PACK_BUFFER, readbackSize.x * readbackSize.y * sizeof(float), nullptr, GL_STREAM_READ);
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+    m_Ready = false;
+}
+
+void HiZBuffer::Destroy()
+{
+    if (m_ReadbackFence) glDeleteSync(m_ReadbackFence);
+    m_ReadbackFence = nullptr;
+
+    if (!m_LevelFBOs.empty()) glDeleteFramebuffers((GLsizei)m_LevelFBOs.size(), m_LevelFBOs.data());
+    m_LevelFBOs.clear();
+
+    glDeleteFramebuffers(1, &m_DepthCopyFBO);
+    glDeleteTextures(1, &m_DepthCopyTexture);
+    glDeleteTextures(1, &m_PyramidTexture);
+    glDeleteBuffers(1, &m_ReadbackPBO);
+    glDeleteVertexArrays(1, &m_FullscreenVAO);
+    m_DepthCopyFBO = m_DepthCopyTexture = m_PyramidTexture = m_ReadbackPBO = m_FullscreenVAO = 0;
+
+    m_Levels.clear();
+    m_Ready = false;
+}
+
+void HiZBuffer::Invalidate()
+{
+    if (m_ReadbackFence) glDeleteSync(m_ReadbackFence);
+    m_ReadbackFence = nullptr;
+    m_Ready = false;
+}
+
+// GPU REDUCTION
+
+void HiZBuffer::Build(Shader& downsampleShader, GLuint sourceFBO, const glm::mat4& viewProjection)
+{
+    if (!m_PyramidTexture || m_ReadbackFence) return;
+
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, sourceFBO);
+    glBindFramebuffer(GL_DRAW_FRAMEBUFFER, m_DepthCopyFBO);
+    glBlitFramebuffer(0, 0, m_Width, m_Height, 0, 0, m_Width, m_Height, GL_DEPTH_BUFFER_BIT, GL_NEAREST);
+
+    glDisable(GL_DEPTH_TEST);
+    downsampleShader.Use();
+    downsampleShader.SetInt("u_Source", 0);
+    glActiveTexture(GL_TEXTURE0);
+    glBindVertexArray(m_FullscreenVAO);
+
+    for (size_t level = 0; level < m_LevelFBOs.size(); level++)
+    {
+        // Only the previous level is visible to the shader, so reading and writing one texture is no feedback loop
+        if (level == 0) {
+            glBindTexture(GL_TEXTURE_2D, m_DepthCopyTexture);
+        } else {
+            glBindTexture(GL_TEXTURE_2D, m_PyramidTexture);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, (GLint)level - 1);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, (GLint)level - 1);
+        }
+
+        glBindFramebuffer(GL_FRAMEBUFFER, m_LevelFBOs[level]);
+        glViewport(0, 0, m_LevelSizes[level].x, m_LevelSizes[level].y);
+        glDrawArrays(GL_TRIANGLES, 0, 3);
+    }
+
+    glBindTexture(GL_TEXTURE_2D, m_PyramidTexture);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, 0);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, (GLint)m_LevelSizes.size() - 1);
+    glBindVertexArray(0);
+    glEnable(GL_DEPTH_TEST);
+
+    // Readback of the last level into the pack buffer, fenced so Resolve never stalls
+    const glm::ivec2& readbackSize = m_LevelSizes.back();
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, m_LevelFBOs.back());
+    glReadBuffer(GL_COLOR_ATTACHMENT0);
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, m_ReadbackPBO);
+    glReadPixels(0, 0, readbackSize.x, readbackSize.y, GL_RED, GL_FLOAT, nullptr);
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+    m_ReadbackFence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    m_PendingViewProjection = viewProjection;
+
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+}
+
+// READBACK
+
+void HiZBuffer::Resolve()
+{
+    if (!m_ReadbackFence) return;
+
+    GLenum status = glClientWaitSync(m_ReadbackFence, 0, 0);
+    if (status != GL_ALREADY_SIGNALED && status != GL_CONDITION_SATISFIED) return;
+    glDeleteSync(m_ReadbackFence);
+    m_ReadbackFence = nullptr;
+
+    const glm::ivec2& readbackSize = m_LevelSizes.back();
+    size_t texels = (size_t)readbackSize.x * readbackSize.y;
+
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, m_ReadbackPBO);
+    void* mapped = glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, texels * sizeof(float), GL_MAP_READ_BIT);
+    if (mapped)
+    {
+        m_Levels.resize(1);
+        m_Levels[0].resize(texels);
+        std::memcpy(m_Levels[0].data(), mapped, texels * sizeof(float));
+        glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+
+        m_CPULevelSizes.assign(1, readbackSize);
+        BuildCPULevels();
+        m_ViewProjection = m_PendingViewProjection;
+        m_Ready = true;
+    }
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+}
+
+// Same 2x2 max reduction as the shader, odd edges fold into the last texel
+void HiZBuffer::BuildCPULevels()
+{
+    while (m_CPULevelSizes.back().x > 1 || m_CPULevelSizes.back().y > 1)
+    {
+        glm::ivec2 src = m_CPULevelSizes.back();
+        glm::ivec2 dst(std::max(1, src.x / 2), std::max(1, src.y / 2));
+        const std::vector<float>& source = m_Levels.back();
+        std::vector<float> level(dst.x * dst.y, 0.0f);
+
+        for (int y = 0; y < src.y; y++)
+        {
+            int dy = std::min(y / 2, dst.y - 1);
+            for (int x = 0; x < src.x; x++)
+            {
+                int dx = std::min(x / 2, dst.x - 1);
+                float& out = level[dy * dst.x + dx];
+                out = std::max(out, source[y * src.x + x]);
+            }
+        }
+
+        m_Levels.push_back(std::move(level));
+        m_CPULevelSizes.push_back(dst);
+    }
+}
+
+// OCCLUSION TEST
+
+bool HiZBuffer::IsOccluded(const AABB& bounds) const
+{
+    if (!m_Ready || !bounds.IsValid()) return false;
+
+    glm::vec2 uvMin(FLT_MAX), uvMax(-FLT_MAX);
+    float nearestDepth = FLT_MAX;
+    for (int corner = 0; corner < 8; corner++)
+    {
+        glm::vec3 p((corner & 1) ? bounds.max.x : bounds.min.x,
+                    (corner & 2) ? bounds.max.y : bounds.min.y,
+                    (corner & 4) ? bounds.max.z : bounds.min.z);
+        glm::vec4 clip = m_ViewProjection * glm::vec4(p, 1.0f);
+
+        // Crosses the camera plane: no meaningful screen rect
+        if (clip.w <= 1e-5f) return false;
+
+        glm::vec3 ndc = glm::vec3(clip) / clip.w;
+        glm::vec2 uv = glm::vec2(ndc.x, ndc.y) * 0.5f + 0.5f;
+        uvMin = glm::min(uvMin, uv);
+        uvMax = glm::max(uvMax, uv);
+        nearestDepth = std::min(nearestDepth, ndc.z * 0.5f + 0.5f);
+    }
+
+    // Anything reaching outside last frame's view may be visible now
+    if (uvMin.x < 0.0f || uvMin.y < 0.0f || uvMax.x > 1.0f || uvMax.y > 1.0f) return false;
+    if (nearestDepth <= 0.0f) return false;
+
+    // Start at the read back level, climb until the rect spans at most 2x2 texels
+    const glm::ivec2& baseSize = m_CPULevelSizes[0];
+    int x0 = std::min((int)(uvMin.x * baseSize.x), baseSize.x - 1);
+    int y0 = std::min((int)(uvMin.y * baseSize.y), baseSize.y - 1);
+    int x1 = std::min((int)(uvMax.x * baseSize.x), baseSize.x - 1);
+    int y1 = std::min((int)(uvMax.y * baseSize.y), baseSize.y - 1);
+
+    size_t level = 0;
+    while ((x1 - x0 > 1 || y1 - y0 > 1) && level + 1 < m_Levels.size())
+    {
+        level++;
+        const glm::ivec2& size = m_CPULevelSizes[level];
+        x0 = std::min(x0 / 2, size.x - 1); x1 = std::min(x1 / 2, size.x - 1);
+        y0 = std::min(y0 / 2, size.y - 1); y1 = std::min(y1 / 2, size.y - 1);
+    }
+
+    const std::vector<float>& depth = m_Levels[level];
+    int width = m_CPULevelSizes[level].x;
+    float farthest = 0.0f;
+    for (int y = y0; y <= y1; y++)
+        for (int x = x0; x <= x1; x++)
+            farthest = std::max(farthest, depth[y * width + x]);
+
+    return nearestDepth > farthest;
+}
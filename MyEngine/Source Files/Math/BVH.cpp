@@ -0,0 +1,529 @@
+//
+//  BVH.cpp
+//  MyEngine
+//
+//  Created by Priyanshu Kaushik on 19/10/2026.
+//
+
+#include "Math/BVH.h"
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+
+// NODE POOL
+
+int BVH::AllocateNode()
+{
+    if (m_FreeList != -1)
+    {
+        int index = m_FreeList;
+        m_FreeList = m_Nodes[index].parent;
+        m_Nodes[index] = Node();
+        return index;
+    }
+    m_Nodes.emplace_back();
+    return static_cast<int>(m_Nodes.size()) - 1;
+}
+
+void BVH::FreeNode(int index)
+{
+    // Free nodes are chained through their parent field
+    m_Nodes[index].parent = m_FreeList;
+    m_FreeList = index;
+}
+
+void BVH::Clear()
+{
+    m_Nodes.clear();
+    m_Leaves.clear();
+    m_Root = -1;
+    m_FreeList = -1;
+    m_BuiltCost = 0.0f;
+    m_ChangesSinceBuild = 0;
+}
+
+// INSERT / REMOVE / UPDATE
+
+void BVH::Insert(Entity entity, const AABB& box)
+{
+    if (Contains(entity)) {
+        Update(entity, box);
+        return;
+    }
+
+    int leaf = AllocateNode();
+    m_Nodes[leaf].box = AABB(box.min - glm::vec3(FAT_MARGIN), box.max + glm::vec3(FAT_MARGIN));
+    m_Nodes[leaf].entity = entity;
+    InsertLeaf(leaf);
+
+    m_Leaves[entity] = leaf;
+    m_ChangesSinceBuild++;
+}
+
+void BVH::Remove(Entity entity)
+{
+    auto it = m_Leaves.find(entity);
+    if (it == m_Leaves.end()) return;
+
+    RemoveLeaf(it->second);
+    FreeNode(it->second);
+    m_Leaves.erase(it);
+    m_ChangesSinceBuild++;
+}
+
+bool BVH::Update(Entity entity, const AABB& box)
+{
+    auto it = m_Leaves.find(entity);
+    if (it == m_Leaves.end()) {
+        Insert(entity, box);
+        return true;
+    }
+
+    int leaf = it->second;
+    if (m_Nodes[leaf].box.Contains(box)) return false;
+
+    AABB fatBox(box.min - glm::vec3(FAT_MARGIN), box.max + glm::vec3(FAT_MARGIN));
+
+    // Small moves: refit in place. Teleports: reinsert where the box now lives.
+    if (m_Nodes[leaf].box.Overlaps(fatBox))
+    {
+        m_Nodes[leaf].box = fatBox;
+        RefitAncestors(m_Nodes[leaf].parent);
+    }
+    else
+    {
+        RemoveLeaf(leaf);
+        m_Nodes[leaf].box = fatBox;
+        InsertLeaf(leaf);
+    }
+
+    m_ChangesSinceBuild++;
+    return true;
+}
+
+// Walks down picking the child with the lowest SAH increase (Box2D style branch and bound)
+void BVH::InsertLeaf(int leaf)
+{
+    if (m_Root == -1)
+    {
+        m_Root = leaf;
+        m_Nodes[leaf].parent = -1;
+        return;
+    }
+
+    AABB leafBox = m_Nodes[leaf].box;
+    int index = m_Root;
+
+    while (!m_Nodes[index].IsLeaf())
+    {
+        const Node& node = m_Nodes[index];
+        float area = node.box.SurfaceArea();
+        float combinedArea = AABB::Union(node.box, leafBox).SurfaceArea();
+
+        // Cost of pairing the leaf with this node, and the cost pushed onto children
+        float cost = 2.0f * combinedArea;
+        float inheritanceCost = 2.0f * (combinedArea - area);
+
+        auto childCost = [&](int child)
+        {
+            const Node& c = m_Nodes[child];
+            float unionArea = AABB::Union(leafBox, c.box).SurfaceArea();
+            return c.IsLeaf() ? unionArea + inheritanceCost
+                              : unionArea - c.box.SurfaceArea() + inheritanceCost;
+        };
+
+        float costLeft = childCost(node.left);
+        float costRight = childCost(node.right);
+
+        if (cost < costLeft && cost < costRight) break;
+        index = costLeft < costRight ? node.left : node.right;
+    }
+
+    int sibling = index;
+    int oldParent = m_Nodes[sibling].parent;
+    int newParent = AllocateNode();
+
+    m_Nodes[newParent].parent = oldParent;
+    m_Nodes[newParent].box = AABB::Union(leafBox, m_Nodes[sibling].box);
+    m_Nodes[newParent].left = sibling;
+    m_Nodes[newParent].right = leaf;
+    m_Nodes[sibling].parent = newParent;
+    m_Nodes[leaf].parent = newParent;
+
+    if (oldParent == -1) m_Root = newParent;
+    else if (m_Nodes[oldParent].left == sibling) m_Nodes[oldParent].left = newParent;
+    else m_Nodes[oldParent].right = newParent;
+
+    RefitAncestors(oldParent);
+}
+
+void BVH::RemoveLeaf(int leaf)
+{
+    if (leaf == m_Root)
+    {
+        m_Root = -1;
+        return;
+    }
+
+    int parent = m_Nodes[leaf].parent;
+    int grandParent = m_Nodes[parent].parent;
+    int sibling = m_Nodes[parent].left == leaf ? m_Nodes[parent].right : m_Nodes[parent].left;
+
+    if (grandParent != -1)
+    {
+        if (m_Nodes[grandParent].left == parent) m_Nodes[grandParent].left = sibling;
+        else m_Nodes[grandParent].right = sibling;
+        m_Nodes[sibling].parent = grandParent;
+        FreeNode(parent);
+        RefitAncestors(grandParent);
+    }
+    else
+    {
+        m_Root = sibling;
+        m_Nodes[sibling].parent = -1;
+        FreeNode(parent);
+    }
+    m_Nodes[leaf].parent = -1;
+}
+
+void BVH::RefitAncestors(int index)
+{
+    while (index != -1)
+    {
+        Node& node = m_Nodes[index];
+        node.box = AABB::Union(m_Nodes[node.left].box, m_Nodes[node.right].box);
+        index = node.parent;
+    }
+}
+
+void BVH::Refit()
+{
+    if (m_Root == -1) return;
+
+    // Pre-order list of internal nodes, processed in reverse so children come first
+    std::vector<int> order;
+    m_Stack.clear();
+    m_Stack.push_back(m_Root);
+    while (!m_Stack.empty())
+    {
+        int index = m_Stack.back();
+        m_Stack.pop_back();
+        if (m_Nodes[index].IsLeaf()) continue;
+
+        order.push_back(index);
+        m_Stack.push_back(m_Nodes[index].left);
+        m_Stack.push_back(m_Nodes[index].right);
+    }
+
+    for (auto it = order.rbegin(); it != order.rend(); ++it)
+    {
+        Node& node = m_Nodes[*it];
+        node.box = AABB::Union(m_Nodes[node.left].box, m_Nodes[node.right].box);
+    }
+}
+
+// SAH REBUILD
+
+void BVH::Rebuild()
+{
+    // Keep the leaves, drop every internal node and compact the pool
+    std::vector<Node> leaves;
+    leaves.reserve(m_Leaves.size());
+    for (const auto& [entity, index] : m_Leaves)
+        leaves.push_back(m_Nodes[index]);
+
+    m_Nodes.clear();
+    m_Nodes.reserve(leaves.size() * 2);
+    m_FreeList = -1;
+    m_Root = -1;
+
+    std::vector<int> leafIndices;
+    leafIndices.reserve(leaves.size());
+    for (const Node& leaf : leaves)
+    {
+        int index = AllocateNode();
+        m_Nodes[index].box = leaf.box;
+        m_Nodes[index].entity = leaf.entity;
+        m_Leaves[leaf.entity] = index;
+        leafIndices.push_back(index);
+    }
+
+    if (!leafIndices.empty())
+    {
+        m_Root = BuildRecursive(leafIndices, 0, leafIndices.size());
+        m_Nodes[m_Root].parent = -1;
+    }
+
+    m_BuiltCost = GetCost();
+    m_ChangesSinceBuild = 0;
+}
+
+int BVH::BuildRecursive(std::vector<int>& leaves, size_t begin, size_t end)
+{
+    size_t count = end - begin;
+    if (count == 1) return leaves[begin];
+
+    AABB bounds, centroidBounds;
+    for (size_t i = begin; i < end; i++)
+    {
+        const AABB& box = m_Nodes[leaves[i]].box;
+        bounds.Expand(box);
+        centroidBounds.Expand(box.GetCenter());
+    }
+
+    glm::vec3 extent = centroidBounds.max - centroidBounds.min;
+    int axis = 0;
+    if (extent.y > extent[axis]) axis = 1;
+    if (extent.z > extent[axis]) axis = 2;
+
+    size_t mid = begin + count / 2;
+
+    if (extent[axis] > 1e-6f)
+    {
+        // Bin centroids along the widest axis and pick the cheapest split plane
+        struct Bin { AABB box; int count = 0; };
+        Bin bins[SAH_BINS];
+        float scale = SAH_BINS / extent[axis];
+
+        auto binOf = [&](int leaf)
+        {
+            int b = static_cast<int>((m_Nodes[leaf].box.GetCenter()[axis] - centroidBounds.min[axis]) * scale);
+            return std::min(b, SAH_BINS - 1);
+        };
+
+        for (size_t i = begin; i < end; i++)
+        {
+            Bin& bin = bins[binOf(leaves[i])];
+            bin.box.Expand(m_Nodes[leaves[i]].box);
+            bin.count++;
+        }
+
+        // Sweep from the right to get suffix areas/counts
+        float rightArea[SAH_BINS];
+        int rightCount[SAH_BINS];
+        AABB accum;
+        int accumCount = 0;
+        for (int b = SAH_BINS - 1; b > 0; b--)
+        {
+            if (bins[b].count) accum.Expand(bins[b].box);
+            accumCount += bins[b].count;
+            rightArea[b] = accumCount ? accum.SurfaceArea() : 0.0f;
+            rightCount[b] = accumCount;
+        }
+
+        float bestCost = FLT_MAX;
+        int bestSplit = -1;
+        accum = AABB();
+        accumCount = 0;
+        for (int b = 0; b < SAH_BINS - 1; b++)
+        {
+            if (bins[b].count) accum.Expand(bins[b].box);
+            accumCount += bins[b].count;
+            if (accumCount == 0 || rightCount[b + 1] == 0) continue;
+
+            float cost = accumCount * accum.SurfaceArea() + rightCount[b + 1] * rightArea[b + 1];
+            if (cost < bestCost) {
+                bestCost = cost;
+                bestSplit = b;
+            }
+        }
+
+        if (bestSplit != -1)
+        {
+            auto it = std::partition(leaves.begin() + begin, leaves.begin() + end,
+                                     [&](int leaf) { return binOf(leaf) <= bestSplit; });
+            mid = static_cast<size_t>(it - leaves.begin());
+        }
+    }
+
+    // Degenerate split (all centroids in one bin): fall back to a median split
+    if (mid == begin || mid == end)
+    {
+        mid = begin + count / 2;
+        std::nth_element(leaves.begin() + begin, leaves.begin() + mid, leaves.begin() + end,
+                         [&](int a, int b) { return m_Nodes[a].box.GetCenter()[axis] < m_Nodes[b].box.GetCenter()[axis]; });
+    }
+
+    int node = AllocateNode();
+    int left = BuildRecursive(leaves, begin, mid);
+    int right = BuildRecursive(leaves, mid, end);
+
+    m_Nodes[node].left = left;
+    m_Nodes[node].right = right;
+    m_Nodes[node].box = bounds;
+    m_Nodes[left].parent = node;
+    m_Nodes[right].parent = node;
+    return node;
+}
+
+float BVH::GetCost() const
+{
+    if (m_Root == -1 || m_Nodes[m_Root].IsLeaf()) return 0.0f;
+
+    float total = 0.0f;
+    m_Stack.clear();
+    m_Stack.push_back(m_Root);
+    while (!m_Stack.empty())
+    {
+        const Node& node = m_Nodes[m_Stack.back()];
+        m_Stack.pop_back();
+        if (node.IsLeaf()) continue;
+
+        total += node.box.SurfaceArea();
+        m_Stack.push_back(node.left);
+        m_Stack.push_back(node.right);
+    }
+
+    float rootArea = m_Nodes[m_Root].box.SurfaceArea();
+    return rootArea > 0.0f ? total / rootArea : 0.0f;
+}
+
+bool BVH::NeedsRebuild() const
+{
+    if (m_ChangesSinceBuild == 0 || m_Leaves.size() < 8) return false;
+    if (m_BuiltCost <= 0.0f) return true;
+    return GetCost() > m_BuiltCost * REBUILD_COST_RATIO;
+}
+
+// QUERIES
+
+void BVH::QueryAABB(const AABB& box, std::vector<Entity>& outEntities) const
+{
+    if (m_Root == -1) return;
+
+    m_Stack.clear();
+    m_Stack.push_back(m_Root);
+    while (!m_Stack.empty())
+    {
+        const Node& node = m_Nodes[m_Stack.back()];
+        m_Stack.pop_back();
+        if (!node.box.Overlaps(box)) continue;
+
+        if (node.IsLeaf()) outEntities.push_back(node.entity);
+        else {
+            m_Stack.push_back(node.left);
+            m_Stack.push_back(node.right);
+        }
+    }
+}
+
+void BVH::QueryFrustum(const Frustum& frustum, std::vector<Entity>& outInside, std::vector<Entity>* outPartial) const
+{
+    if (m_Root == -1) return;
+
+    // Nodes known to be fully inside are pushed as ~index and skip the plane tests
+    m_Stack.clear();
+    m_Stack.push_back(m_Root);
+    while (!m_Stack.empty())
+    {
+        int entry = m_Stack.back();
+        m_Stack.pop_back();
+
+        bool inside = entry < 0;
+        const Node& node = m_Nodes[inside ? ~entry : entry];
+
+        if (!inside)
+        {
+            if (node.IsLeaf() && outPartial) {
+                outPartial->push_back(node.entity);
+                continue;
+            }
+
+            Frustum::TestResult result = frustum.ClassifyAABB(node.box);
+            if (result == Frustum::TestResult::Outside) continue;
+            inside = result == Frustum::TestResult::Inside;
+        }
+
+        if (node.IsLeaf()) outInside.push_back(node.entity);
+        else if (inside) {
+            m_Stack.push_back(~node.left);
+            m_Stack.push_back(~node.right);
+        }
+        else {
+            m_Stack.push_back(node.left);
+            m_Stack.push_back(node.right);
+        }
+    }
+}
+
+bool BVH::Raycast(const glm::vec3& origin, const glm::vec3& direction, float maxDistance,
+                  RayHit& outHit, const RayFilter& filter) const
+{
+    if (m_Root == -1) return false;
+
+    glm::vec3 dir = glm::normalize(direction);
+    glm::vec3 invDir = 1.0f / dir;
+    float closest = maxDistance;
+    bool hit = false;
+
+    m_Stack.clear();
+    m_Stack.push_back(m_Root);
+    while (!m_Stack.empty())
+    {
+        const Node& node = m_Nodes[m_Stack.back()];
+        m_Stack.pop_back();
+
+        float tEntry;
+        if (!node.box.IntersectsRay(origin, invDir, closest, tEntry)) continue;
+
+        if (node.IsLeaf())
+        {
+            float distance = tEntry;
+            if (filter && !filter(node.entity, distance)) continue;
+            if (distance > closest) continue;
+
+            closest = distance;
+            outHit.entity = node.entity;
+            outHit.distance = distance;
+            hit = true;
+            continue;
+        }
+
+        // Visit the nearer child first so the far one is more likely to be pruned
+        float tLeft, tRight;
+        bool hitLeft = m_Nodes[node.left].box.IntersectsRay(origin, invDir, closest, tLeft);
+        bool hitRight = m_Nodes[node.right].box.IntersectsRay(origin, invDir, closest, tRight);
+
+        if (hitLeft && hitRight) {
+            m_Stack.push_back(tLeft < tRight ? node.right : node.left);
+            m_Stack.push_back(tLeft < tRight ? node.left : node.right);
+        }
+        else if (hitLeft) m_Stack.push_back(node.left);
+        else if (hitRight) m_Stack.push_back(node.right);
+    }
+    return hit;
+}
+
+bool BVH::QueryNearest(const glm::vec3& point, float maxDistance, Entity& outEntity, float& outDistance) const
+{
+    if (m_Root == -1) return false;
+
+    float bestSq = maxDistance * maxDistance;
+    bool found = false;
+
+    m_Stack.clear();
+    m_Stack.push_back(m_Root);
+    while (!m_Stack.empty())
+    {
+        const Node& node = m_Nodes[m_Stack.back()];
+        m_Stack.pop_back();
+
+        if (node.box.DistanceSq(point) > bestSq) continue;
+
+        if (node.IsLeaf())
+        {
+            bestSq = node.box.DistanceSq(point);
+            outEntity = node.entity;
+            found = true;
+            continue;
+        }
+
+        float dLeft = m_Nodes[node.left].box.DistanceSq(point);
+        float dRight = m_Nodes[node.right].box.DistanceSq(point);
+        m_Stack.push_back(dLeft < dRight ? node.right : node.left);
+        m_Stack.push_back(dLeft < dRight ? node.left : node.right);
+    }
+
+    if (found) outDistance = std::sqrt(bestSq);
+    return found;
+}
@@ -6,9 +6,12 @@
 //
 
 #include "MeshManager.h"
+#include "MeshSimplifier.h"
+#include "MeshPool.h"
 #include <fstream>
 #include <sstream>
 #include <iostream>
+#include <cfloat>
 #include <sys/sysctl.h>
 #include <mach/mach.h>
 #include "GLAD/include/glad/glad.h"
@@ -43,6 +46,13 @@ bool MeshManager::LoadMesh(const std::string& path, Mesh* target)
     {
         std::cout<<"[Optimized] Loading Binary : " << binPath << std::endl;
         LoadMeshBinary(binPath, meshData);
+        
+        // Older caches were written before LODs existed, upgrade them in place
+        if (meshData.lods.empty() && !meshData.faces.empty()) {
+            GenerateLODs(meshData);
+            SaveMeshBinary(binPath, meshData);
+        }
+        CalculateBounds(meshData);
         *target = meshData;
         return true;
     }
@@ -143,6 +153,10 @@ bool MeshManager::LoadMesh(const std::string& path, Mesh* target)
         // Tangents for Normal Mapping lighting calculations.
         CalculateTangents(meshData);
         
+        // 4. Simplified LOD chain + bounds for distance based selection
+        GenerateLODs(meshData);
+        CalculateBounds(meshData);
+        
         // 5. Save Binary file for next time
         SaveMeshBinary(binPath, meshData);
     }
@@ -284,6 +298,18 @@ bool MeshManager::SaveMeshBinary(const std::string &path, const Mesh &mesh)
     {
         out.write((char*)face.vertexIndices.data(), 3 * sizeof(int));
     }
+    
+    // LOD chain (LOD 0 is the faces above, only simplified levels are stored)
+    uint32_t lodCount = mesh.lods.empty() ? 0 : (uint32_t)mesh.lods.size() - 1;
+    out.write((char*)&lodCount, sizeof(uint32_t));
+    for (uint32_t i = 1; i <= lodCount; i++)
+    {
+        const MeshLOD& lod = mesh.lods[i];
+        uint32_t indexCount = (uint32_t)lod.indices.size();
+        out.write((char*)&indexCount, sizeof(uint32_t));
+        out.write((char*)&lod.error, sizeof(float));
+        out.write((char*)lod.indices.data(), indexCount * sizeof(uint32_t));
+    }
 
     out.close();
     
@@ -322,13 +348,37 @@ bool MeshManager::LoadMeshBinary(const std::string &path, Mesh &outMesh)
         
         outMesh.faces.push_back(face);
     }
+    
+    // LOD chain, missing in caches written before LOD support
+    outMesh.lods.clear();
+    uint32_t lodCount = 0;
+    if (in.read((char*)&lodCount, sizeof(uint32_t)))
+    {
+        outMesh.lods.resize(lodCount + 1);
+        for (uint32_t i = 1; i <= lodCount; i++)
+        {
+            MeshLOD& lod = outMesh.lods[i];
+            uint32_t indexCount = 0;
+            in.read((char*)&indexCount, sizeof(uint32_t));
+            in.read((char*)&lod.error, sizeof(float));
+            lod.indices.resize(indexCount);
+            in.read((char*)lod.indices.data(), indexCount * sizeof(uint32_t));
+        }
+        
+        // LOD 0 mirrors the face list
+        outMesh.lods[0].indices.reserve(outMesh.faces.size() * 3);
+        for (const Face& face : outMesh.faces)
+            outMesh.lods[0].indices.insert(outMesh.lods[0].indices.end(), face.vertexIndices.begin(), face.vertexIndices.end());
+        
+        if (!in) outMesh.lods.clear();
+    }
 
     in.close();
     return true;
 }
 
 // MEMORY CLEANUP
-// Decrements reference count. If 0, deletes the GPU buffers (VAO/VBO/EBO).
+// Decrements reference count. If 0, returns its ranges to the MeshPool.
 
 void MeshManager::RemoveReference(const std::string& path)
 {
@@ -341,15 +391,14 @@ void MeshManager::RemoveReference(const std::string& path)
     Mesh* meshData = m_Meshes[iD];
     if (meshData) {
         // Free GPU Memory
-        if (meshData->VAO != 0) glDeleteVertexArrays(1, &meshData->VAO);
-        if (meshData->VBO != 0) glDeleteBuffers(1, &meshData->VBO);
-        if (meshData->EBO != 0) glDeleteBuffers(1, &meshData->EBO);
+        MeshPool::Get().Free(meshData);
 
         std::cout<<"Mesh Unloaded: " << path <<std::endl;
         meshData->vertices.clear();
         meshData->vertices.shrink_to_fit();
         meshData->faces.clear();
         meshData->faces.shrink_to_fit();
+        meshData->lods.clear();
         delete meshData;
     }
 
@@ -410,3 +459,58 @@ void MeshManager::CalculateTangents(Mesh& mesh)
         if (glm::length(v.tangent) > 0.0f) v.tangent = glm::normalize(v.tangent);
     }
 }
+
+// LOD GENERATION
+// Builds the LOD chain with quadric error simplification. Each level targets
+// half the triangles of the previous one; we stop early when the simplifier
+// can't make meaningful progress (flat/tiny meshes).
+
+void MeshManager::GenerateLODs(Mesh& mesh)
+{
+    mesh.lods.clear();
+    
+    MeshLOD base;
+    base.indices.reserve(mesh.faces.size() * 3);
+    for (const Face& face : mesh.faces)
+        base.indices.insert(base.indices.end(), face.vertexIndices.begin(), face.vertexIndices.end());
+    mesh.lods.push_back(std::move(base));
+    
+    for (int level = 1; level < MAX_LOD_COUNT; level++)
+    {
+        const std::vector<uint32_t>& previous = mesh.lods.back().indices;
+        size_t target = (previous.size() / 6) * 3;
+        if (target < 36) break;
+        
+        MeshLOD lod;
+        lod.indices = MeshSimplifier::Simplify(mesh.vertices, previous, target, lod.error);
+        
+        // Less than 10% reduction isn't worth another level
+        if (lod.indices.empty() || lod.indices.size() * 10 > previous.size() * 9) break;
+        
+        std::cout << "[LOD] Level " << level << ": " << lod.indices.size() / 3 << " Triangles (error " << lod.error << ")" << std::endl;
+        mesh.lods.push_back(std::move(lod));
+    }
+}
+
+// BOUNDS
+// Local space AABB (frustum culling) and bounding sphere around its center (LOD selection).
+
+void MeshManager::CalculateBounds(Mesh& mesh)
+{
+    if (mesh.vertices.empty()) return;
+    
+    glm::vec3 minP(FLT_MAX), maxP(-FLT_MAX);
+    for (const auto& v : mesh.vertices) {
+        minP = glm::min(minP, v.position);
+        maxP = glm::max(maxP, v.position);
+    }
+    
+    mesh.bounds = AABB(minP, maxP);
+    mesh.boundsCenter = (minP + maxP) * 0.5f;
+    float radiusSq = 0.0f;
+    for (const auto& v : mesh.vertices) {
+        glm::vec3 d = v.position - mesh.boundsCenter;
+        radiusSq = std::max(radiusSq, glm::dot(d, d));
+    }
+    mesh.boundsRadius = std::sqrt(radiusSq);
+}
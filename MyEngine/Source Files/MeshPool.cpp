@@ -0,0 +1,236 @@
+//
+//  MeshPool.cpp
+//  MyEngine
+//
+//  Created by Priyanshu Kaushik on 19/10/2026.
+//
+
+#include "MeshPool.h"
+#include "AssetData.h"
+#include <iostream>
+#include <algorithm>
+
+// RANGE ALLOCATOR
+
+void MeshPool::RangeAllocator::Reset(uint32_t capacity)
+{
+    m_FreeRanges.clear();
+    m_Capacity = capacity;
+    if (capacity > 0) m_FreeRanges[0] = capacity;
+}
+
+void MeshPool::RangeAllocator::Grow(uint32_t newCapacity)
+{
+    if (newCapacity <= m_Capacity) return;
+    Free(m_Capacity, newCapacity - m_Capacity);
+    m_Capacity = newCapacity;
+}
+
+bool MeshPool::RangeAllocator::Allocate(uint32_t count, uint32_t& outOffset)
+{
+    for (auto it = m_FreeRanges.begin(); it != m_FreeRanges.end(); ++it)
+    {
+        if (it->second < count) continue;
+
+        outOffset = it->first;
+        uint32_t remaining = it->second - count;
+        m_FreeRanges.erase(it);
+        if (remaining > 0) m_FreeRanges[outOffset + count] = remaining;
+        return true;
+    }
+    return false;
+}
+
+void MeshPool::RangeAllocator::Free(uint32_t offset, uint32_t count)
+{
+    if (count == 0) return;
+
+    auto next = m_FreeRanges.lower_bound(offset);
+
+    // Merge with the following range
+    if (next != m_FreeRanges.end() && offset + count == next->first) {
+        count += next->second;
+        next = m_FreeRanges.erase(next);
+    }
+
+    // Merge with the preceding range
+    if (next != m_FreeRanges.begin()) {
+        auto prev = std::prev(next);
+        if (prev->first + prev->second == offset) {
+            prev->second += count;
+            return;
+        }
+    }
+
+    m_FreeRanges[offset] = count;
+}
+
+// POOL
+
+bool MeshPool::SupportsMultiDrawIndirect()
+{
+    return GLAD_GL_ARB_multi_draw_indirect && GLAD_GL_ARB_base_instance;
+}
+
+void MeshPool::Init()
+{
+    if (m_VAO) return;
+
+    glGenVertexArrays(1, &m_VAO);
+    glGenBuffers(1, &m_VertexBuffer);
+    glGenBuffers(1, &m_IndexBuffer);
+
+    glBindVertexArray(m_VAO);
+
+    glBindBuffer(GL_ARRAY_BUFFER, m_VertexBuffer);
+    glBufferData(GL_ARRAY_BUFFER, (GLsizeiptr)INITIAL_VERTICES * VERTEX_STRIDE, nullptr, GL_STATIC_DRAW);
+
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_IndexBuffer);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, (GLsizeiptr)INITIAL_INDICES * sizeof(uint32_t), nullptr, GL_STATIC_DRAW);
+
+    SetupVertexAttributes();
+
+    // Instance Matrix (4 x vec4, one per instance). Pointers are set per pass by the renderer.
+    for (int column = 0; column < 4; column++) {
+        glEnableVertexAttribArray(INSTANCE_ATTRIB + column);
+        glVertexAttribDivisor(INSTANCE_ATTRIB + column, 1);
+    }
+
+    glBindVertexArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+    m_Vertices.Reset(INITIAL_VERTICES);
+    m_Indices.Reset(INITIAL_INDICES);
+
+    std::cout << "[Mesh Pool] Multi draw indirect: " << (SupportsMultiDrawIndirect() ? "Yes" : "No (per batch fallback)") << std::endl;
+}
+
+void MeshPool::Shutdown()
+{
+    if (m_VAO) glDeleteVertexArrays(1, &m_VAO);
+    if (m_VertexBuffer) glDeleteBuffers(1, &m_VertexBuffer);
+    if (m_IndexBuffer) glDeleteBuffers(1, &m_IndexBuffer);
+    m_VAO = m_VertexBuffer = m_IndexBuffer = 0;
+
+    m_Vertices.Reset(0);
+    m_Indices.Reset(0);
+    m_FreeHandles.clear();
+    m_NextHandle = 0;
+}
+
+// Expects the VAO and the vertex buffer to be bound
+void MeshPool::SetupVertexAttributes()
+{
+    // 1. Position
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, VERTEX_STRIDE, (void*)0);
+
+    // 2. Normal
+    glEnableVertexAttribArray(1);
+    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, VERTEX_STRIDE, (void*)(3 * sizeof(float)));
+
+    // 3. UV
+    glEnableVertexAttribArray(2);
+    glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, VERTEX_STRIDE, (void*)(6 * sizeof(float)));
+
+    // 4. Tangent
+    glEnableVertexAttribArray(3);
+    glVertexAttribPointer(3, 3, GL_FLOAT, GL_FALSE, VERTEX_STRIDE, (void*)(8 * sizeof(float)));
+}
+
+uint32_t MeshPool::AcquireHandle()
+{
+    if (!m_FreeHandles.empty()) {
+        uint32_t handle = m_FreeHandles.back();
+        m_FreeHandles.pop_back();
+        return handle;
+    }
+    return m_NextHandle++;
+}
+
+// GROWTH
+// Copies into a bigger buffer on the GPU, then re-attaches it to the VAO.
+
+void MeshPool::GrowBuffer(GLuint& buffer, GLenum target, size_t oldBytes, size_t newBytes)
+{
+    GLuint newBuffer = 0;
+    glGenBuffers(1, &newBuffer);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, newBuffer);
+    glBufferData(GL_COPY_WRITE_BUFFER, newBytes, nullptr, GL_STATIC_DRAW);
+
+    glBindBuffer(GL_COPY_READ_BUFFER, buffer);
+    glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, 0, 0, oldBytes);
+    glBindBuffer(GL_COPY_READ_BUFFER, 0);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+
+    glDeleteBuffers(1, &buffer);
+    buffer = newBuffer;
+
+    glBindVertexArray(m_VAO);
+    glBindBuffer(target, buffer);
+    if (target == GL_ARRAY_BUFFER) SetupVertexAttributes();
+    glBindVertexArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+    std::cout << "[Mesh Pool] Grew " << (target == GL_ARRAY_BUFFER ? "vertex" : "index") << " buffer to " << (newBytes / (1024 * 1024)) << " MB" << std::endl;
+}
+
+bool MeshPool::AllocateRange(RangeAllocator& allocator, GLuint& buffer, GLenum target, size_t elementSize, uint32_t count, uint32_t& outOffset)
+{
+    if (allocator.Allocate(count, outOffset)) return true;
+
+    uint32_t oldCapacity = allocator.GetCapacity();
+    uint32_t newCapacity = std::max(oldCapacity * 2, oldCapacity + count);
+    GrowBuffer(buffer, target, oldCapacity * elementSize, newCapacity * elementSize);
+    allocator.Grow(newCapacity);
+
+    return allocator.Allocate(count, outOffset);
+}
+
+// UPLOAD / FREE
+
+bool MeshPool::Upload(Mesh* mesh, const std::vector<float>& vertices, const std::vector<uint32_t>& indices)
+{
+    if (!mesh) return false;
+    Init();
+    Free(mesh);
+
+    uint32_t vertexCount = static_cast<uint32_t>(vertices.size() / VERTEX_FLOATS);
+    uint32_t indexCount = static_cast<uint32_t>(indices.size());
+
+    uint32_t baseVertex = 0, baseIndex = 0;
+    if (!AllocateRange(m_Vertices, m_VertexBuffer, GL_ARRAY_BUFFER, VERTEX_STRIDE, vertexCount, baseVertex)) return false;
+    if (!AllocateRange(m_Indices, m_IndexBuffer, GL_ELEMENT_ARRAY_BUFFER, sizeof(uint32_t), indexCount, baseIndex)) {
+        m_Vertices.Free(baseVertex, vertexCount);
+        return false;
+    }
+
+    // Copy targets, so the element buffer bound to whatever VAO is current is untouched
+    glBindBuffer(GL_COPY_WRITE_BUFFER, m_VertexBuffer);
+    glBufferSubData(GL_COPY_WRITE_BUFFER, (GLintptr)baseVertex * VERTEX_STRIDE, vertices.size() * sizeof(float), vertices.data());
+    glBindBuffer(GL_COPY_WRITE_BUFFER, m_IndexBuffer);
+    glBufferSubData(GL_COPY_WRITE_BUFFER, (GLintptr)baseIndex * sizeof(uint32_t), indices.size() * sizeof(uint32_t), indices.data());
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+
+    mesh->poolHandle = AcquireHandle();
+    mesh->baseVertex = baseVertex;
+    mesh->vertexCount = vertexCount;
+    mesh->baseIndex = baseIndex;
+    mesh->poolIndexCount = indexCount;
+    return true;
+}
+
+void MeshPool::Free(Mesh* mesh)
+{
+    if (!mesh || mesh->poolHandle == UINT32_MAX) return;
+
+    m_Vertices.Free(mesh->baseVertex, mesh->vertexCount);
+    m_Indices.Free(mesh->baseIndex, mesh->poolIndexCount);
+    m_FreeHandles.push_back(mesh->poolHandle);
+
+    mesh->poolHandle = UINT32_MAX;
+    mesh->baseVertex = 0;
+    mesh->vertexCount = 0;
+    mesh->baseIndex = 0;
+    mesh->poolIndexCount = 0;
+}
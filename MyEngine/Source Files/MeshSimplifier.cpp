@@ -0,0 +1,288 @@
+//
+//  MeshSimplifier.cpp
+//  MyEngine
+//
+//  Created by Priyanshu Kaushik on 19/10/2026.
+//
+
+#include "MeshSimplifier.h"
+#include <unordered_map>
+#include <queue>
+#include <array>
+#include <cstring>
+#include <algorithm>
+#include <glm/glm.hpp>
+
+namespace {
+
+// Symmetric 4x4 error quadric, stored as its 10 unique coefficients.
+struct Quadric
+{
+    double a2 = 0, ab = 0, ac = 0, ad = 0;
+    double b2 = 0, bc = 0, bd = 0;
+    double c2 = 0, cd = 0;
+    double d2 = 0;
+
+    static Quadric FromPlane(const glm::vec3& n, float d, double weight)
+    {
+        Quadric q;
+        q.a2 = weight * n.x * n.x; q.ab = weight * n.x * n.y; q.ac = weight * n.x * n.z; q.ad = weight * n.x * d;
+        q.b2 = weight * n.y * n.y; q.bc = weight * n.y * n.z; q.bd = weight * n.y * d;
+        q.c2 = weight * n.z * n.z; q.cd = weight * n.z * d;
+        q.d2 = weight * d * d;
+        return q;
+    }
+
+    Quadric& operator+=(const Quadric& o)
+    {
+        a2 += o.a2; ab += o.ab; ac += o.ac; ad += o.ad;
+        b2 += o.b2; bc += o.bc; bd += o.bd;
+        c2 += o.c2; cd += o.cd;
+        d2 += o.d2;
+        return *this;
+    }
+
+    // v^T * Q * v for v = (x, y, z, 1)
+    double Evaluate(const glm::vec3& p) const
+    {
+        double x = p.x, y = p.y, z = p.z;
+        return a2 * x * x + 2.0 * ab * x * y + 2.0 * ac * x * z + 2.0 * ad * x
+             + b2 * y * y + 2.0 * bc * y * z + 2.0 * bd * y
+             + c2 * z * z + 2.0 * cd * z
+             + d2;
+    }
+};
+
+struct PositionKey
+{
+    uint32_t x, y, z;
+    bool operator==(const PositionKey& o) const { return x == o.x && y == o.y && z == o.z; }
+};
+
+struct PositionKeyHash
+{
+    size_t operator()(const PositionKey& k) const
+    {
+        size_t h = k.x * 73856093u;
+        h ^= k.y * 19349663u;
+        h ^= k.z * 83492791u;
+        return h;
+    }
+};
+
+struct Collapse
+{
+    double error;
+    uint32_t from, to;
+    uint32_t fromVersion, toVersion;
+
+    bool operator>(const Collapse& o) const { return error > o.error; }
+};
+
+PositionKey MakeKey(const glm::vec3& p)
+{
+    PositionKey k;
+    std::memcpy(&k.x, &p.x, sizeof(float));
+    std::memcpy(&k.y, &p.y, sizeof(float));
+    std::memcpy(&k.z, &p.z, sizeof(float));
+    return k;
+}
+
+uint64_t EdgeKey(uint32_t a, uint32_t b)
+{
+    if (a > b) std::swap(a, b);
+    return (uint64_t(a) << 32) | b;
+}
+
+}
+
+std::vector<uint32_t> MeshSimplifier::Simplify(const std::vector<Vertex>& vertices,
+                                               const std::vector<uint32_t>& indices,
+                                               size_t targetIndexCount,
+                                               float& outError)
+{
+    outError = 0.0f;
+    if (indices.size() < 3 || indices.size() <= targetIndexCount) return indices;
+
+    // 1. Weld vertices that share a position so edges become shared between faces
+    std::unordered_map<PositionKey, uint32_t, PositionKeyHash> weldMap;
+    std::vector<uint32_t> weldID(vertices.size());
+    std::vector<glm::vec3> positions;
+    std::vector<uint32_t> representative;
+    weldMap.reserve(vertices.size());
+
+    for (uint32_t i = 0; i < vertices.size(); i++)
+    {
+        auto result = weldMap.emplace(MakeKey(vertices[i].position), (uint32_t)positions.size());
+        if (result.second) {
+            positions.push_back(vertices[i].position);
+            representative.push_back(i);
+        }
+        weldID[i] = result.first->second;
+    }
+
+    // 2. Build welded triangles + vertex -> triangle adjacency
+    size_t triCount = indices.size() / 3;
+    std::vector<std::array<uint32_t, 3>> tris;
+    std::vector<std::array<uint32_t, 3>> originalCorners;
+    tris.reserve(triCount);
+    originalCorners.reserve(triCount);
+
+    for (size_t t = 0; t < triCount; t++)
+    {
+        std::array<uint32_t, 3> w = { weldID[indices[t * 3]], weldID[indices[t * 3 + 1]], weldID[indices[t * 3 + 2]] };
+        if (w[0] == w[1] || w[1] == w[2] || w[0] == w[2]) continue;
+        tris.push_back(w);
+        originalCorners.push_back({ indices[t * 3], indices[t * 3 + 1], indices[t * 3 + 2] });
+    }
+
+    std::vector<std::vector<uint32_t>> adjacency(positions.size());
+    for (uint32_t t = 0; t < tris.size(); t++)
+        for (uint32_t c = 0; c < 3; c++) adjacency[tris[t][c]].push_back(t);
+
+    // 3. Plane quadrics per vertex (area weighted) + border constraints
+    std::vector<Quadric> quadrics(positions.size());
+    std::unordered_map<uint64_t, int> edgeUse;
+    edgeUse.reserve(tris.size() * 3);
+
+    for (const auto& tri : tris)
+    {
+        glm::vec3 p0 = positions[tri[0]], p1 = positions[tri[1]], p2 = positions[tri[2]];
+        glm::vec3 n = glm::cross(p1 - p0, p2 - p0);
+        float area = glm::length(n);
+        if (area < 1e-12f) continue;
+        n /= area;
+
+        Quadric q = Quadric::FromPlane(n, -glm::dot(n, p0), area * 0.5);
+        for (uint32_t c = 0; c < 3; c++) {
+            quadrics[tri[c]] += q;
+            edgeUse[EdgeKey(tri[c], tri[(c + 1) % 3])]++;
+        }
+    }
+
+    // Open borders get a heavy perpendicular plane so silhouettes don't erode
+    const double borderWeight = 1000.0;
+    for (const auto& tri : tris)
+    {
+        glm::vec3 p0 = positions[tri[0]], p1 = positions[tri[1]], p2 = positions[tri[2]];
+        glm::vec3 faceNormal = glm::cross(p1 - p0, p2 - p0);
+        if (glm::length(faceNormal) < 1e-12f) continue;
+        faceNormal = glm::normalize(faceNormal);
+
+        for (uint32_t c = 0; c < 3; c++)
+        {
+            uint32_t a = tri[c], b = tri[(c + 1) % 3];
+            if (edgeUse[EdgeKey(a, b)] != 1) continue;
+
+            glm::vec3 edge = positions[b] - positions[a];
+            float edgeLength = glm::length(edge);
+            if (edgeLength < 1e-12f) continue;
+
+            glm::vec3 n = glm::normalize(glm::cross(edge, faceNormal));
+            Quadric q = Quadric::FromPlane(n, -glm::dot(n, positions[a]), borderWeight * edgeLength * edgeLength);
+            quadrics[a] += q;
+            quadrics[b] += q;
+        }
+    }
+
+    // 4. Seed the collapse queue with every unique edge (cheapest direction)
+    std::vector<uint32_t> version(positions.size(), 0);
+    std::vector<uint32_t> remap(positions.size());
+    for (uint32_t i = 0; i < remap.size(); i++) remap[i] = i;
+
+    std::priority_queue<Collapse, std::vector<Collapse>, std::greater<Collapse>> queue;
+
+    auto pushEdge = [&](uint32_t a, uint32_t b)
+    {
+        Quadric q = quadrics[a];
+        q += quadrics[b];
+        double errorAB = q.Evaluate(positions[b]);
+        double errorBA = q.Evaluate(positions[a]);
+        if (errorAB <= errorBA) queue.push({ errorAB, a, b, version[a], version[b] });
+        else                    queue.push({ errorBA, b, a, version[b], version[a] });
+    };
+
+    for (const auto& [key, count] : edgeUse)
+        pushEdge((uint32_t)(key >> 32), (uint32_t)(key & 0xffffffffu));
+
+    // 5. Collapse until we hit the triangle budget
+    std::vector<bool> removed(tris.size(), false);
+    size_t liveTris = tris.size();
+    size_t targetTris = targetIndexCount / 3;
+    double maxError = 0.0;
+
+    while (liveTris > targetTris && !queue.empty())
+    {
+        Collapse c = queue.top();
+        queue.pop();
+
+        if (remap[c.from] != c.from || remap[c.to] != c.to) continue;
+        if (version[c.from] != c.fromVersion || version[c.to] != c.toVersion) continue;
+
+        // Reject collapses that would flip a surviving triangle
+        bool flips = false;
+        for (uint32_t t : adjacency[c.from])
+        {
+            if (removed[t]) continue;
+            const auto& tri = tris[t];
+            if (tri[0] == c.to || tri[1] == c.to || tri[2] == c.to) continue;
+
+            glm::vec3 p[3], q[3];
+            for (int k = 0; k < 3; k++) {
+                p[k] = positions[tri[k]];
+                q[k] = tri[k] == c.from ? positions[c.to] : p[k];
+            }
+            glm::vec3 before = glm::cross(p[1] - p[0], p[2] - p[0]);
+            glm::vec3 after  = glm::cross(q[1] - q[0], q[2] - q[0]);
+            float lenBefore = glm::length(before), lenAfter = glm::length(after);
+            if (lenAfter < 1e-12f || glm::dot(before, after) < 0.2f * lenBefore * lenAfter) {
+                flips = true;
+                break;
+            }
+        }
+        if (flips) continue;
+
+        remap[c.from] = c.to;
+        quadrics[c.to] += quadrics[c.from];
+        maxError = std::max(maxError, c.error);
+
+        for (uint32_t t : adjacency[c.from])
+        {
+            if (removed[t]) continue;
+            auto& tri = tris[t];
+            for (int k = 0; k < 3; k++) if (tri[k] == c.from) tri[k] = c.to;
+
+            if (tri[0] == tri[1] || tri[1] == tri[2] || tri[0] == tri[2]) {
+                removed[t] = true;
+                liveTris--;
+            }
+            else adjacency[c.to].push_back(t);
+        }
+        adjacency[c.from].clear();
+        version[c.from]++;
+        version[c.to]++;
+
+        // Re-evaluate every edge around the surviving vertex
+        for (uint32_t t : adjacency[c.to])
+        {
+            if (removed[t]) continue;
+            for (uint32_t n : tris[t]) if (n != c.to) pushEdge(c.to, n);
+        }
+    }
+
+    // 6. Map welded corners back to real vertices (keep original corner when it didn't move)
+    std::vector<uint32_t> result;
+    result.reserve(liveTris * 3);
+    for (uint32_t t = 0; t < tris.size(); t++)
+    {
+        if (removed[t]) continue;
+        for (int k = 0; k < 3; k++)
+        {
+            uint32_t original = originalCorners[t][k];
+            result.push_back(weldID[original] == tris[t][k] ? original : representative[tris[t][k]]);
+        }
+    }
+
+    outError = (float)maxError;
+    return result;
+}
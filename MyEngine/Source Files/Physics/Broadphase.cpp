@@ -0,0 +1,330 @@
+//
+//  Broadphase.cpp
+//  MyEngine
+//
+//  Created by Priyanshu Kaushik on 19/10/2026.
+//
+
+#include "Physics/Broadphase.h"
+#include <algorithm>
+#include <cmath>
+#include <cfloat>
+
+void Broadphase::SetProxy(Entity entity, const glm::vec3& min, const glm::vec3& max, bool isStatic)
+{
+    auto it = m_ProxyIndex.find(entity);
+    if (it == m_ProxyIndex.end())
+    {
+        m_ProxyIndex[entity] = (uint32_t)m_Proxies.size();
+        m_Proxies.push_back({ min, max, entity, isStatic, true });
+        return;
+    }
+
+    Proxy& proxy = m_Proxies[it->second];
+    proxy.min = min;
+    proxy.max = max;
+    proxy.isStatic = isStatic;
+    proxy.touched = true;
+}
+
+void Broadphase::RemoveProxy(Entity entity)
+{
+    auto it = m_ProxyIndex.find(entity);
+    if (it == m_ProxyIndex.end()) return;
+
+    // Last proxy moves into the hole
+    uint32_t index = it->second;
+    m_ProxyIndex.erase(it);
+    if (index != m_Proxies.size() - 1)
+    {
+        m_Proxies[index] = m_Proxies.back();
+        m_ProxyIndex[m_Proxies[index].entity] = index;
+    }
+    m_Proxies.pop_back();
+}
+
+void Broadphase::Clear()
+{
+    m_Proxies.clear();
+    m_ProxyIndex.clear();
+    m_Pairs.clear();
+}
+
+void Broadphase::DropStaleProxies()
+{
+    uint32_t live = 0;
+    for (uint32_t i = 0; i < m_Proxies.size(); i++)
+    {
+        if (!m_Proxies[i].touched)
+        {
+            m_ProxyIndex.erase(m_Proxies[i].entity);
+            continue;
+        }
+        if (live != i)
+        {
+            m_Proxies[live] = m_Proxies[i];
+            m_ProxyIndex[m_Proxies[live].entity] = live;
+        }
+        live++;
+    }
+    m_Proxies.resize(live);
+}
+
+// Twice the median of the proxies' largest side: a typical box covers 1-2 cells per axis,
+// and a few huge boxes (ground, walls) cannot blow the cell size up
+void Broadphase::ChooseCellSize()
+{
+    m_Sizes.resize(m_Proxies.size());
+    for (size_t i = 0; i < m_Proxies.size(); i++)
+    {
+        glm::vec3 size = m_Proxies[i].max - m_Proxies[i].min;
+        m_Sizes[i] = std::max(size.x, std::max(size.y, size.z));
+    }
+
+    auto median = m_Sizes.begin() + m_Sizes.size() / 2;
+    std::nth_element(m_Sizes.begin(), median, m_Sizes.end());
+    m_CellSize = std::max(*median * 2.0f, 0.01f);
+}
+
+// 21 bits per axis, wrapping far out. A wrapped key can only merge cells, never lose a pair.
+uint64_t Broadphase::PackCell(int x, int y, int z) const
+{
+    const uint64_t mask = (1u << 21) - 1;
+    return ((uint64_t)(x & mask) << 42) | ((uint64_t)(y & mask) << 21) | (uint64_t)(z & mask);
+}
+
+glm::ivec3 Broadphase::CellOf(const glm::vec3& point) const
+{
+    float inverse = 1.0f / m_CellSize;
+    return glm::ivec3((int)std::floor(point.x * inverse), (int)std::floor(point.y * inverse), (int)std::floor(point.z * inverse));
+}
+
+bool Broadphase::Overlaps(uint32_t a, uint32_t b) const
+{
+    const Proxy& pa = m_Proxies[a];
+    const Proxy& pb = m_Proxies[b];
+    return pa.max.x >= pb.min.x && pa.min.x <= pb.max.x &&
+           pa.max.y >= pb.min.y && pa.min.y <= pb.max.y &&
+           pa.max.z >= pb.min.z && pa.min.z <= pb.max.z;
+}
+
+bool Broadphase::Overlaps(uint32_t proxy, const glm::vec3& min, const glm::vec3& max) const
+{
+    const Proxy& p = m_Proxies[proxy];
+    return p.max.x >= min.x && p.min.x <= max.x &&
+           p.max.y >= min.y && p.min.y <= max.y &&
+           p.max.z >= min.z && p.min.z <= max.z;
+}
+
+void Broadphase::AddPair(uint32_t a, uint32_t b)
+{
+    m_Pairs.push_back({ m_Proxies[a].entity, m_Proxies[b].entity });
+}
+
+bool Broadphase::BuildGrid()
+{
+    DropStaleProxies();
+    for (Proxy& proxy : m_Proxies) proxy.touched = false;
+    if (m_Proxies.size() < 2)
+    {
+        // No grid, queries test the proxies directly
+        m_BucketStart.clear();
+        m_Large.clear();
+        return false;
+    }
+
+    ChooseCellSize();
+    m_BoundsMin = glm::vec3(FLT_MAX);
+    m_BoundsMax = glm::vec3(-FLT_MAX);
+    for (const Proxy& proxy : m_Proxies)
+    {
+        m_BoundsMin = glm::min(m_BoundsMin, proxy.min);
+        m_BoundsMax = glm::max(m_BoundsMax, proxy.max);
+    }
+
+    // 1. Cell entries for every proxy small enough for the grid
+    m_Entries.clear();
+    m_Large.clear();
+    for (uint32_t i = 0; i < m_Proxies.size(); i++)
+    {
+        glm::ivec3 lo = CellOf(m_Proxies[i].min);
+        glm::ivec3 hi = CellOf(m_Proxies[i].max);
+        if (hi.x - lo.x >= MAX_CELL_SPAN || hi.y - lo.y >= MAX_CELL_SPAN || hi.z - lo.z >= MAX_CELL_SPAN)
+        {
+            m_Large.push_back(i);
+            continue;
+        }
+
+        for (int z = lo.z; z <= hi.z; z++)
+            for (int y = lo.y; y <= hi.y; y++)
+                for (int x = lo.x; x <= hi.x; x++)
+                    m_Entries.push_back({ PackCell(x, y, z), i });
+    }
+
+    // 2. Counting sort into a power of two bucket table (about 2 buckets per entry)
+    size_t tableSize = 1;
+    while (tableSize < m_Entries.size() * 2) tableSize <<= 1;
+    m_TableMask = tableSize - 1;
+
+    m_BucketStart.assign(tableSize + 1, 0);
+    for (const CellEntry& entry : m_Entries) m_BucketStart[BucketOf(entry.cell) + 1]++;
+    for (size_t b = 0; b < tableSize; b++) m_BucketStart[b + 1] += m_BucketStart[b];
+
+    m_Buckets.resize(m_Entries.size());
+    for (const CellEntry& entry : m_Entries)
+    {
+        // Scatter using the start offsets as write heads, restored below
+        m_Buckets[m_BucketStart[BucketOf(entry.cell)]++] = entry;
+    }
+    for (size_t b = tableSize; b > 0; b--) m_BucketStart[b] = m_BucketStart[b - 1];
+    m_BucketStart[0] = 0;
+    return true;
+}
+
+const std::vector<BroadphasePair>& Broadphase::FindPairs()
+{
+    m_Pairs.clear();
+    if (!BuildGrid()) return m_Pairs;
+    size_t tableSize = m_BucketStart.size() - 1;
+
+    // 3. Pairs inside each cell. A bucket may mix cells, entries of other cells are skipped.
+    for (size_t b = 0; b < tableSize; b++)
+    {
+        uint32_t begin = m_BucketStart[b], end = m_BucketStart[b + 1];
+        for (uint32_t i = begin; i < end; i++)
+        {
+            const CellEntry& ei = m_Buckets[i];
+            for (uint32_t j = i + 1; j < end; j++)
+            {
+                const CellEntry& ej = m_Buckets[j];
+                if (ei.cell != ej.cell) continue;
+
+                const Proxy& pa = m_Proxies[ei.proxy];
+                const Proxy& pb = m_Proxies[ej.proxy];
+                if (pa.isStatic && pb.isStatic) continue;
+                if (!Overlaps(ei.proxy, ej.proxy)) continue;
+
+                // Only from the cell holding the min corner of the overlap
+                glm::ivec3 first = CellOf(glm::max(pa.min, pb.min));
+                if (PackCell(first.x, first.y, first.z) != ei.cell) continue;
+
+                AddPair(ei.proxy, ej.proxy);
+            }
+        }
+    }
+
+    // 4. Large proxies against everything (each large-large pair once)
+    for (size_t l = 0; l < m_Large.size(); l++)
+    {
+        uint32_t large = m_Large[l];
+        for (uint32_t other = 0; other < m_Proxies.size(); other++)
+        {
+            if (other == large) continue;
+            if (m_Proxies[large].isStatic && m_Proxies[other].isStatic) continue;
+
+            bool otherLarge = std::binary_search(m_Large.begin(), m_Large.end(), other);
+            if (otherLarge && other < large) continue;
+            if (Overlaps(large, other)) AddPair(large, other);
+        }
+    }
+    return m_Pairs;
+}
+
+// QUERIES
+
+void Broadphase::Query(const glm::vec3& min, const glm::vec3& max, std::vector<Entity>& results) const
+{
+    glm::ivec3 lo = CellOf(min);
+    glm::ivec3 hi = CellOf(max);
+    int spanX = hi.x - lo.x + 1, spanY = hi.y - lo.y + 1, spanZ = hi.z - lo.z + 1;
+    bool useGrid = !m_BucketStart.empty() && spanX <= MAX_QUERY_CELLS && spanY <= MAX_QUERY_CELLS && spanZ <= MAX_QUERY_CELLS &&
+                   spanX * spanY * spanZ <= MAX_QUERY_CELLS;
+    if (!useGrid)
+    {
+        for (uint32_t i = 0; i < m_Proxies.size(); i++)
+            if (Overlaps(i, min, max)) results.push_back(m_Proxies[i].entity);
+        return;
+    }
+
+    for (int z = lo.z; z <= hi.z; z++)
+        for (int y = lo.y; y <= hi.y; y++)
+            for (int x = lo.x; x <= hi.x; x++)
+            {
+                uint64_t cell = PackCell(x, y, z);
+                size_t bucket = BucketOf(cell);
+                for (uint32_t i = m_BucketStart[bucket]; i < m_BucketStart[bucket + 1]; i++)
+                {
+                    const CellEntry& entry = m_Buckets[i];
+                    if (entry.cell != cell || !Overlaps(entry.proxy, min, max)) continue;
+
+                    // Same rule as the pairs: only from the cell holding the min corner of the overlap
+                    glm::ivec3 first = CellOf(glm::max(min, m_Proxies[entry.proxy].min));
+                    if (PackCell(first.x, first.y, first.z) != cell) continue;
+                    results.push_back(m_Proxies[entry.proxy].entity);
+                }
+            }
+
+    for (uint32_t large : m_Large)
+        if (Overlaps(large, min, max)) results.push_back(m_Proxies[large].entity);
+}
+
+// Amanatides-Woo walk over the cells along the ray. A hit closer than the exit of the current
+// cell ends the walk: proxies not seen yet are only entered in later cells. Past MAX_RAY_CELLS
+// (a long ray through a fine grid) the rest of the ray tests every proxy instead.
+void Broadphase::Raycast(const glm::vec3& origin, const glm::vec3& direction, float maxDistance, const std::function<float(Entity)>& visit) const
+{
+    float entry;
+    if (m_BucketStart.empty())
+    {
+        for (const Proxy& proxy : m_Proxies)
+            if (Queries::RayAABB(origin, direction, maxDistance, proxy.min, proxy.max, entry)) maxDistance = visit(proxy.entity);
+        return;
+    }
+
+    for (uint32_t large : m_Large)
+        if (Queries::RayAABB(origin, direction, maxDistance, m_Proxies[large].min, m_Proxies[large].max, entry)) maxDistance = visit(m_Proxies[large].entity);
+
+    // Only the stretch inside the bounds of all proxies is walked
+    float start, back, end = maxDistance;
+    if (!Queries::RayAABB(origin, direction, maxDistance, m_BoundsMin, m_BoundsMax, start)) return;
+    if (Queries::RayAABB(origin + direction * maxDistance, -direction, maxDistance - start, m_BoundsMin, m_BoundsMax, back)) end -= back;
+
+    glm::ivec3 first = CellOf(origin + direction * start);
+    int cell[3] = { first.x, first.y, first.z };
+    int step[3];
+    float next[3], delta[3];
+    for (int k = 0; k < 3; k++)
+    {
+        step[k] = direction[k] >= 0.0f ? 1 : -1;
+        if (std::fabs(direction[k]) < 1e-12f)
+        {
+            next[k] = delta[k] = FLT_MAX;
+            continue;
+        }
+        float boundary = (cell[k] + (step[k] > 0 ? 1 : 0)) * m_CellSize;
+        next[k] = (boundary - origin[k]) / direction[k];
+        delta[k] = m_CellSize / std::fabs(direction[k]);
+    }
+
+    for (int visited = 0; visited < MAX_RAY_CELLS; visited++)
+    {
+        uint64_t key = PackCell(cell[0], cell[1], cell[2]);
+        size_t bucket = BucketOf(key);
+        for (uint32_t i = m_BucketStart[bucket]; i < m_BucketStart[bucket + 1]; i++)
+        {
+            const CellEntry& cellEntry = m_Buckets[i];
+            if (cellEntry.cell != key) continue;
+            const Proxy& proxy = m_Proxies[cellEntry.proxy];
+            if (Queries::RayAABB(origin, direction, maxDistance, proxy.min, proxy.max, entry)) maxDistance = visit(proxy.entity);
+        }
+
+        int axis = next[0] < next[1] ? (next[0] < next[2] ? 0 : 2) : (next[1] < next[2] ? 1 : 2);
+        float exit = next[axis];
+        if (exit >= maxDistance || exit >= end) return;
+        cell[axis] += step[axis];
+        next[axis] += delta[axis];
+    }
+
+    for (const Proxy& proxy : m_Proxies)
+        if (Queries::RayAABB(origin, direction, maxDistance, proxy.min, proxy.max, entry)) maxDistance = visit(proxy.entity);
+}
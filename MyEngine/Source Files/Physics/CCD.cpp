@@ -0,0 +1,157 @@
+//
+//  CCD.cpp
+//  MyEngine
+//
+//  Created by Priyanshu Kaushik on 19/10/2026.
+//
+
+#include "Physics/CCD.h"
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+
+// SWEEP SHAPE
+
+void SweepShape::Translate(const glm::vec3& offset)
+{
+    sphere.center += offset;
+    box.center += offset;
+}
+
+void SweepShape::GetBounds(glm::vec3& min, glm::vec3& max) const
+{
+    if (isSphere)
+    {
+        min = sphere.center - glm::vec3(sphere.radius);
+        max = sphere.center + glm::vec3(sphere.radius);
+        return;
+    }
+    glm::vec3 extent = glm::abs(box.axes[0]) * box.halfExtents.x + glm::abs(box.axes[1]) * box.halfExtents.y + glm::abs(box.axes[2]) * box.halfExtents.z;
+    min = box.center - extent;
+    max = box.center + extent;
+}
+
+glm::vec3 SweepShape::GetLowestPoint() const
+{
+    if (isSphere) return sphere.center - glm::vec3(0.0f, sphere.radius, 0.0f);
+
+    glm::vec3 point = box.center;
+    for (int k = 0; k < 3; k++) point -= box.axes[k] * (box.axes[k].y >= 0.0f ? box.halfExtents[k] : -box.halfExtents[k]);
+    return point;
+}
+
+float SweepShape::GetInnerRadius() const
+{
+    if (isSphere) return sphere.radius;
+    return std::min({ box.halfExtents.x, box.halfExtents.y, box.halfExtents.z });
+}
+
+namespace CCD {
+
+namespace {
+
+float SphereSphereDistance(const CollisionSphere& a, const CollisionSphere& b, glm::vec3& normal)
+{
+    glm::vec3 delta = b.center - a.center;
+    float dist = glm::length(delta);
+    normal = dist > 1e-6f ? delta / dist : glm::vec3(0.0f, 1.0f, 0.0f);
+    return dist - a.radius - b.radius;
+}
+
+// Normal from the sphere towards the box
+float SphereBoxDistance(const CollisionSphere& a, const CollisionBox& b, glm::vec3& normal)
+{
+    glm::vec3 delta = a.center - b.center;
+    glm::vec3 local(glm::dot(delta, b.axes[0]), glm::dot(delta, b.axes[1]), glm::dot(delta, b.axes[2]));
+    glm::vec3 closest = glm::clamp(local, -b.halfExtents, b.halfExtents);
+    glm::vec3 offset = local - closest;
+    float dist = glm::length(offset);
+
+    if (dist > 1e-6f)
+    {
+        normal = -(b.axes[0] * offset.x + b.axes[1] * offset.y + b.axes[2] * offset.z) / dist;
+        return dist - a.radius;
+    }
+
+    // Center inside: out through the nearest face
+    int axis = 0;
+    float minGap = FLT_MAX;
+    for (int k = 0; k < 3; k++)
+    {
+        float gap = b.halfExtents[k] - std::fabs(local[k]);
+        if (gap < minGap) { minGap = gap; axis = k; }
+    }
+    normal = b.axes[axis] * (local[axis] >= 0.0f ? -1.0f : 1.0f);
+    return -(minGap + a.radius);
+}
+
+// Largest gap over the 15 separating axes
+float BoxBoxDistance(const CollisionBox& a, const CollisionBox& b, glm::vec3& normal)
+{
+    glm::vec3 delta = b.center - a.center;
+    float best = -FLT_MAX;
+
+    auto testAxis = [&](glm::vec3 axis) {
+        float length = glm::length(axis);
+        if (length < 1e-6f) return;     // Parallel edges
+        axis /= length;
+
+        float along = glm::dot(delta, axis);
+        if (along < 0.0f) { axis = -axis; along = -along; }
+        float radiusA = 0.0f, radiusB = 0.0f;
+        for (int k = 0; k < 3; k++)
+        {
+            radiusA += a.halfExtents[k] * std::fabs(glm::dot(a.axes[k], axis));
+            radiusB += b.halfExtents[k] * std::fabs(glm::dot(b.axes[k], axis));
+        }
+        float gap = along - radiusA - radiusB;
+        if (gap > best) { best = gap; normal = axis; }
+    };
+
+    for (int i = 0; i < 3; i++) testAxis(a.axes[i]);
+    for (int i = 0; i < 3; i++) testAxis(b.axes[i]);
+    for (int i = 0; i < 3; i++)
+        for (int j = 0; j < 3; j++) testAxis(glm::cross(a.axes[i], b.axes[j]));
+    return best;
+}
+
+}
+
+float Distance(const SweepShape& a, const SweepShape& b, glm::vec3& normal)
+{
+    if (a.isSphere && b.isSphere) return SphereSphereDistance(a.sphere, b.sphere, normal);
+    if (!a.isSphere && !b.isSphere) return BoxBoxDistance(a.box, b.box, normal);
+    if (a.isSphere) return SphereBoxDistance(a.sphere, b.box, normal);
+
+    float distance = SphereBoxDistance(b.sphere, a.box, normal);
+    normal = -normal;
+    return distance;
+}
+
+bool ConservativeAdvancement(const SweepShape& a, const SweepShape& b, const glm::vec3& motion, TimeOfImpact& hit)
+{
+    float fraction = 0.0f;
+    SweepShape moved = a;
+    glm::vec3 normal;
+
+    for (int i = 0; i < MAX_ITERATIONS; i++)
+    {
+        float distance = Distance(moved, b, normal);
+        float closing = glm::dot(motion, normal);
+        // Moving apart along the closest direction: the distance never shrinks again
+        if (closing <= 1e-6f) return false;
+        if (distance <= TARGET_GAP + TOLERANCE) break;
+
+        fraction += (distance - TARGET_GAP) / closing;
+        if (fraction >= 1.0f) return false;
+        moved = a;
+        moved.Translate(motion * fraction);
+    }
+
+    // Out of iterations, still short of the contact
+    hit.fraction = fraction;
+    hit.normal = normal;
+    return true;
+}
+
+}
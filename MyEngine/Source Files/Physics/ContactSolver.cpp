@@ -0,0 +1,331 @@
+//
+//  ContactSolver.cpp
+//  MyEngine
+//
+//  Created by Priyanshu Kaushik on 19/10/2026.
+//
+
+#include "Physics/ContactSolver.h"
+#include "JobSystem.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+// Same basis for the same normal every step, so cached friction impulses stay meaningful
+void ComputeTangents(const glm::vec3& normal, glm::vec3* tangents)
+{
+    if (std::fabs(normal.x) >= 0.57735f) tangents[0] = glm::normalize(glm::vec3(normal.y, -normal.x, 0.0f));
+    else tangents[0] = glm::normalize(glm::vec3(0.0f, normal.z, -normal.y));
+    tangents[1] = glm::cross(normal, tangents[0]);
+}
+
+}
+
+void ContactSolver::ClearCache()
+{
+    m_Cache.clear();
+    m_CacheIndex.clear();
+}
+
+void ContactSolver::RemapBodies(const std::vector<uint32_t>& bodyOfEntity, std::vector<uint32_t>& orphaned)
+{
+    // NO_BODY stays NO_BODY (terrain), bodies map through their entity
+    auto remap = [&bodyOfEntity](Entity entity, uint32_t body) {
+        if (body == NO_BODY) return NO_BODY;
+        return entity < bodyOfEntity.size() ? bodyOfEntity[entity] : NO_BODY;
+    };
+
+    std::vector<ContactManifold> cache;
+    std::unordered_map<uint64_t, uint32_t> index;
+    cache.reserve(m_Cache.size());
+    for (ContactManifold manifold : m_Cache)
+    {
+        uint32_t bodyA = remap(manifold.a, manifold.bodyA);
+        uint32_t bodyB = remap(manifold.b, manifold.bodyB);
+        if ((manifold.bodyA != NO_BODY && bodyA == NO_BODY) || (manifold.bodyB != NO_BODY && bodyB == NO_BODY))
+        {
+            if (bodyA != NO_BODY) orphaned.push_back(bodyA);
+            if (bodyB != NO_BODY) orphaned.push_back(bodyB);
+            continue;
+        }
+
+        manifold.bodyA = bodyA;
+        manifold.bodyB = bodyB;
+        index[manifold.GetKey()] = (uint32_t)cache.size();
+        cache.push_back(manifold);
+    }
+
+    m_Cache.swap(cache);
+    m_CacheIndex.swap(index);
+}
+
+void ContactSolver::Solve(PhysicsWorld& world, std::vector<ContactManifold>& manifolds, const std::vector<Island>& islands, float deltaTime)
+{
+    GatherBodies(world, manifolds, islands);
+    BuildBatches(islands);
+
+    JobSystem::Get().ParallelFor((int)m_Batches.size() - 1, [&](int batch) {
+        for (uint32_t i = m_Batches[batch]; i < m_Batches[batch + 1]; i++)
+        {
+            const Island& island = islands[i];
+            if (island.manifoldCount) SolveIsland(world, manifolds.data() + island.manifoldStart, island.manifoldCount, deltaTime);
+        }
+    });
+
+    ScatterBodies(world);
+    UpdateCache(world, manifolds);
+}
+
+void ContactSolver::SolveIsland(const PhysicsWorld& world, ContactManifold* manifolds, uint32_t count, float deltaTime)
+{
+    MatchCache(world, manifolds, count);
+    Prepare(world, manifolds, count, deltaTime);
+    WarmStart(manifolds, count);
+    for (int i = 0; i < m_Iterations; i++) SolveVelocities(manifolds, count);
+}
+
+// Consecutive islands are grouped until a batch holds ISLAND_BATCH_MANIFOLDS contacts
+void ContactSolver::BuildBatches(const std::vector<Island>& islands)
+{
+    m_Batches.clear();
+    uint32_t batchManifolds = ISLAND_BATCH_MANIFOLDS;
+    for (uint32_t i = 0; i < islands.size(); i++)
+    {
+        if (!islands[i].manifoldCount) continue;
+        if (batchManifolds >= ISLAND_BATCH_MANIFOLDS)
+        {
+            m_Batches.push_back(i);
+            batchManifolds = 0;
+        }
+        batchManifolds += islands[i].manifoldCount;
+    }
+    m_Batches.push_back((uint32_t)islands.size());
+}
+
+// WARM STARTING
+
+void ContactSolver::MatchCache(const PhysicsWorld& world, ContactManifold* manifolds, uint32_t count) const
+{
+    for (uint32_t m = 0; m < count; m++)
+    {
+        ContactManifold& manifold = manifolds[m];
+        ComputeTangents(manifold.normal, manifold.tangent);
+
+        glm::vec3 originA(0.0f);
+        glm::quat inverseA(1.0f, 0.0f, 0.0f, 0.0f);
+        if (manifold.bodyA != NO_BODY)
+        {
+            originA = world.GetPosition(manifold.bodyA);
+            inverseA = glm::conjugate(world.GetOrientation(manifold.bodyA));
+        }
+        for (int i = 0; i < manifold.pointCount; i++)
+            manifold.points[i].localA = inverseA * (manifold.points[i].position - originA);
+
+        auto it = m_CacheIndex.find(manifold.GetKey());
+        if (it == m_CacheIndex.end()) continue;
+
+        const ContactManifold& cached = m_Cache[it->second];
+        bool used[ContactManifold::MAX_POINTS] = {};
+        for (int i = 0; i < manifold.pointCount; i++)
+        {
+            ContactPoint& point = manifold.points[i];
+            int match = -1;
+            float bestDistSq = MATCH_DISTANCE * MATCH_DISTANCE;
+            for (int j = 0; j < cached.pointCount; j++)
+            {
+                if (used[j]) continue;
+                glm::vec3 d = cached.points[j].localA - point.localA;
+                if (glm::dot(d, d) < bestDistSq) { bestDistSq = glm::dot(d, d); match = j; }
+            }
+            if (match < 0) continue;
+
+            used[match] = true;
+            point.normalImpulse = cached.points[match].normalImpulse;
+            point.tangentImpulse[0] = cached.points[match].tangentImpulse[0];
+            point.tangentImpulse[1] = cached.points[match].tangentImpulse[1];
+        }
+    }
+}
+
+// Resting pairs are not regenerated while both bodies sleep, keep their impulses for when they wake
+void ContactSolver::UpdateCache(const PhysicsWorld& world, const std::vector<ContactManifold>& manifolds)
+{
+    auto sleeping = [&world](uint32_t body) { return body == NO_BODY || !world.IsAwake(body); };
+
+    std::vector<ContactManifold> cache(manifolds.begin(), manifolds.end());
+    std::unordered_map<uint64_t, uint32_t> index;
+    for (uint32_t i = 0; i < cache.size(); i++) index[cache[i].GetKey()] = i;
+
+    for (const ContactManifold& old : m_Cache)
+    {
+        if (index.count(old.GetKey())) continue;
+        if (old.bodyA != NO_BODY && old.bodyA >= world.GetBodyCount()) continue;
+        if (old.bodyB != NO_BODY && old.bodyB >= world.GetBodyCount()) continue;
+        if (!sleeping(old.bodyA) || !sleeping(old.bodyB)) continue;
+
+        index[old.GetKey()] = (uint32_t)cache.size();
+        cache.push_back(old);
+    }
+
+    m_Cache.swap(cache);
+    m_CacheIndex.swap(index);
+}
+
+// BODIES
+
+void ContactSolver::GatherBodies(const PhysicsWorld& world, std::vector<ContactManifold>& manifolds, const std::vector<Island>& islands)
+{
+    m_Bodies.clear();
+    m_SolverIndex.resize(world.GetBodyCount());
+    m_SolverIsland.assign(world.GetBodyCount(), NO_BODY);
+
+    for (uint32_t i = 0; i < islands.size(); i++)
+    {
+        uint32_t ground = NO_BODY;  // Terrain, one per island
+        auto gather = [&](uint32_t body) -> uint32_t {
+            if (body == NO_BODY)
+            {
+                if (ground == NO_BODY)
+                {
+                    ground = (uint32_t)m_Bodies.size();
+                    m_Bodies.emplace_back();
+                }
+                return ground;
+            }
+            if (m_SolverIsland[body] == i) return m_SolverIndex[body];
+
+            SolverBody solverBody;
+            solverBody.body = body;
+            solverBody.velocity = world.GetVelocity(body);
+            solverBody.angularVelocity = world.GetAngularVelocity(body);
+            solverBody.invMass = world.GetInverseMass(body);
+            solverBody.invInertia = world.GetInverseInertiaWorld(body);
+            m_SolverIsland[body] = i;
+            m_SolverIndex[body] = (uint32_t)m_Bodies.size();
+            m_Bodies.push_back(solverBody);
+            return m_SolverIndex[body];
+        };
+
+        for (uint32_t m = islands[i].manifoldStart; m < islands[i].manifoldStart + islands[i].manifoldCount; m++)
+        {
+            manifolds[m].solverA = gather(manifolds[m].bodyA);
+            manifolds[m].solverB = gather(manifolds[m].bodyB);
+        }
+    }
+}
+
+void ContactSolver::ScatterBodies(PhysicsWorld& world)
+{
+    for (const SolverBody& solverBody : m_Bodies)
+    {
+        if (solverBody.invMass == 0.0f) continue;     // Static, kinematic or terrain, nothing changed
+        world.SetVelocity(solverBody.body, solverBody.velocity);
+        world.SetAngularVelocity(solverBody.body, solverBody.angularVelocity);
+    }
+}
+
+// SOLVER
+
+void ContactSolver::Prepare(const PhysicsWorld& world, ContactManifold* manifolds, uint32_t count, float deltaTime)
+{
+    float inverseDt = deltaTime > 0.0f ? 1.0f / deltaTime : 0.0f;
+
+    for (uint32_t m = 0; m < count; m++)
+    {
+        ContactManifold& manifold = manifolds[m];
+        const SolverBody& a = m_Bodies[manifold.solverA];
+        const SolverBody& b = m_Bodies[manifold.solverB];
+        glm::vec3 originA = manifold.bodyA != NO_BODY ? world.GetPosition(manifold.bodyA) : glm::vec3(0.0f);
+        glm::vec3 originB = manifold.bodyB != NO_BODY ? world.GetPosition(manifold.bodyB) : glm::vec3(0.0f);
+        const glm::vec3& n = manifold.normal;
+
+        for (int i = 0; i < manifold.pointCount; i++)
+        {
+            ContactPoint& point = manifold.points[i];
+            point.rA = manifold.bodyA != NO_BODY ? point.position - originA : glm::vec3(0.0f);
+            point.rB = manifold.bodyB != NO_BODY ? point.position - originB : glm::vec3(0.0f);
+
+            auto effectiveMass = [&](const glm::vec3& axis) {
+                glm::vec3 raxA = glm::cross(point.rA, axis);
+                glm::vec3 raxB = glm::cross(point.rB, axis);
+                float k = a.invMass + b.invMass + glm::dot(raxA, a.invInertia * raxA) + glm::dot(raxB, b.invInertia * raxB);
+                return k > 0.0f ? 1.0f / k : 0.0f;
+            };
+            point.normalMass = effectiveMass(n);
+            point.tangentMass[0] = effectiveMass(manifold.tangent[0]);
+            point.tangentMass[1] = effectiveMass(manifold.tangent[1]);
+
+            // Push out of penetration (beyond the slop), or allow closing a speculative gap
+            if (point.depth > PENETRATION_SLOP) point.velocityBias = BAUMGARTE * inverseDt * (point.depth - PENETRATION_SLOP);
+            else if (point.depth < 0.0f) point.velocityBias = point.depth * inverseDt;
+            else point.velocityBias = 0.0f;
+
+            glm::vec3 relative = (b.velocity + glm::cross(b.angularVelocity, point.rB)) - (a.velocity + glm::cross(a.angularVelocity, point.rA));
+            float approach = glm::dot(relative, n);
+            if (approach < -RESTITUTION_THRESHOLD)
+                point.velocityBias = std::max(point.velocityBias, -manifold.restitution * approach);
+        }
+    }
+}
+
+void ContactSolver::ApplyImpulse(SolverBody& a, SolverBody& b, const ContactPoint& point, const glm::vec3& impulse)
+{
+    a.velocity -= impulse * a.invMass;
+    a.angularVelocity -= a.invInertia * glm::cross(point.rA, impulse);
+    b.velocity += impulse * b.invMass;
+    b.angularVelocity += b.invInertia * glm::cross(point.rB, impulse);
+}
+
+void ContactSolver::WarmStart(const ContactManifold* manifolds, uint32_t count)
+{
+    for (uint32_t m = 0; m < count; m++)
+    {
+        const ContactManifold& manifold = manifolds[m];
+        SolverBody& a = m_Bodies[manifold.solverA];
+        SolverBody& b = m_Bodies[manifold.solverB];
+        for (int i = 0; i < manifold.pointCount; i++)
+        {
+            const ContactPoint& point = manifold.points[i];
+            glm::vec3 impulse = manifold.normal * point.normalImpulse +
+                                manifold.tangent[0] * point.tangentImpulse[0] +
+                                manifold.tangent[1] * point.tangentImpulse[1];
+            ApplyImpulse(a, b, point, impulse);
+        }
+    }
+}
+
+void ContactSolver::SolveVelocities(ContactManifold* manifolds, uint32_t count)
+{
+    for (uint32_t m = 0; m < count; m++)
+    {
+        ContactManifold& manifold = manifolds[m];
+        SolverBody& a = m_Bodies[manifold.solverA];
+        SolverBody& b = m_Bodies[manifold.solverB];
+
+        for (int i = 0; i < manifold.pointCount; i++)
+        {
+            ContactPoint& point = manifold.points[i];
+
+            // Friction, bounded by the current normal impulse
+            float maxFriction = manifold.friction * point.normalImpulse;
+            for (int t = 0; t < 2; t++)
+            {
+                glm::vec3 relative = (b.velocity + glm::cross(b.angularVelocity, point.rB)) - (a.velocity + glm::cross(a.angularVelocity, point.rA));
+                float lambda = -glm::dot(relative, manifold.tangent[t]) * point.tangentMass[t];
+                float accumulated = glm::clamp(point.tangentImpulse[t] + lambda, -maxFriction, maxFriction);
+                lambda = accumulated - point.tangentImpulse[t];
+                point.tangentImpulse[t] = accumulated;
+                ApplyImpulse(a, b, point, manifold.tangent[t] * lambda);
+            }
+
+            // Normal, contacts only push
+            glm::vec3 relative = (b.velocity + glm::cross(b.angularVelocity, point.rB)) - (a.velocity + glm::cross(a.angularVelocity, point.rA));
+            float lambda = (point.velocityBias - glm::dot(relative, manifold.normal)) * point.normalMass;
+            float accumulated = std::max(point.normalImpulse + lambda, 0.0f);
+            lambda = accumulated - point.normalImpulse;
+            point.normalImpulse = accumulated;
+            ApplyImpulse(a, b, point, manifold.normal * lambda);
+        }
+    }
+}
@@ -0,0 +1,117 @@
+//
+//  IslandBuilder.cpp
+//  MyEngine
+//
+//  Created by Priyanshu Kaushik on 19/10/2026.
+//
+
+#include "Physics/IslandBuilder.h"
+#include <utility>
+
+namespace {
+
+bool IsDynamic(const PhysicsWorld& world, uint32_t body)
+{
+    return body != NO_BODY && world.GetInverseMass(body) > 0.0f;
+}
+
+}
+
+// UNION-FIND
+
+uint32_t IslandBuilder::Find(uint32_t body)
+{
+    // Path halving
+    while (m_Parent[body] != body)
+    {
+        m_Parent[body] = m_Parent[m_Parent[body]];
+        body = m_Parent[body];
+    }
+    return body;
+}
+
+// The lower body index stays the root, which keeps the result independent of contact order
+void IslandBuilder::Union(uint32_t a, uint32_t b)
+{
+    a = Find(a);
+    b = Find(b);
+    if (a == b) return;
+    if (b < a) std::swap(a, b);
+    m_Parent[b] = a;
+}
+
+uint32_t IslandBuilder::IslandOf(const PhysicsWorld& world, const ContactManifold& manifold)
+{
+    if (IsDynamic(world, manifold.bodyA)) return m_IslandOfRoot[Find(manifold.bodyA)];
+    if (IsDynamic(world, manifold.bodyB)) return m_IslandOfRoot[Find(manifold.bodyB)];
+    return NO_BODY;
+}
+
+// ISLANDS
+
+void IslandBuilder::Build(const PhysicsWorld& world, const std::vector<uint32_t>& awakeBodies, std::vector<ContactManifold>& manifolds)
+{
+    m_Islands.clear();
+    m_Bodies.clear();
+    if (m_Parent.size() < world.GetBodyCount())
+    {
+        m_Parent.resize(world.GetBodyCount());
+        m_IslandOfRoot.resize(world.GetBodyCount());
+    }
+
+    // 1. every awake body on its own, then merged along dynamic-dynamic contacts
+    for (uint32_t body : awakeBodies)
+    {
+        m_Parent[body] = body;
+        m_IslandOfRoot[body] = NO_BODY;
+    }
+    for (const ContactManifold& manifold : manifolds)
+    {
+        if (IsDynamic(world, manifold.bodyA) && IsDynamic(world, manifold.bodyB)) Union(manifold.bodyA, manifold.bodyB);
+    }
+
+    // 2. number the islands and count their bodies
+    for (uint32_t body : awakeBodies)
+    {
+        uint32_t root = Find(body);
+        if (m_IslandOfRoot[root] == NO_BODY)
+        {
+            m_IslandOfRoot[root] = (uint32_t)m_Islands.size();
+            m_Islands.emplace_back();
+        }
+        m_Islands[m_IslandOfRoot[root]].bodyCount++;
+    }
+    for (const ContactManifold& manifold : manifolds)
+    {
+        uint32_t island = IslandOf(world, manifold);
+        if (island != NO_BODY) m_Islands[island].manifoldCount++;
+    }
+
+    // 3. counting sort of bodies and manifolds into island order
+    uint32_t bodyStart = 0, manifoldStart = 0;
+    for (Island& island : m_Islands)
+    {
+        island.bodyStart = bodyStart;
+        island.manifoldStart = manifoldStart;
+        bodyStart += island.bodyCount;
+        manifoldStart += island.manifoldCount;
+        island.bodyCount = island.manifoldCount = 0;
+    }
+
+    m_Bodies.resize(bodyStart);
+    for (uint32_t body : awakeBodies)
+    {
+        Island& island = m_Islands[m_IslandOfRoot[Find(body)]];
+        m_Bodies[island.bodyStart + island.bodyCount++] = body;
+    }
+
+    m_Sorted.resize(manifoldStart);
+    for (const ContactManifold& manifold : manifolds)
+    {
+        uint32_t index = IslandOf(world, manifold);
+        if (index == NO_BODY) continue;
+        Island& island = m_Islands[index];
+        m_Sorted[island.manifoldStart + island.manifoldCount++] = manifold;
+    }
+    manifolds.swap(m_Sorted);
+}
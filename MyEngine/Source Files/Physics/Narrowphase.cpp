@@ -0,0 +1,304 @@
+//
+//  Narrowphase.cpp
+//  MyEngine
+//
+//  Created by Priyanshu Kaushik on 19/10/2026.
+//
+
+#include "Physics/Narrowphase.h"
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+
+namespace Narrowphase {
+
+namespace {
+
+// Sutherland-Hodgman step: keeps the part of the polygon with dot(planeNormal, p) <= planeOffset
+int ClipPolygon(const glm::vec3* in, int count, const glm::vec3& planeNormal, float planeOffset, glm::vec3* out)
+{
+    int outCount = 0;
+    for (int i = 0; i < count; i++)
+    {
+        const glm::vec3& p = in[i];
+        const glm::vec3& q = in[(i + 1) % count];
+        float dp = glm::dot(planeNormal, p) - planeOffset;
+        float dq = glm::dot(planeNormal, q) - planeOffset;
+
+        if (dp <= 0.0f) out[outCount++] = p;
+        if ((dp < 0.0f && dq > 0.0f) || (dp > 0.0f && dq < 0.0f))
+            out[outCount++] = p + (q - p) * (dp / (dp - dq));
+    }
+    return outCount;
+}
+
+// Clips the incident box's face most facing the reference face against that face's side planes.
+// refNormal is the reference face normal, pointing towards the incident box.
+int ClipFaces(const CollisionBox& ref, int refAxis, const glm::vec3& refNormal, const CollisionBox& inc, ContactPoint* out)
+{
+    int incAxis = 0;
+    float bestDot = -1.0f;
+    for (int k = 0; k < 3; k++)
+    {
+        float d = std::fabs(glm::dot(inc.axes[k], refNormal));
+        if (d > bestDot) { bestDot = d; incAxis = k; }
+    }
+    float incSign = glm::dot(inc.axes[incAxis], refNormal) > 0.0f ? -1.0f : 1.0f;
+    glm::vec3 incCenter = inc.center + inc.axes[incAxis] * (incSign * inc.halfExtents[incAxis]);
+    glm::vec3 du = inc.axes[(incAxis + 1) % 3] * inc.halfExtents[(incAxis + 1) % 3];
+    glm::vec3 dv = inc.axes[(incAxis + 2) % 3] * inc.halfExtents[(incAxis + 2) % 3];
+
+    // 4 planes can add at most one vertex each
+    glm::vec3 polygon[8] = { incCenter + du + dv, incCenter - du + dv, incCenter - du - dv, incCenter + du - dv };
+    glm::vec3 clipped[8];
+    int count = 4;
+
+    for (int side = 1; side <= 2; side++)
+    {
+        int axis = (refAxis + side) % 3;
+        for (float s : { 1.0f, -1.0f })
+        {
+            glm::vec3 planeNormal = ref.axes[axis] * s;
+            float planeOffset = glm::dot(planeNormal, ref.center) + ref.halfExtents[axis];
+            count = ClipPolygon(polygon, count, planeNormal, planeOffset, clipped);
+            if (count == 0) return 0;
+            std::copy(clipped, clipped + count, polygon);
+        }
+    }
+
+    float refOffset = glm::dot(refNormal, ref.center + refNormal * ref.halfExtents[refAxis]);
+    ContactPoint points[8];
+    int pointCount = 0;
+    for (int i = 0; i < count; i++)
+    {
+        float depth = refOffset - glm::dot(refNormal, polygon[i]);
+        if (depth < -CONTACT_MARGIN) continue;
+
+        points[pointCount].position = polygon[i] + refNormal * (depth * 0.5f);
+        points[pointCount].depth = depth;
+        pointCount++;
+    }
+
+    pointCount = ReducePoints(points, pointCount, refNormal);
+    std::copy(points, points + pointCount, out);
+    return pointCount;
+}
+
+float TriangleArea(const glm::vec3& a, const glm::vec3& b, const glm::vec3& c, const glm::vec3& normal)
+{
+    return glm::dot(glm::cross(b - a, c - a), normal);
+}
+
+}
+
+// SPHERE vs SPHERE
+
+bool SphereSphere(const CollisionSphere& a, const CollisionSphere& b, ContactManifold& manifold)
+{
+    glm::vec3 delta = b.center - a.center;
+    float distSq = glm::dot(delta, delta);
+    float sumRadii = a.radius + b.radius;
+    if (distSq > (sumRadii + CONTACT_MARGIN) * (sumRadii + CONTACT_MARGIN)) return false;
+
+    float dist = std::sqrt(distSq);
+    manifold.normal = dist > 1e-6f ? delta / dist : glm::vec3(0.0f, 1.0f, 0.0f);
+    manifold.pointCount = 1;
+
+    ContactPoint& point = manifold.points[0];
+    point.depth = sumRadii - dist;
+    point.position = a.center + manifold.normal * (a.radius - point.depth * 0.5f);
+    return true;
+}
+
+// SPHERE vs BOX
+// Closest point on the box in its local frame; a center inside the box leaves through the nearest face.
+
+bool SphereBox(const CollisionSphere& a, const CollisionBox& b, ContactManifold& manifold)
+{
+    glm::vec3 delta = a.center - b.center;
+    glm::vec3 local(glm::dot(delta, b.axes[0]), glm::dot(delta, b.axes[1]), glm::dot(delta, b.axes[2]));
+    glm::vec3 closest = glm::clamp(local, -b.halfExtents, b.halfExtents);
+    glm::vec3 offset = local - closest;
+    float distSq = glm::dot(offset, offset);
+
+    ContactPoint& point = manifold.points[0];
+    if (distSq > 1e-12f)
+    {
+        if (distSq > (a.radius + CONTACT_MARGIN) * (a.radius + CONTACT_MARGIN)) return false;
+
+        float dist = std::sqrt(distSq);
+        glm::vec3 closestWorld = b.center + b.axes[0] * closest.x + b.axes[1] * closest.y + b.axes[2] * closest.z;
+        manifold.normal = (closestWorld - a.center) / dist;
+        point.depth = a.radius - dist;
+        point.position = (a.center + manifold.normal * a.radius + closestWorld) * 0.5f;
+    }
+    else
+    {
+        int axis = 0;
+        float minGap = FLT_MAX;
+        for (int k = 0; k < 3; k++)
+        {
+            float gap = b.halfExtents[k] - std::fabs(local[k]);
+            if (gap < minGap) { minGap = gap; axis = k; }
+        }
+        float side = local[axis] >= 0.0f ? 1.0f : -1.0f;
+        manifold.normal = b.axes[axis] * -side;
+        point.depth = a.radius + minGap;
+        point.position = a.center;
+    }
+
+    manifold.pointCount = 1;
+    return true;
+}
+
+// BOX vs BOX
+
+bool BoxBox(const CollisionBox& a, const CollisionBox& b, ContactManifold& manifold)
+{
+    glm::vec3 t = b.center - a.center;
+
+    float absR[3][3];
+    for (int i = 0; i < 3; i++)
+        for (int j = 0; j < 3; j++)
+            absR[i][j] = std::fabs(glm::dot(a.axes[i], b.axes[j])) + 1e-6f;
+
+    // Separation along each candidate axis, positive when apart
+    float faceASep = -FLT_MAX, faceBSep = -FLT_MAX, edgeSep = -FLT_MAX;
+    int faceA = 0, faceB = 0, edgeA = 0, edgeB = 0;
+    glm::vec3 edgeAxis(0.0f);
+
+    for (int i = 0; i < 3; i++)
+    {
+        float rb = b.halfExtents[0] * absR[i][0] + b.halfExtents[1] * absR[i][1] + b.halfExtents[2] * absR[i][2];
+        float sep = std::fabs(glm::dot(t, a.axes[i])) - (a.halfExtents[i] + rb);
+        if (sep > CONTACT_MARGIN) return false;
+        if (sep > faceASep) { faceASep = sep; faceA = i; }
+    }
+    for (int j = 0; j < 3; j++)
+    {
+        float ra = a.halfExtents[0] * absR[0][j] + a.halfExtents[1] * absR[1][j] + a.halfExtents[2] * absR[2][j];
+        float sep = std::fabs(glm::dot(t, b.axes[j])) - (ra + b.halfExtents[j]);
+        if (sep > CONTACT_MARGIN) return false;
+        if (sep > faceBSep) { faceBSep = sep; faceB = j; }
+    }
+    for (int i = 0; i < 3; i++)
+    {
+        for (int j = 0; j < 3; j++)
+        {
+            glm::vec3 axis = glm::cross(a.axes[i], b.axes[j]);
+            float length = glm::length(axis);
+            if (length < 1e-5f) continue;      // Parallel edges, covered by the face axes
+            axis /= length;
+
+            float ra = 0.0f, rb = 0.0f;
+            for (int k = 0; k < 3; k++)
+            {
+                ra += a.halfExtents[k] * std::fabs(glm::dot(a.axes[k], axis));
+                rb += b.halfExtents[k] * std::fabs(glm::dot(b.axes[k], axis));
+            }
+            float sep = std::fabs(glm::dot(t, axis)) - (ra + rb);
+            if (sep > CONTACT_MARGIN) return false;
+            if (sep > edgeSep) { edgeSep = sep; edgeAxis = axis; edgeA = i; edgeB = j; }
+        }
+    }
+
+    // Faces win unless an edge axis is clearly better: face manifolds are what keeps stacks stable
+    const float relativeTolerance = 0.95f, absoluteTolerance = 0.01f;
+    int type = 0;
+    float best = faceASep;
+    if (faceBSep > relativeTolerance * best + absoluteTolerance) { type = 1; best = faceBSep; }
+    if (edgeSep > relativeTolerance * best + absoluteTolerance) { type = 2; best = edgeSep; }
+
+    if (type == 0)
+    {
+        manifold.normal = glm::dot(t, a.axes[faceA]) < 0.0f ? -a.axes[faceA] : a.axes[faceA];
+        manifold.pointCount = ClipFaces(a, faceA, manifold.normal, b, manifold.points);
+    }
+    else if (type == 1)
+    {
+        manifold.normal = glm::dot(t, b.axes[faceB]) < 0.0f ? -b.axes[faceB] : b.axes[faceB];
+        manifold.pointCount = ClipFaces(b, faceB, -manifold.normal, a, manifold.points);
+    }
+    else
+    {
+        manifold.normal = glm::dot(t, edgeAxis) < 0.0f ? -edgeAxis : edgeAxis;
+
+        // Support edges: the edge of each box furthest along the normal towards the other box
+        glm::vec3 pointA = a.center, pointB = b.center;
+        for (int k = 0; k < 3; k++)
+        {
+            if (k != edgeA) pointA += a.axes[k] * (glm::dot(a.axes[k], manifold.normal) > 0.0f ? a.halfExtents[k] : -a.halfExtents[k]);
+            if (k != edgeB) pointB += b.axes[k] * (glm::dot(b.axes[k], manifold.normal) > 0.0f ? -b.halfExtents[k] : b.halfExtents[k]);
+        }
+
+        // Closest points of the two edge segments
+        const glm::vec3& dirA = a.axes[edgeA];
+        const glm::vec3& dirB = b.axes[edgeB];
+        glm::vec3 r = pointA - pointB;
+        float cosAB = glm::dot(dirA, dirB);
+        float c = glm::dot(dirA, r), f = glm::dot(dirB, r);
+        float denom = 1.0f - cosAB * cosAB;
+
+        float s = denom > 1e-6f ? (cosAB * f - c) / denom : 0.0f;
+        s = glm::clamp(s, -a.halfExtents[edgeA], a.halfExtents[edgeA]);
+        float u = glm::clamp(cosAB * s + f, -b.halfExtents[edgeB], b.halfExtents[edgeB]);
+        s = glm::clamp(cosAB * u - c, -a.halfExtents[edgeA], a.halfExtents[edgeA]);
+
+        manifold.pointCount = 1;
+        manifold.points[0].position = ((pointA + dirA * s) + (pointB + dirB * u)) * 0.5f;
+        manifold.points[0].depth = -best;
+    }
+    return manifold.pointCount > 0;
+}
+
+// MANIFOLD REDUCTION
+
+int ReducePoints(ContactPoint* points, int count, const glm::vec3& normal)
+{
+    if (count <= ContactManifold::MAX_POINTS) return count;
+
+    // 1. Deepest point
+    int i0 = 0;
+    for (int i = 1; i < count; i++) if (points[i].depth > points[i0].depth) i0 = i;
+
+    // 2. Farthest from it
+    int i1 = -1;
+    float bestDist = -1.0f;
+    for (int i = 0; i < count; i++)
+    {
+        if (i == i0) continue;
+        glm::vec3 d = points[i].position - points[i0].position;
+        if (glm::dot(d, d) > bestDist) { bestDist = glm::dot(d, d); i1 = i; }
+    }
+
+    // 3. Largest triangle on either side of that line
+    int i2 = -1, i3 = -1;
+    float maxArea = 0.0f, minArea = 0.0f;
+    for (int i = 0; i < count; i++)
+    {
+        if (i == i0 || i == i1) continue;
+        float area = TriangleArea(points[i0].position, points[i1].position, points[i].position, normal);
+        if (i2 < 0 || area > maxArea) { maxArea = area; i2 = i; }
+        if (i3 < 0 || area < minArea) { minArea = area; i3 = i; }
+    }
+
+    // 4. All points on one side: the one furthest from the triangle instead
+    if (i3 == i2 || (maxArea >= 0.0f) == (minArea >= 0.0f))
+    {
+        i3 = -1;
+        float best = -1.0f;
+        for (int i = 0; i < count; i++)
+        {
+            if (i == i0 || i == i1 || i == i2) continue;
+            float area = std::fabs(TriangleArea(points[i0].position, points[i2].position, points[i].position, normal)) +
+                         std::fabs(TriangleArea(points[i1].position, points[i2].position, points[i].position, normal));
+            if (area > best) { best = area; i3 = i; }
+        }
+    }
+
+    ContactPoint kept[4] = { points[i0], points[i1], points[i2], points[i3] };
+    std::copy(kept, kept + 4, points);
+    return 4;
+}
+
+}
@@ -0,0 +1,243 @@
+//
+//  PhysicsWorld.cpp
+//  MyEngine
+//
+//  Created by Priyanshu Kaushik on 19/10/2026.
+//
+
+#include "Physics/PhysicsWorld.h"
+#include <cmath>
+
+void PhysicsWorld::Clear()
+{
+    m_Count = 0;
+    ResizeLanes(0);
+}
+
+void PhysicsWorld::ResizeLanes(size_t size)
+{
+    for (auto* lane : { &m_PosX, &m_PosY, &m_PosZ, &m_PrevX, &m_PrevY, &m_PrevZ, &m_RotX, &m_RotY, &m_RotZ, &m_RotW,
+                        &m_VelX, &m_VelY, &m_VelZ, &m_AngX, &m_AngY, &m_AngZ, &m_AccX, &m_AccY, &m_AccZ,
+                        &m_Gravity, &m_InvMass, &m_InvInertiaX, &m_InvInertiaY, &m_InvInertiaZ, &m_SleepTime, &m_Awake })
+        lane->resize(size, 0.0f);
+    m_Static.resize(size, 1);
+}
+
+// Arrays always hold whole float4 groups; new padding lanes are zero (asleep, not moving)
+void PhysicsWorld::Grow()
+{
+    size_t padded = simd::PaddedCount(m_Count + 1);
+    if (padded > m_PosX.size()) ResizeLanes(padded);
+}
+
+uint32_t PhysicsWorld::AddBody(const glm::vec3& position, const glm::vec3& velocity)
+{
+    Grow();
+    uint32_t body = (uint32_t)m_Count++;
+    Teleport(body, position);
+    SetOrientation(body, glm::quat(1.0f, 0.0f, 0.0f, 0.0f));
+    SetVelocity(body, velocity);
+    SetAngularVelocity(body, glm::vec3(0.0f));
+    SetBodyType(body, 1.0f, 1.0f, false, false);
+    SetInverseInertia(body, glm::vec3(0.0f));
+    Wake(body);
+    return body;
+}
+
+void PhysicsWorld::SetPosition(uint32_t body, const glm::vec3& position)
+{
+    m_PosX[body] = position.x;
+    m_PosY[body] = position.y;
+    m_PosZ[body] = position.z;
+}
+
+void PhysicsWorld::Teleport(uint32_t body, const glm::vec3& position)
+{
+    SetPosition(body, position);
+    m_PrevX[body] = position.x;
+    m_PrevY[body] = position.y;
+    m_PrevZ[body] = position.z;
+}
+
+void PhysicsWorld::SetVelocity(uint32_t body, const glm::vec3& velocity)
+{
+    m_VelX[body] = velocity.x;
+    m_VelY[body] = velocity.y;
+    m_VelZ[body] = velocity.z;
+}
+
+void PhysicsWorld::SetAngularVelocity(uint32_t body, const glm::vec3& angularVelocity)
+{
+    m_AngX[body] = angularVelocity.x;
+    m_AngY[body] = angularVelocity.y;
+    m_AngZ[body] = angularVelocity.z;
+}
+
+void PhysicsWorld::SetOrientation(uint32_t body, const glm::quat& orientation)
+{
+    m_RotX[body] = orientation.x;
+    m_RotY[body] = orientation.y;
+    m_RotZ[body] = orientation.z;
+    m_RotW[body] = orientation.w;
+}
+
+void PhysicsWorld::AddAcceleration(uint32_t body, const glm::vec3& acceleration)
+{
+    m_AccX[body] += acceleration.x;
+    m_AccY[body] += acceleration.y;
+    m_AccZ[body] += acceleration.z;
+}
+
+void PhysicsWorld::SetBodyType(uint32_t body, float mass, float gravityScale, bool isStatic, bool isKinematic)
+{
+    m_Static[body] = isStatic ? 1 : 0;
+    m_InvMass[body] = (isStatic || isKinematic || mass <= 0.0f) ? 0.0f : 1.0f / mass;
+    m_Gravity[body] = isKinematic ? 0.0f : GRAVITY * gravityScale;
+    if (isStatic)
+    {
+        m_Awake[body] = 0.0f;
+        SetVelocity(body, glm::vec3(0.0f));
+        SetAngularVelocity(body, glm::vec3(0.0f));
+    }
+}
+
+void PhysicsWorld::SetInverseInertia(uint32_t body, const glm::vec3& inverseInertia)
+{
+    m_InvInertiaX[body] = inverseInertia.x;
+    m_InvInertiaY[body] = inverseInertia.y;
+    m_InvInertiaZ[body] = inverseInertia.z;
+}
+
+// R * diag(invI) * R^T
+glm::mat3 PhysicsWorld::GetInverseInertiaWorld(uint32_t body) const
+{
+    glm::mat3 rotation = glm::mat3_cast(GetOrientation(body));
+    glm::mat3 scaled(rotation[0] * m_InvInertiaX[body], rotation[1] * m_InvInertiaY[body], rotation[2] * m_InvInertiaZ[body]);
+    return scaled * glm::transpose(rotation);
+}
+
+void PhysicsWorld::Wake(uint32_t body)
+{
+    if (m_Static[body]) return;
+    m_Awake[body] = 1.0f;
+    m_SleepTime[body] = 0.0f;
+}
+
+void PhysicsWorld::Sleep(uint32_t body)
+{
+    m_Awake[body] = 0.0f;
+    SetVelocity(body, glm::vec3(0.0f));
+    SetAngularVelocity(body, glm::vec3(0.0f));
+}
+
+void PhysicsWorld::SavePreviousPositions()
+{
+    m_PrevX = m_PosX;
+    m_PrevY = m_PosY;
+    m_PrevZ = m_PosZ;
+}
+
+// INTEGRATION
+// Velocities first (gravity, acceleration, damping, same order as the old per entity loop),
+// then the contact solver, then positions from the solved velocities.
+
+void PhysicsWorld::IntegrateVelocities(float deltaTime)
+{
+    using namespace simd;
+    const float4 dt = Set1(deltaTime);
+    const float4 damping = Set1(std::pow(DAMPING_PER_60HZ_FRAME, deltaTime * 60.0f));
+    const float4 zero = Set1(0.0f);
+
+    for (size_t i = 0; i < m_PosX.size(); i += WIDTH)
+    {
+        float4 awake = CmpGT(Load(&m_Awake[i]), zero);
+        if (!MoveMask(awake)) continue;
+
+        float4 vx = Mul(MulAdd(Load(&m_AccX[i]), dt, Load(&m_VelX[i])), damping);
+        float4 vy = Mul(MulAdd(Add(Load(&m_AccY[i]), Load(&m_Gravity[i])), dt, Load(&m_VelY[i])), damping);
+        float4 vz = Mul(MulAdd(Load(&m_AccZ[i]), dt, Load(&m_VelZ[i])), damping);
+        Store(&m_VelX[i], Select(awake, vx, Load(&m_VelX[i])));
+        Store(&m_VelY[i], Select(awake, vy, Load(&m_VelY[i])));
+        Store(&m_VelZ[i], Select(awake, vz, Load(&m_VelZ[i])));
+
+        Store(&m_AngX[i], Select(awake, Mul(Load(&m_AngX[i]), damping), Load(&m_AngX[i])));
+        Store(&m_AngY[i], Select(awake, Mul(Load(&m_AngY[i]), damping), Load(&m_AngY[i])));
+        Store(&m_AngZ[i], Select(awake, Mul(Load(&m_AngZ[i]), damping), Load(&m_AngZ[i])));
+
+        Store(&m_AccX[i], zero);
+        Store(&m_AccY[i], zero);
+        Store(&m_AccZ[i], zero);
+    }
+}
+
+void PhysicsWorld::IntegratePositions(float deltaTime)
+{
+    using namespace simd;
+    const float4 dt = Set1(deltaTime);
+    const float4 halfDt = Set1(deltaTime * 0.5f);
+    const float4 zero = Set1(0.0f);
+
+    for (size_t i = 0; i < m_PosX.size(); i += WIDTH)
+    {
+        float4 awake = CmpGT(Load(&m_Awake[i]), zero);
+        if (!MoveMask(awake)) continue;
+
+        float4 px = Load(&m_PosX[i]), py = Load(&m_PosY[i]), pz = Load(&m_PosZ[i]);
+        Store(&m_PosX[i], Select(awake, MulAdd(Load(&m_VelX[i]), dt, px), px));
+        Store(&m_PosY[i], Select(awake, MulAdd(Load(&m_VelY[i]), dt, py), py));
+        Store(&m_PosZ[i], Select(awake, MulAdd(Load(&m_VelZ[i]), dt, pz), pz));
+
+        // q += dt/2 * (w, 0) * q
+        float4 wx = Load(&m_AngX[i]), wy = Load(&m_AngY[i]), wz = Load(&m_AngZ[i]);
+        float4 qx = Load(&m_RotX[i]), qy = Load(&m_RotY[i]), qz = Load(&m_RotZ[i]), qw = Load(&m_RotW[i]);
+
+        float4 dx = Sub(Add(Mul(wx, qw), Mul(wy, qz)), Mul(wz, qy));
+        float4 dy = Sub(Add(Mul(wy, qw), Mul(wz, qx)), Mul(wx, qz));
+        float4 dz = Sub(Add(Mul(wz, qw), Mul(wx, qy)), Mul(wy, qx));
+        float4 dw = Sub(zero, Add(Add(Mul(wx, qx), Mul(wy, qy)), Mul(wz, qz)));
+
+        float4 nx = MulAdd(dx, halfDt, qx), ny = MulAdd(dy, halfDt, qy);
+        float4 nz = MulAdd(dz, halfDt, qz), nw = MulAdd(dw, halfDt, qw);
+        float4 length = Sqrt(MulAdd(nx, nx, MulAdd(ny, ny, MulAdd(nz, nz, Mul(nw, nw)))));
+        float4 valid = And(awake, CmpGT(length, zero));
+
+        Store(&m_RotX[i], Select(valid, Div(nx, length), qx));
+        Store(&m_RotY[i], Select(valid, Div(ny, length), qy));
+        Store(&m_RotZ[i], Select(valid, Div(nz, length), qz));
+        Store(&m_RotW[i], Select(valid, Div(nw, length), qw));
+    }
+}
+
+// SLEEP
+
+void PhysicsWorld::UpdateSleepTimers(float deltaTime)
+{
+    using namespace simd;
+    const float4 dt = Set1(deltaTime);
+    const float4 zero = Set1(0.0f);
+    const float4 sleepSpeedSq = Set1(SLEEP_SPEED * SLEEP_SPEED);
+    const float4 sleepAngularSpeedSq = Set1(SLEEP_ANGULAR_SPEED * SLEEP_ANGULAR_SPEED);
+
+    for (size_t i = 0; i < m_PosX.size(); i += WIDTH)
+    {
+        float4 awake = CmpGT(Load(&m_Awake[i]), zero);
+        if (!MoveMask(awake)) continue;
+
+        float4 vx = Load(&m_VelX[i]), vy = Load(&m_VelY[i]), vz = Load(&m_VelZ[i]);
+        float4 wx = Load(&m_AngX[i]), wy = Load(&m_AngY[i]), wz = Load(&m_AngZ[i]);
+        float4 speedSq = MulAdd(vx, vx, MulAdd(vy, vy, Mul(vz, vz)));
+        float4 angularSpeedSq = MulAdd(wx, wx, MulAdd(wy, wy, Mul(wz, wz)));
+
+        // Crawling bodies stop dead (asleep lanes are already at rest)
+        float4 slow = And(awake, And(CmpLT(speedSq, sleepSpeedSq), CmpLT(angularSpeedSq, sleepAngularSpeedSq)));
+        Store(&m_VelX[i], Select(slow, zero, vx));
+        Store(&m_VelY[i], Select(slow, zero, vy));
+        Store(&m_VelZ[i], Select(slow, zero, vz));
+        Store(&m_AngX[i], Select(slow, zero, wx));
+        Store(&m_AngY[i], Select(slow, zero, wy));
+        Store(&m_AngZ[i], Select(slow, zero, wz));
+
+        float4 rest = Select(slow, Add(Load(&m_SleepTime[i]), dt), zero);
+        Store(&m_SleepTime[i], Select(awake, rest, Load(&m_SleepTime[i])));
+    }
+}
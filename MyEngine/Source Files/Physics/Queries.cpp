@@ -0,0 +1,90 @@
+//
+//  Queries.cpp
+//  MyEngine
+//
+//  Created by Priyanshu Kaushik on 19/10/2026.
+//
+
+#include "Physics/Queries.h"
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+
+namespace Queries {
+
+namespace {
+
+// Clips [0, maxDistance] of the ray against the three slabs. entryAxis is -1 when the ray
+// starts inside the box.
+bool ClipSlabs(const glm::vec3& origin, const glm::vec3& direction, float maxDistance, const glm::vec3& min, const glm::vec3& max, float& entry, float& exit, int& entryAxis)
+{
+    float tMin = 0.0f, tMax = maxDistance;
+    entryAxis = -1;
+    for (int k = 0; k < 3; k++)
+    {
+        if (std::fabs(direction[k]) < 1e-12f)
+        {
+            // Parallel to the slab, inside it or never
+            if (origin[k] < min[k] || origin[k] > max[k]) return false;
+            continue;
+        }
+
+        float inverse = 1.0f / direction[k];
+        float t1 = (min[k] - origin[k]) * inverse;
+        float t2 = (max[k] - origin[k]) * inverse;
+        if (t1 > t2) std::swap(t1, t2);
+        if (t1 > tMin) { tMin = t1; entryAxis = k; }
+        tMax = std::min(tMax, t2);
+        if (tMin > tMax) return false;
+    }
+    entry = tMin;
+    exit = tMax;
+    return true;
+}
+
+}
+
+bool RaySphere(const glm::vec3& origin, const glm::vec3& direction, float maxDistance, const CollisionSphere& sphere, float& distance, glm::vec3& normal)
+{
+    glm::vec3 offset = origin - sphere.center;
+    float along = glm::dot(offset, direction);
+    float outside = glm::dot(offset, offset) - sphere.radius * sphere.radius;
+    if (outside > 0.0f && along > 0.0f) return false;      // Outside and pointing away
+
+    float discriminant = along * along - outside;
+    if (discriminant < 0.0f) return false;
+
+    distance = std::max(-along - std::sqrt(discriminant), 0.0f);
+    if (distance > maxDistance) return false;
+    normal = outside > 0.0f ? glm::normalize(offset + direction * distance) : -direction;
+    return true;
+}
+
+bool RayBox(const glm::vec3& origin, const glm::vec3& direction, float maxDistance, const CollisionBox& box, float& distance, glm::vec3& normal)
+{
+    glm::vec3 offset = origin - box.center;
+    glm::vec3 localOrigin(glm::dot(offset, box.axes[0]), glm::dot(offset, box.axes[1]), glm::dot(offset, box.axes[2]));
+    glm::vec3 localDirection(glm::dot(direction, box.axes[0]), glm::dot(direction, box.axes[1]), glm::dot(direction, box.axes[2]));
+
+    int axis;
+    float exit;
+    if (!ClipSlabs(localOrigin, localDirection, maxDistance, -box.halfExtents, box.halfExtents, distance, exit, axis)) return false;
+    normal = axis < 0 ? -direction : box.axes[axis] * (localDirection[axis] > 0.0f ? -1.0f : 1.0f);
+    return true;
+}
+
+bool RayAABB(const glm::vec3& origin, const glm::vec3& direction, float maxDistance, const glm::vec3& min, const glm::vec3& max, float& entry)
+{
+    int axis;
+    float exit;
+    return ClipSlabs(origin, direction, maxDistance, min, max, entry, exit, axis);
+}
+
+bool ClipSegmentXZ(const glm::vec3& start, const glm::vec3& motion, const glm::vec2& min, const glm::vec2& max, float& enter, float& exit)
+{
+    // Unbounded in Y
+    int axis;
+    return ClipSlabs(start, motion, 1.0f, glm::vec3(min.x, -FLT_MAX, min.y), glm::vec3(max.x, FLT_MAX, max.y), enter, exit, axis);
+}
+
+}
@@ -0,0 +1,64 @@
+//
+//  RenderQueue.cpp
+//  MyEngine
+//
+//  Created by Priyanshu Kaushik on 19/10/2026.
+//
+
+#include "RenderQueue.h"
+#include <algorithm>
+
+uint64_t RenderQueue::MakeKey(RenderPass pass, uint32_t shaderID, uint32_t materialID, uint32_t meshID, float depth01)
+{
+    depth01 = std::clamp(depth01, 0.0f, 1.0f);
+
+    // Farthest first, nothing else may reorder blended draws
+    if (pass == RenderPass::Transparent)
+    {
+        uint64_t inverted = static_cast<uint64_t>((1.0f - depth01) * TRANSPARENT_DEPTH_MASK);
+        return ((static_cast<uint64_t>(pass) & PASS_MASK) << PASS_SHIFT)
+             | ((inverted & TRANSPARENT_DEPTH_MASK) << TRANSPARENT_DEPTH_SHIFT);
+    }
+
+    uint64_t depth = static_cast<uint64_t>(depth01 * DEPTH_MASK);
+
+    return ((static_cast<uint64_t>(pass) & PASS_MASK) << PASS_SHIFT)
+         | ((static_cast<uint64_t>(shaderID) & SHADER_MASK) << SHADER_SHIFT)
+         | ((static_cast<uint64_t>(materialID) & MATERIAL_MASK) << MATERIAL_SHIFT)
+         | ((static_cast<uint64_t>(meshID) & MESH_MASK) << MESH_SHIFT)
+         | (depth & DEPTH_MASK);
+}
+
+// RADIX SORT
+// Sorts indices, not packets, so each pass only moves 4 bytes per element.
+
+void RenderQueue::Sort()
+{
+    size_t count = m_Packets.size();
+    m_Order.resize(count);
+    m_Scratch.resize(count);
+    for (uint32_t i = 0; i < count; i++) m_Order[i] = i;
+    if (count < 2) return;
+
+    for (int shift = 0; shift < 64; shift += 8)
+    {
+        uint32_t histogram[256] = {};
+        for (const auto& packet : m_Packets)
+            histogram[(packet.sortKey >> shift) & 0xFF]++;
+
+        // Every key has the same byte here, nothing to reorder
+        if (histogram[(m_Packets[0].sortKey >> shift) & 0xFF] == count) continue;
+
+        uint32_t offset = 0;
+        for (uint32_t& bucket : histogram) {
+            uint32_t c = bucket;
+            bucket = offset;
+            offset += c;
+        }
+
+        for (uint32_t index : m_Order)
+            m_Scratch[histogram[(m_Packets[index].sortKey >> shift) & 0xFF]++] = index;
+
+        m_Order.swap(m_Scratch);
+    }
+}
@@ -75,7 +75,7 @@ void Scene::Save() {
         
         // 5. RigidBody Component
         if (auto* rb = m_Coordinator.GetComponent<RigidBodyComponent>(entity)) {
-            file << "RigidBody: " << rb->mass << " " << rb->gravityScale << " " << (rb->isStatic? "1" : "0") << " " << (rb->isKinematic? "1" : "0") << "\n";
+            file << "RigidBody: " << rb->mass << " " << rb->gravityScale << " " << (rb->isStatic? "1" : "0") << " " << (rb->isKinematic? "1" : "0") << " " << (rb->freezeRotation? "1" : "0") << " " << (rb->isBullet? "1" : "0") << "\n";
         }
         
         // 6. Collider Component
@@ -115,6 +115,7 @@ void Scene::Save() {
         {
             file << "HeightmapPath: " << terrainComp->heightmapPath << " " << terrainComp->terrainScale << " " << terrainComp->maxHeight
             << " " << terrainComp->mainTexturePath << "\n";
+            if(terrainComp->streamed) file << "TerrainStreamed: 1\n";
         }
         
         // 11. Mesh Component -- save at last
@@ -130,6 +131,7 @@ void Scene::Save() {
             file << "Mat_Ambient: " << mat.Ambient.x << " " << mat.Ambient.y << " " << mat.Ambient.z << "\n";
             file << "Mat_Diffuse: " << mat.Diffuse.x << " " << mat.Diffuse.y << " " << mat.Diffuse.z << "\n";
             file << "Mat_Shininess: " << mat.Shininess << "\n";
+            file << "Mat_Opacity: " << mat.Opacity << "\n";
             
             // Texture Paths
             if (!mat.albedoPath.empty()) file << "Tex_Albedo: " << mat.albedoPath << "\n";
@@ -228,7 +230,7 @@ void Scene::Load(const std::string& filePath) {
             std::cout<<"RigidBody\n";
             RigidBodyComponent rb;
             std::stringstream ss(line.substr(11));
-            ss >> rb.mass >> rb.gravityScale >> rb.isStatic >> rb.isKinematic;
+            ss >> rb.mass >> rb.gravityScale >> rb.isStatic >> rb.isKinematic >> rb.freezeRotation >> rb.isBullet;
             
             m_Coordinator.AddComponent<RigidBodyComponent>(currentEntity, rb);
         }
@@ -289,6 +291,11 @@ void Scene::Load(const std::string& filePath) {
             
             m_Coordinator.AddComponent<TerrainComponent>(currentEntity, terrainComp);
         }
+        else if(line.find("TerrainStreamed: ") == 0)
+        {
+            if(auto* terrainComp = m_Coordinator.GetComponent<TerrainComponent>(currentEntity))
+                terrainComp->streamed = std::stoi(line.substr(17)) != 0;
+        }
         
         // 11. Mesh Component
         else if (line.find("MeshPath: ") == 0) {
@@ -309,6 +316,7 @@ void Scene::Load(const std::string& filePath) {
                 if (tag == "Mat_Ambient:") ss >> mc.material.Ambient.x >> mc.material.Ambient.y >> mc.material.Ambient.z;
                 else if (tag == "Mat_Diffuse:") ss >> mc.material.Diffuse.x >> mc.material.Diffuse.y >> mc.material.Diffuse.z;
                 else if (tag == "Mat_Shininess:") ss >> mc.material.Shininess;
+                else if (tag == "Mat_Opacity:") ss >> mc.material.Opacity;
                 else if (tag == "Tex_Albedo:") {
                     mc.material.albedoPath = matLine.substr(12);
                     AssetManager::Get().GetAsset(mc.material.albedoPath);
@@ -9,6 +9,7 @@
 #include "InputManager.h"
 #include "ECS/Coordinator.h"
 #include "Components.h"
+#include "ECSSystems/PhysicsSystem.h"
 #include <glm/glm.hpp>
 
 void ScriptManager::Init()
@@ -50,6 +51,7 @@ void ScriptManager::Init()
     );
 
     m_Lua.new_usertype<TransformComponent>("Transform",
+        // Written in place; CommitTransformEdits turns the changes into revision bumps
         "position", &TransformComponent::position,
         "rotation", &TransformComponent::rotation,
         "scale", &TransformComponent::scale,
@@ -64,11 +66,14 @@ void ScriptManager::Init()
 
     m_Lua.new_usertype<RigidBodyComponent>("RigidBody",
         "velocity", &RigidBodyComponent::velocity,
+        "angularVelocity", &RigidBodyComponent::angularVelocity,
         "acceleration", &RigidBodyComponent::acceleration,
         "mass", &RigidBodyComponent::mass,
         "gravityScale", &RigidBodyComponent::gravityScale,
         "isStatic", &RigidBodyComponent::isStatic,
         "isKinematic", &RigidBodyComponent::isKinematic,
+        "freezeRotation", &RigidBodyComponent::freezeRotation,
+        "isBullet", &RigidBodyComponent::isBullet,
         "AddForce", &RigidBodyComponent::AddForce
     );
 
@@ -88,7 +93,9 @@ void ScriptManager::Init()
     });
     
     m_Lua.set_function("GetTransform", [&](Entity entity) {
-        return m_Coordinator->GetComponent<TransformComponent>(entity);
+        TransformComponent* transform = m_Coordinator->GetComponent<TransformComponent>(entity);
+        if (transform) WatchTransform(entity, *transform);
+        return transform;
     });
 
     m_Lua.set_function("GetRigidBody", [&](Entity entity) {
@@ -98,12 +105,103 @@ void ScriptManager::Init()
     m_Lua.set_function("GetCamera", [&](Entity entity) {
         return m_Coordinator->GetComponent<CameraComponent>(entity);
     });
+
+    // Physics queries. Casts return a RaycastHit or nil, overlaps a table of entities.
+    m_Lua.new_usertype<RaycastHit>("RaycastHit",
+        "entity", &RaycastHit::entity,
+        "distance", &RaycastHit::distance,
+        "point", &RaycastHit::point,
+        "normal", &RaycastHit::normal
+    );
+
+    m_Lua.set_function("Raycast", [&](const glm::vec3& origin, const glm::vec3& direction, float maxDistance) -> sol::optional<RaycastHit> {
+        RaycastHit hit;
+        if (!m_PhysicsSystem || !m_PhysicsSystem->Raycast(origin, direction, maxDistance, hit)) return sol::nullopt;
+        return hit;
+    });
+
+    m_Lua.set_function("SphereCast", [&](const glm::vec3& origin, float radius, const glm::vec3& direction, float maxDistance) -> sol::optional<RaycastHit> {
+        RaycastHit hit;
+        if (!m_PhysicsSystem || !m_PhysicsSystem->SphereCast(origin, radius, direction, maxDistance, hit)) return sol::nullopt;
+        return hit;
+    });
+
+    m_Lua.set_function("OverlapSphere", [&](const glm::vec3& center, float radius) {
+        std::vector<Entity> entities;
+        if (m_PhysicsSystem) m_PhysicsSystem->OverlapSphere(center, radius, entities);
+        return sol::as_table(std::move(entities));
+    });
+
+    m_Lua.set_function("OverlapBox", [&](const glm::vec3& center, const glm::vec3& halfExtents, const glm::vec3& rotation) {
+        std::vector<Entity> entities;
+        if (m_PhysicsSystem) m_PhysicsSystem->OverlapBox(center, halfExtents, rotation, entities);
+        return sol::as_table(std::move(entities));
+    });
+
+    // Many rays at once (line of sight checks), spread over the job system. One result per
+    // origin/direction pair: a RaycastHit, or false for a miss.
+    m_Lua.set_function("RaycastBatch", [&](sol::table origins, sol::table directions, float maxDistance) {
+        std::vector<RaycastQuery> rays(std::min(origins.size(), directions.size()));
+        for (size_t i = 0; i < rays.size(); i++)
+        {
+            rays[i].origin = origins.get<glm::vec3>(i + 1);
+            rays[i].direction = directions.get<glm::vec3>(i + 1);
+            rays[i].maxDistance = maxDistance;
+        }
+
+        std::vector<RaycastHit> hits;
+        if (m_PhysicsSystem) m_PhysicsSystem->RaycastBatch(rays, hits);
+
+        sol::table results = m_Lua.create_table((int)hits.size(), 0);
+        for (size_t i = 0; i < hits.size(); i++)
+        {
+            if (hits[i].entity != UINT32_MAX) results[i + 1] = hits[i];
+            else results[i + 1] = false;
+        }
+        return results;
+    });
 }
 
 void ScriptManager::SetCoordinator(Coordinator *aCoordinator){
     m_Coordinator = aCoordinator;
 }
 
+void ScriptManager::WatchTransform(Entity entity, const TransformComponent& transform)
+{
+    // First time this frame: remember the values before the script touches them
+    m_WatchedTransforms.try_emplace(entity, WatchedTransform{ transform.position, transform.rotation, transform.scale });
+}
+
+void ScriptManager::BeginTransformEdits()
+{
+    // Physics and the editor moved transforms since the last commit, start from their values
+    for (auto it = m_WatchedTransforms.begin(); it != m_WatchedTransforms.end();)
+    {
+        TransformComponent* transform = m_Coordinator->GetComponent<TransformComponent>(it->first);
+        if (!transform) { it = m_WatchedTransforms.erase(it); continue; }
+        it->second = { transform->position, transform->rotation, transform->scale };
+        ++it;
+    }
+}
+
+void ScriptManager::CommitTransformEdits()
+{
+    for (auto it = m_WatchedTransforms.begin(); it != m_WatchedTransforms.end();)
+    {
+        TransformComponent* transform = m_Coordinator->GetComponent<TransformComponent>(it->first);
+        if (!transform) { it = m_WatchedTransforms.erase(it); continue; }
+        
+        WatchedTransform& watched = it->second;
+        if (transform->position != watched.position || transform->rotation != watched.rotation || transform->scale != watched.scale)
+        {
+            transform->isDirty = true;
+            transform->revision++;
+            watched = { transform->position, transform->rotation, transform->scale };
+        }
+        ++it;
+    }
+}
+
 sol::environment ScriptManager::CreateEntityEnvironment(const std::string &scriptPath)
 {
     sol::environment env(m_Lua, sol::create, m_Lua.globals());
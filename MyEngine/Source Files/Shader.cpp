@@ -6,6 +6,7 @@
 //
 
 #include "Shader.h"
+#include "UniformBuffer.h"
 #include <iostream>
 #include <fstream>
 #include <sstream>
@@ -111,6 +112,7 @@ void Shader::Reload()
         glDeleteProgram(shaderProgram);
     }
     shaderProgram = newProgram;
+    ReflectUniforms();
     std::cout << "Shader Hot Reloaded Successfully!" << std::endl;
     
     glDeleteShader(VertexShader);
@@ -118,43 +120,98 @@ void Shader::Reload()
 
 }
 
+// UNIFORM REFLECTION
+// Builds the name hash -> location table and attaches the shared uniform blocks
+// to their binding points (GLSL 330 has no layout(binding)).
+
+void Shader::ReflectUniforms()
+{
+    m_UniformLocations.clear();
+    
+    GLint uniformCount = 0;
+    glGetProgramiv(shaderProgram, GL_ACTIVE_UNIFORMS, &uniformCount);
+    
+    char nameBuffer[256];
+    for (GLint i = 0; i < uniformCount; i++)
+    {
+        GLsizei length = 0;
+        GLint size = 0;
+        GLenum type = 0;
+        glGetActiveUniform(shaderProgram, i, sizeof(nameBuffer), &length, &size, &type, nameBuffer);
+        
+        std::string name(nameBuffer, length);
+        GLint location = glGetUniformLocation(shaderProgram, name.c_str());
+        if (location < 0) continue; // Uniform block member
+        
+        m_UniformLocations[UniformID::Hash(name.c_str())] = location;
+        
+        // Arrays are reported as "name[0]": register the bare name and every element
+        if (name.size() > 3 && name.compare(name.size() - 3, 3, "[0]") == 0)
+        {
+            std::string base = name.substr(0, name.size() - 3);
+            m_UniformLocations[UniformID::Hash(base.c_str())] = location;
+            for (GLint element = 1; element < size; element++)
+            {
+                std::string elementName = base + "[" + std::to_string(element) + "]";
+                m_UniformLocations[UniformID::Hash(elementName.c_str())] = glGetUniformLocation(shaderProgram, elementName.c_str());
+            }
+        }
+    }
+    
+    const std::pair<const char*, UniformBinding> blocks[] = {
+        { "FrameData", UniformBinding::Frame },
+        { "LightData", UniformBinding::Light },
+        { "MaterialData", UniformBinding::Material }
+    };
+    for (const auto& [blockName, binding] : blocks)
+    {
+        GLuint blockIndex = glGetUniformBlockIndex(shaderProgram, blockName);
+        if (blockIndex != GL_INVALID_INDEX)
+            glUniformBlockBinding(shaderProgram, blockIndex, static_cast<GLuint>(binding));
+    }
+}
+
+int Shader::GetUniformLocation(UniformID name) const
+{
+    auto it = m_UniformLocations.find(name.hash);
+    return it != m_UniformLocations.end() ? it->second : -1;
+}
+
 void Shader::Use(){
     glUseProgram(shaderProgram);
 }
 
-void Shader::SetMatrix4(glm::mat4 aMatrix, const std::string& aName) const{
-    glUniformMatrix4fv(glGetUniformLocation(shaderProgram, aName.c_str()), 1, GL_FALSE, glm::value_ptr(aMatrix));
+void Shader::SetMatrix4(const glm::mat4& aMatrix, UniformID aName) const{
+    glUniformMatrix4fv(GetUniformLocation(aName), 1, GL_FALSE, glm::value_ptr(aMatrix));
 }
 
-void Shader::SetBool(bool booleanToSet, const std::string &aName) const{
-    glUniform1i(glGetUniformLocation(shaderProgram, aName.c_str()), (int)booleanToSet);
+void Shader::SetBool(bool booleanToSet, UniformID aName) const{
+    glUniform1i(GetUniformLocation(aName), (int)booleanToSet);
 }
 
-void Shader::SetVec3(const std::string &name, const glm::vec3 &value) const {
-    glUniform3fv(glGetUniformLocation(shaderProgram, name.c_str()), 1, &value[0]);
+void Shader::SetVec3(UniformID name, const glm::vec3 &value) const {
+    glUniform3fv(GetUniformLocation(name), 1, &value[0]);
 }
 
-void Shader::SetFloat(const std::string &name, float value) const {
-    glUniform1f(glGetUniformLocation(shaderProgram, name.c_str()), value);
+void Shader::SetFloat(UniformID name, float value) const {
+    glUniform1f(GetUniformLocation(name), value);
 }
 
-void Shader::SetVec3Array(const std::string& name, const std::vector<glm::vec3>& values) const
+void Shader::SetVec3Array(UniformID name, const std::vector<glm::vec3>& values) const
 {
-    GLint location = glGetUniformLocation(shaderProgram, name.c_str());
-    glUniform3fv(location, (GLsizei)values.size(), glm::value_ptr(values[0]));
+    glUniform3fv(GetUniformLocation(name), (GLsizei)values.size(), glm::value_ptr(values[0]));
 }
 
-void Shader::SetInt(const std::string &name, int value) const{
-    glUniform1i(glGetUniformLocation(shaderProgram, name.c_str()), value);
+void Shader::SetInt(UniformID name, int value) const{
+    glUniform1i(GetUniformLocation(name), value);
 }
 
-void Shader::SetVec4(const std::string &name, const glm::vec4 &value) const
+void Shader::SetVec4(UniformID name, const glm::vec4 &value) const
 {
-    glUniform4fv(glGetUniformLocation(shaderProgram, name.c_str()), 1, &value[0]);
+    glUniform4fv(GetUniformLocation(name), 1, &value[0]);
 }
 
-void Shader::SetVec4Array(const std::string &name, const std::vector<glm::vec4> &values) const
+void Shader::SetVec4Array(UniformID name, const std::vector<glm::vec4> &values) const
 {
-    GLint location = glGetUniformLocation(shaderProgram, name.c_str());
-    glUniform4fv(location, (GLsizei)values.size(), glm::value_ptr(values[0]));
+    glUniform4fv(GetUniformLocation(name), (GLsizei)values.size(), glm::value_ptr(values[0]));
 }
@@ -0,0 +1,412 @@
+//
+//  TerrainStreamer.cpp
+//  MyEngine
+//
+//  Created by Priyanshu Kaushik on 19/10/2026.
+//
+
+#include "TerrainStreamer.h"
+#include "ECSSystems/TerrainSystem.h"
+#include "JobSystem.h"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+static_assert(TerrainTileFile::TILE_QUADS == TerrainSystem::CHUNK_QUADS,
+              "Streamed tiles are drawn with the shared chunk index buffer");
+
+static constexpr int CHUNK_VERTS = TerrainSystem::CHUNK_VERTS;
+static constexpr int CHUNK_GRID_VERTICES = TerrainSystem::CHUNK_GRID_VERTICES;
+static constexpr int CHUNK_VERTEX_COUNT = TerrainSystem::CHUNK_VERTEX_COUNT;
+static constexpr int TILE_QUADS = TerrainTileFile::TILE_QUADS;
+static constexpr int TILE_SAMPLES = TerrainTileFile::TILE_SAMPLES;
+static constexpr int APRON = TerrainTileFile::APRON;
+
+bool TerrainStreamer::Open(const std::string& tilePath, GLuint chunkIndexBuffer, size_t memoryBudget)
+{
+    Close();
+
+    auto file = std::make_shared<TerrainTileFile>();
+    if (!file->Open(tilePath)) return false;
+
+    m_File = file;
+    m_LoadQueue = std::make_shared<LoadQueue>();
+
+    // 1. Slot count from the budget: GPU vertices + the samples kept on the CPU per tile. Never
+    // more slots than the pyramid has tiles, so a small terrain does not reserve the whole budget.
+    size_t tileBytes = CHUNK_VERTEX_COUNT * sizeof(Vertex) + TILE_SAMPLES * TILE_SAMPLES * sizeof(uint16_t);
+    int topLevel = m_File->GetLevelCount() - 1;
+    size_t pinnedCount = (size_t)m_File->GetTilesX(topLevel) * m_File->GetTilesZ(topLevel);
+    size_t budgetSlots = std::max(memoryBudget / tileBytes, pinnedCount + 16);
+    m_SlotCount = std::min(budgetSlots, m_File->GetTileCount());
+    m_FreeSlots.resize(m_SlotCount);
+    for (size_t i = 0; i < m_SlotCount; i++) m_FreeSlots[i] = (int)(m_SlotCount - 1 - i);
+
+    // 2. One VBO, one fixed size slot per resident tile. Indices come from TerrainSystem.
+    glGenVertexArrays(1, &m_VAO);
+    glGenBuffers(1, &m_VBO);
+
+    glBindVertexArray(m_VAO);
+    glBindBuffer(GL_ARRAY_BUFFER, m_VBO);
+    glBufferData(GL_ARRAY_BUFFER, m_SlotCount * CHUNK_VERTEX_COUNT * sizeof(Vertex), nullptr, GL_DYNAMIC_DRAW);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, chunkIndexBuffer);
+
+    // Position
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)0);
+    // Normal
+    glEnableVertexAttribArray(1);
+    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, normal));
+    // UVs
+    glEnableVertexAttribArray(2);
+    glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, uv));
+
+    glBindVertexArray(0);
+
+    // 3. The coarsest level is loaded right away and stays, so there is always something to draw.
+    // Meshes are built on the first Update, once the terrain's scale is known.
+    for (int z = 0; z < m_File->GetTilesZ(topLevel); z++)
+    {
+        for (int x = 0; x < m_File->GetTilesX(topLevel); x++)
+        {
+            uint64_t key = MakeKey(topLevel, x, z);
+            Tile& tile = m_Resident[key];
+            tile.level = topLevel;
+            tile.x = x;
+            tile.z = z;
+            tile.pinned = true;
+            tile.slot = AcquireSlot();
+            m_LRU.push_front(key);
+            tile.lru = m_LRU.begin();
+
+            if (!m_File->ReadTile(topLevel, x, z, tile.samples))
+            {
+                std::cout << "Failed to read terrain tile: " << tilePath << std::endl;
+                Close();
+                return false;
+            }
+        }
+    }
+
+    m_BuiltScale = 0.0f;
+    m_BuiltMaxHeight = 0.0f;
+    return true;
+}
+
+void TerrainStreamer::Close()
+{
+    // Loads still running keep their own references to the file and queue
+    m_File.reset();
+    m_LoadQueue.reset();
+    m_InFlight.clear();
+    m_Failed.clear();
+
+    m_Resident.clear();
+    m_LRU.clear();
+    m_FreeSlots.clear();
+    m_SlotCount = 0;
+
+    m_Requests.clear();
+    m_DrawList.clear();
+
+    if (m_VBO) glDeleteBuffers(1, &m_VBO);
+    if (m_VAO) glDeleteVertexArrays(1, &m_VAO);
+    m_VBO = 0;
+    m_VAO = 0;
+}
+
+void TerrainStreamer::Update(const TerrainComponent& terrain, const glm::vec3& cameraLocal, float refineDistance)
+{
+    if (!m_File) return;
+    m_Frame++;
+
+    // 1. Mesh parameters changed: rebuild every resident tile
+    if (terrain.terrainScale != m_BuiltScale || terrain.maxHeight != m_BuiltMaxHeight)
+    {
+        m_BuiltScale = terrain.terrainScale;
+        m_BuiltMaxHeight = terrain.maxHeight;
+        for (auto& [key, tile] : m_Resident) UploadTile(terrain, tile);
+    }
+
+    // 2. Tiles decoded since the last frame
+    ReceiveLoads(terrain);
+
+    // 3. Selection, from the coarsest level down
+    m_DrawList.clear();
+    m_Requests.clear();
+    int topLevel = m_File->GetLevelCount() - 1;
+    for (int z = 0; z < m_File->GetTilesZ(topLevel); z++)
+        for (int x = 0; x < m_File->GetTilesX(topLevel); x++)
+            Select(topLevel, x, z, cameraLocal, refineDistance);
+
+    // 4. Missing tiles
+    IssueLoads();
+}
+
+// A tile is split into its children when it is close enough and all of them are resident,
+// otherwise it is drawn. Resident children are kept warm even while their parent is drawn.
+void TerrainStreamer::Select(int level, int x, int z, const glm::vec3& cameraLocal, float refineDistance)
+{
+    Tile* tile = Find(level, x, z);
+    if (!tile) return;
+    Touch(*tile);
+
+    AABB bounds = GetTileBounds(level, x, z);
+
+    if (level > 0)
+    {
+        float distance = std::sqrt(bounds.DistanceSq(cameraLocal));
+        if (distance < refineDistance * (float)(1 << (level - 1)))
+        {
+            int childLevel = level - 1;
+            int x1 = std::min(2 * x + 2, m_File->GetTilesX(childLevel));
+            int z1 = std::min(2 * z + 2, m_File->GetTilesZ(childLevel));
+
+            bool allResident = true;
+            for (int cz = 2 * z; cz < z1; cz++)
+            {
+                for (int cx = 2 * x; cx < x1; cx++)
+                {
+                    if (Tile* child = Find(childLevel, cx, cz)) Touch(*child);
+                    else
+                    {
+                        allResident = false;
+                        RequestTile(childLevel, cx, cz, distance);
+                    }
+                }
+            }
+
+            if (allResident)
+            {
+                for (int cz = 2 * z; cz < z1; cz++)
+                    for (int cx = 2 * x; cx < x1; cx++)
+                        Select(childLevel, cx, cz, cameraLocal, refineDistance);
+                return;
+            }
+        }
+    }
+
+    DrawTile draw;
+    draw.bounds = bounds;
+    draw.baseVertex = tile->slot * CHUNK_VERTEX_COUNT;
+    m_DrawList.push_back(draw);
+}
+
+TerrainStreamer::Tile* TerrainStreamer::Find(int level, int x, int z)
+{
+    auto it = m_Resident.find(MakeKey(level, x, z));
+    return it != m_Resident.end() ? &it->second : nullptr;
+}
+
+const TerrainStreamer::Tile* TerrainStreamer::Find(int level, int x, int z) const
+{
+    auto it = m_Resident.find(MakeKey(level, x, z));
+    return it != m_Resident.end() ? &it->second : nullptr;
+}
+
+void TerrainStreamer::Touch(Tile& tile)
+{
+    tile.lastUsedFrame = m_Frame;
+    m_LRU.splice(m_LRU.begin(), m_LRU, tile.lru);
+}
+
+void TerrainStreamer::RequestTile(int level, int x, int z, float distance)
+{
+    uint64_t key = MakeKey(level, x, z);
+    if (m_InFlight.count(key) || m_Failed.count(key)) return;
+    m_Requests.push_back({ level, x, z, distance });
+}
+
+// LOADING
+
+void TerrainStreamer::IssueLoads()
+{
+    // Coarse levels first (they unlock the finer ones), then nearest first
+    std::sort(m_Requests.begin(), m_Requests.end(), [](const Request& a, const Request& b) {
+        if (a.level != b.level) return a.level > b.level;
+        return a.distance < b.distance;
+    });
+
+    for (const Request& request : m_Requests)
+    {
+        if ((int)m_InFlight.size() >= MAX_LOADS_IN_FLIGHT) break;
+
+        uint64_t key = MakeKey(request.level, request.x, request.z);
+        m_InFlight.insert(key);
+
+        std::shared_ptr<TerrainTileFile> file = m_File;
+        std::shared_ptr<LoadQueue> queue = m_LoadQueue;
+        int level = request.level, x = request.x, z = request.z;
+
+        JobSystem::Get().Execute([file, queue, key, level, x, z]() {
+            LoadedTile loaded;
+            loaded.key = key;
+            loaded.ok = file->ReadTile(level, x, z, loaded.samples);
+
+            std::lock_guard<std::mutex> lock(queue->mutex);
+            queue->done.push_back(std::move(loaded));
+        });
+    }
+}
+
+void TerrainStreamer::ReceiveLoads(const TerrainComponent& terrain)
+{
+    std::vector<LoadedTile> done;
+    {
+        std::lock_guard<std::mutex> lock(m_LoadQueue->mutex);
+        done.swap(m_LoadQueue->done);
+    }
+
+    for (LoadedTile& loaded : done)
+    {
+        m_InFlight.erase(loaded.key);
+        if (!loaded.ok)
+        {
+            std::cout << "Failed to read terrain tile " << loaded.key << std::endl;
+            m_Failed.insert(loaded.key);
+            continue;
+        }
+
+        // Budget used up by tiles still in use: drop it, it is requested again if still needed
+        int slot = AcquireSlot();
+        if (slot < 0) continue;
+
+        Tile& tile = m_Resident[loaded.key];
+        tile.level = (int)(loaded.key >> 48);
+        tile.z = (int)((loaded.key >> 24) & 0xFFFFFF);
+        tile.x = (int)(loaded.key & 0xFFFFFF);
+        tile.slot = slot;
+        tile.lastUsedFrame = m_Frame;
+        tile.samples = std::move(loaded.samples);
+        m_LRU.push_front(loaded.key);
+        tile.lru = m_LRU.begin();
+
+        UploadTile(terrain, tile);
+    }
+}
+
+// Free slot, or the one of the least recently used tile that was not used in the last frame
+int TerrainStreamer::AcquireSlot()
+{
+    if (!m_FreeSlots.empty())
+    {
+        int slot = m_FreeSlots.back();
+        m_FreeSlots.pop_back();
+        return slot;
+    }
+
+    for (auto it = m_LRU.rbegin(); it != m_LRU.rend(); ++it)
+    {
+        auto tileIt = m_Resident.find(*it);
+        if (tileIt->second.pinned) continue;
+        if (tileIt->second.lastUsedFrame + 1 >= m_Frame) return -1;   // Everything else is newer
+
+        int slot = tileIt->second.slot;
+        m_LRU.erase(std::next(it).base());
+        m_Resident.erase(tileIt);
+        return slot;
+    }
+    return -1;
+}
+
+// TILE MESH
+// Same vertex layout as a TerrainSystem chunk: the CHUNK_VERTS^2 grid, then 4 skirts.
+
+void TerrainStreamer::UploadTile(const TerrainComponent& terrain, const Tile& tile)
+{
+    const TerrainTileEntry& entry = m_File->GetEntry(tile.level, tile.x, tile.z);
+    int width = m_File->GetWidth(), height = m_File->GetHeight();
+    int step = 1 << tile.level;
+    float heightScale = terrain.maxHeight / 65535.0f;
+
+    auto sampleHeight = [&](int i, int j) { return tile.samples[j * TILE_SAMPLES + i] * heightScale; };
+
+    m_Scratch.resize(CHUNK_VERTEX_COUNT);
+    for (int z = 0; z < CHUNK_VERTS; z++) {
+        for (int x = 0; x < CHUNK_VERTS; x++) {
+            int gx = std::min((tile.x * TILE_QUADS + x) * step, width - 1);
+            int gz = std::min((tile.z * TILE_QUADS + z) * step, height - 1);
+            int i = x + APRON, j = z + APRON;
+
+            // Central differences over the apron, neighbours are step texels apart
+            float hL = sampleHeight(i - 1, j), hR = sampleHeight(i + 1, j);
+            float hD = sampleHeight(i, j - 1), hU = sampleHeight(i, j + 1);
+
+            Vertex& v = m_Scratch[z * CHUNK_VERTS + x];
+            v.position = glm::vec3(gx * terrain.terrainScale, sampleHeight(i, j), gz * terrain.terrainScale);
+            v.normal = glm::normalize(glm::vec3(hL - hR, 2.0f * step * terrain.terrainScale, hD - hU));
+            v.uv = glm::vec2((float)gx / (width - 1), (float)gz / (height - 1));
+            v.tangent = glm::vec3(0.0f);
+        }
+    }
+
+    float skirtDepth = (entry.maxHeight - entry.minHeight) * heightScale + terrain.terrainScale * step;
+    for (int edge = 0; edge < 4; edge++) {
+        for (int i = 0; i < CHUNK_VERTS; i++) {
+            int x = edge == 2 ? 0 : edge == 3 ? TILE_QUADS : i;
+            int z = edge == 0 ? 0 : edge == 1 ? TILE_QUADS : i;
+            Vertex skirt = m_Scratch[z * CHUNK_VERTS + x];
+            skirt.position.y -= skirtDepth;
+            m_Scratch[CHUNK_GRID_VERTICES + edge * CHUNK_VERTS + i] = skirt;
+        }
+    }
+
+    glBindBuffer(GL_ARRAY_BUFFER, m_VBO);
+    glBufferSubData(GL_ARRAY_BUFFER, (GLintptr)tile.slot * CHUNK_VERTEX_COUNT * sizeof(Vertex),
+                    CHUNK_VERTEX_COUNT * sizeof(Vertex), m_Scratch.data());
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+// From the directory alone, so tiles can be culled and ranked before they are loaded
+AABB TerrainStreamer::GetTileBounds(int level, int x, int z) const
+{
+    const TerrainTileEntry& entry = m_File->GetEntry(level, x, z);
+    int width = m_File->GetWidth(), height = m_File->GetHeight();
+    int span = TILE_QUADS << level;
+    float heightScale = m_BuiltMaxHeight / 65535.0f;
+    float skirtDepth = (entry.maxHeight - entry.minHeight) * heightScale + m_BuiltScale * (1 << level);
+
+    AABB bounds;
+    bounds.min = glm::vec3(std::min(x * span, width - 1) * m_BuiltScale,
+                           entry.minHeight * heightScale - skirtDepth,
+                           std::min(z * span, height - 1) * m_BuiltScale);
+    bounds.max = glm::vec3(std::min((x + 1) * span, width - 1) * m_BuiltScale,
+                           entry.maxHeight * heightScale,
+                           std::min((z + 1) * span, height - 1) * m_BuiltScale);
+    return bounds;
+}
+
+// HEIGHT QUERIES
+
+bool TerrainStreamer::SampleHeight(float gridX, float gridZ, float& outHeight) const
+{
+    if (!m_File) return false;
+    gridX = std::clamp(gridX, 0.0f, (float)(m_File->GetWidth() - 1));
+    gridZ = std::clamp(gridZ, 0.0f, (float)(m_File->GetHeight() - 1));
+
+    // Finest resident level wins
+    for (int level = 0; level < m_File->GetLevelCount(); level++)
+    {
+        float step = (float)(1 << level);
+        float levelX = gridX / step, levelZ = gridZ / step;
+        int tx = std::min((int)levelX / TILE_QUADS, m_File->GetTilesX(level) - 1);
+        int tz = std::min((int)levelZ / TILE_QUADS, m_File->GetTilesZ(level) - 1);
+
+        const Tile* tile = Find(level, tx, tz);
+        if (!tile) continue;
+
+        float localX = levelX - tx * TILE_QUADS, localZ = levelZ - tz * TILE_QUADS;
+        int x0 = std::min((int)localX, TILE_QUADS - 1);
+        int z0 = std::min((int)localZ, TILE_QUADS - 1);
+        float dx = localX - x0, dz = localZ - z0;
+
+        auto sample = [&](int x, int z) {
+            return tile->samples[(z + APRON) * TILE_SAMPLES + (x + APRON)] / 65535.0f;
+        };
+        float heightTop = (1.0f - dx) * sample(x0, z0) + dx * sample(x0 + 1, z0);
+        float heightBottom = (1.0f - dx) * sample(x0, z0 + 1) + dx * sample(x0 + 1, z0 + 1);
+        outHeight = (1.0f - dz) * heightTop + dz * heightBottom;
+        return true;
+    }
+    return false;
+}
@@ -0,0 +1,209 @@
+//
+//  TerrainTileFile.cpp
+//  MyEngine
+//
+//  Created by Priyanshu Kaushik on 19/10/2026.
+//
+
+#include "TerrainTileFile.h"
+#include "stb_image.h"
+#include <fstream>
+#include <iostream>
+#include <algorithm>
+
+std::vector<TerrainTileFile::Level> TerrainTileFile::ComputeLevels(int width, int height)
+{
+    std::vector<Level> levels;
+    int chunksX = (width - 2) / TILE_QUADS + 1;
+    int chunksZ = (height - 2) / TILE_QUADS + 1;
+
+    uint32_t firstEntry = 0;
+    for (int level = 0; ; level++)
+    {
+        Level l;
+        l.tilesX = (chunksX + (1 << level) - 1) >> level;
+        l.tilesZ = (chunksZ + (1 << level) - 1) >> level;
+        l.firstEntry = firstEntry;
+        levels.push_back(l);
+        firstEntry += l.tilesX * l.tilesZ;
+        if (l.tilesX == 1 && l.tilesZ == 1) break;
+    }
+    return levels;
+}
+
+// BUILD
+
+bool TerrainTileFile::Build(const std::string& heightmapPath, const std::string& tilePath)
+{
+    // Same orientation as TextureManager::LoadRawData, 8 bit sources are widened to 16
+    int width = 0, height = 0, channels = 0;
+    stbi_set_flip_vertically_on_load(true);
+    stbi_us* pixels = stbi_load_16(heightmapPath.c_str(), &width, &height, &channels, 1);
+    if (!pixels || width < 2 || height < 2)
+    {
+        std::cout << "Failed to load heightmap for tiling: " << heightmapPath << std::endl;
+        if (pixels) stbi_image_free(pixels);
+        return false;
+    }
+
+    std::ofstream out(tilePath, std::ios::binary);
+    if (!out.is_open())
+    {
+        std::cout << "Failed to save terrain tiles: " << tilePath << std::endl;
+        stbi_image_free(pixels);
+        return false;
+    }
+
+    std::vector<Level> levels = ComputeLevels(width, height);
+    uint32_t levelCount = (uint32_t)levels.size();
+    std::vector<TerrainTileEntry> entries(levels.back().firstEntry + 1);
+
+    out.write((char*)&MAGIC, sizeof(uint32_t));
+    out.write((char*)&VERSION, sizeof(uint32_t));
+    out.write((char*)&width, sizeof(int));
+    out.write((char*)&height, sizeof(int));
+    out.write((char*)&levelCount, sizeof(uint32_t));
+
+    // Directory is written again once the offsets are known
+    std::streamoff directoryOffset = out.tellp();
+    out.write((char*)entries.data(), entries.size() * sizeof(TerrainTileEntry));
+
+    std::vector<uint16_t> samples(TILE_SAMPLES * TILE_SAMPLES);
+    std::vector<uint8_t> blob;
+
+    for (uint32_t level = 0; level < levelCount; level++)
+    {
+        int step = 1 << level;
+        for (int tz = 0; tz < levels[level].tilesZ; tz++)
+        {
+            for (int tx = 0; tx < levels[level].tilesX; tx++)
+            {
+                TerrainTileEntry& entry = entries[levels[level].firstEntry + tz * levels[level].tilesX + tx];
+                entry.minHeight = UINT16_MAX;
+                entry.maxHeight = 0;
+
+                for (int j = 0; j < TILE_SAMPLES; j++)
+                {
+                    int gz = std::clamp((tz * TILE_QUADS + j - APRON) * step, 0, height - 1);
+                    for (int i = 0; i < TILE_SAMPLES; i++)
+                    {
+                        int gx = std::clamp((tx * TILE_QUADS + i - APRON) * step, 0, width - 1);
+                        uint16_t h = pixels[gz * width + gx];
+                        samples[j * TILE_SAMPLES + i] = h;
+
+                        bool apron = i < APRON || j < APRON || i >= TILE_SAMPLES - APRON || j >= TILE_SAMPLES - APRON;
+                        if (apron) continue;
+                        entry.minHeight = std::min(entry.minHeight, h);
+                        entry.maxHeight = std::max(entry.maxHeight, h);
+                    }
+                }
+
+                Encode(samples, blob);
+                entry.offset = (uint64_t)out.tellp();
+                entry.size = (uint32_t)blob.size();
+                out.write((char*)blob.data(), blob.size());
+            }
+        }
+    }
+
+    out.seekp(directoryOffset);
+    out.write((char*)entries.data(), entries.size() * sizeof(TerrainTileEntry));
+    out.close();
+
+    stbi_image_free(pixels);
+    return true;
+}
+
+// READ
+
+bool TerrainTileFile::Open(const std::string& tilePath)
+{
+    std::ifstream in(tilePath, std::ios::binary);
+    if (!in.is_open())
+    {
+        std::cout << "Failed to open terrain tiles: " << tilePath << std::endl;
+        return false;
+    }
+
+    uint32_t magic = 0, version = 0, levelCount = 0;
+    in.read((char*)&magic, sizeof(uint32_t));
+    in.read((char*)&version, sizeof(uint32_t));
+    in.read((char*)&m_Width, sizeof(int));
+    in.read((char*)&m_Height, sizeof(int));
+    in.read((char*)&levelCount, sizeof(uint32_t));
+    if (!in || magic != MAGIC || version != VERSION || m_Width < 2 || m_Height < 2) return false;
+
+    m_Levels = ComputeLevels(m_Width, m_Height);
+    if (m_Levels.size() != levelCount) return false;
+
+    m_Entries.resize(m_Levels.back().firstEntry + 1);
+    in.read((char*)m_Entries.data(), m_Entries.size() * sizeof(TerrainTileEntry));
+    if (!in) return false;
+
+    m_Path = tilePath;
+    return true;
+}
+
+bool TerrainTileFile::ReadTile(int level, int x, int z, std::vector<uint16_t>& outSamples) const
+{
+    const TerrainTileEntry& entry = GetEntry(level, x, z);
+
+    std::ifstream in(m_Path, std::ios::binary);
+    if (!in.is_open()) return false;
+
+    std::vector<uint8_t> blob(entry.size);
+    in.seekg((std::streamoff)entry.offset);
+    in.read((char*)blob.data(), blob.size());
+    if (!in) return false;
+
+    return Decode(blob.data(), blob.size(), outSamples);
+}
+
+// CODEC
+// Each sample is stored as the difference to its left neighbour (first column: to the sample
+// above), zigzag mapped and written as a varint. Smooth terrain mostly needs 1 byte per sample.
+
+void TerrainTileFile::Encode(const std::vector<uint16_t>& samples, std::vector<uint8_t>& out)
+{
+    out.clear();
+    for (int j = 0; j < TILE_SAMPLES; j++)
+    {
+        for (int i = 0; i < TILE_SAMPLES; i++)
+        {
+            int predicted = i > 0 ? samples[j * TILE_SAMPLES + i - 1] : (j > 0 ? samples[(j - 1) * TILE_SAMPLES] : 0);
+            int32_t delta = (int32_t)samples[j * TILE_SAMPLES + i] - predicted;
+            uint32_t zigzag = ((uint32_t)delta << 1) ^ (uint32_t)(delta >> 31);
+            do {
+                uint8_t byte = zigzag & 0x7F;
+                zigzag >>= 7;
+                out.push_back(zigzag ? (byte | 0x80) : byte);
+            } while (zigzag);
+        }
+    }
+}
+
+bool TerrainTileFile::Decode(const uint8_t* data, size_t size, std::vector<uint16_t>& outSamples)
+{
+    outSamples.resize(TILE_SAMPLES * TILE_SAMPLES);
+    size_t cursor = 0;
+    for (int j = 0; j < TILE_SAMPLES; j++)
+    {
+        for (int i = 0; i < TILE_SAMPLES; i++)
+        {
+            uint32_t zigzag = 0;
+            int shift = 0;
+            while (true)
+            {
+                if (cursor >= size || shift > 28) return false;
+                uint8_t byte = data[cursor++];
+                zigzag |= (uint32_t)(byte & 0x7F) << shift;
+                if (!(byte & 0x80)) break;
+                shift += 7;
+            }
+            int32_t delta = (int32_t)(zigzag >> 1) ^ -(int32_t)(zigzag & 1);
+            int predicted = i > 0 ? outSamples[j * TILE_SAMPLES + i - 1] : (j > 0 ? outSamples[(j - 1) * TILE_SAMPLES] : 0);
+            outSamples[j * TILE_SAMPLES + i] = (uint16_t)(predicted + delta);
+        }
+    }
+    return true;
+}
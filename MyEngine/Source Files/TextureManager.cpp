@@ -63,6 +63,11 @@ unsigned char* TextureManager::LoadRawData(const std::string& path, int& width,
     return stbi_load(path.c_str(), &width, &height, &channels, 1);
 }
 
+unsigned short* TextureManager::LoadRawData16(const std::string& path, int& width, int& height, int& channels) {
+    stbi_set_flip_vertically_on_load(true);
+    return stbi_load_16(path.c_str(), &width, &height, &channels, 1);
+}
+
 AssetHandle TextureManager::GetTexture(uint32_t textureId){
     AssetHandle result;
     if(textureId==UINT32_MAX){
@@ -186,6 +186,13 @@ void InspectorPanel::ShowTerrainComponent()
             
         }
         
+        // Applied in place by TerrainSystem::Update, no rebuild
+        ImGui::DragFloat("Scale", &terrain->terrainScale, 0.05f, 0.05f, 100.0f);
+        ImGui::DragFloat("Max Height", &terrain->maxHeight, 0.1f, 0.0f, 1000.0f);
+        
+        // Streamed terrain reads <heightmap>.metile, built on first use
+        if (ImGui::Checkbox("Stream Tiles", &terrain->streamed)) terrain->isInitialized = false;
+        
         ImGui::PopStyleVar();
         ImGui::PopStyleColor();
         ImGui::EndGroup();
@@ -361,6 +368,8 @@ void InspectorPanel::ShowRigidBodyComponent()
         
         ImGui::Checkbox("Static", &rigidBody->isStatic);
         ImGui::Checkbox("Kinematic", &rigidBody->isKinematic);
+        ImGui::Checkbox("Freeze Rotation", &rigidBody->freezeRotation);
+        ImGui::Checkbox("Bullet (CCD)", &rigidBody->isBullet);
         
         ImGui::Spacing();
         RemoveComponentButton<RigidBodyComponent>();
@@ -432,6 +441,7 @@ void InspectorPanel::ShowMaterialSetting(Material& material)
     ImGui::ColorEdit3("Diffuse", glm::value_ptr(material.Diffuse));
     ImGui::ColorEdit3("Specular", glm::value_ptr(material.Specular));
     ImGui::SliderFloat("Shininess", &material.Shininess, 1.0f, 256.0f);
+    ImGui::SliderFloat("Opacity", &material.Opacity, 0.0f, 1.0f);
     
 }
 
@@ -0,0 +1,71 @@
+//
+//  BroadphaseTests.cpp
+//  MyEngine
+//
+//  Created by Priyanshu Kaushik on 19/10/2026.
+//
+
+#include "Test.h"
+#include "Physics/Broadphase.h"
+#include "Physics/Queries.h"
+#include <vector>
+
+namespace {
+
+// Closest proxy box along the ray, the way PhysicsSystem::CastRay narrows maxDistance
+Entity FirstHit(const Broadphase& broadphase, const std::vector<glm::vec3>& mins, const std::vector<glm::vec3>& maxs,
+                const glm::vec3& origin, const glm::vec3& direction, float maxDistance)
+{
+    Entity first = UINT32_MAX;
+    broadphase.Raycast(origin, direction, maxDistance, [&](Entity entity) {
+        float distance;
+        if (Queries::RayAABB(origin, direction, maxDistance, mins[entity], maxs[entity], distance))
+        {
+            first = entity;
+            maxDistance = distance;
+        }
+        return maxDistance;
+    });
+    return first;
+}
+
+// Small boxes (0.2 unit cells) near the origin and two far out along +X: the walk to either
+// crosses more than MAX_RAY_CELLS cells and has to fall back to the proxy scan
+void LongRayHitsFarProxy()
+{
+    Broadphase broadphase;
+    std::vector<glm::vec3> mins, maxs;
+    auto add = [&](const glm::vec3& center, float half) {
+        Entity entity = (Entity)mins.size();
+        mins.push_back(center - glm::vec3(half));
+        maxs.push_back(center + glm::vec3(half));
+        broadphase.SetProxy(entity, mins.back(), maxs.back(), false);
+        return entity;
+    };
+
+    for (int i = 0; i < 16; i++) add(glm::vec3((float)(i % 4), 5.0f, (float)(i / 4)), 0.05f);
+    float farX = 4.0f * Broadphase::MAX_RAY_CELLS * 0.2f;
+    Entity far = add(glm::vec3(farX, 0.0f, 0.0f), 0.05f);
+    Entity nearer = add(glm::vec3(0.5f * farX, 0.0f, 0.0f), 0.05f);
+
+    CHECK(broadphase.BuildGrid());
+    CHECK(0.5f * farX / broadphase.GetCellSize() > Broadphase::MAX_RAY_CELLS);
+
+    glm::vec3 direction(1.0f, 0.0f, 0.0f);
+    CHECK(FirstHit(broadphase, mins, maxs, glm::vec3(-1.0f, 0.0f, 0.0f), direction, 2.0f * farX) == nearer);
+    // Starting past the nearer box
+    CHECK(FirstHit(broadphase, mins, maxs, glm::vec3(0.5f * farX + 1.0f, 0.0f, 0.0f), direction, 2.0f * farX) == far);
+    // Too short to reach either
+    CHECK(FirstHit(broadphase, mins, maxs, glm::vec3(-1.0f, 0.0f, 0.0f), direction, 0.25f * farX) == UINT32_MAX);
+}
+
+}
+
+namespace Test {
+
+void RunBroadphase()
+{
+    LongRayHitsFarProxy();
+}
+
+}
@@ -0,0 +1,30 @@
+//
+//  Test.h
+//  MyEngine
+//
+//  Created by Priyanshu Kaushik on 19/10/2026.
+//
+
+#pragma once
+#include <cstdio>
+
+/**
+ * @brief Checks of the MyEngineTests target (CMake option MYENGINE_BUILD_TESTS, run by ctest).
+ * A failed CHECK prints its expression and fails the run; the remaining checks still run.
+ */
+namespace Test {
+
+extern int failures;
+
+// SUITES
+void RunBroadphase();
+
+}
+
+#define CHECK(expression) \
+    do { \
+        if (!(expression)) { \
+            std::printf("%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #expression); \
+            Test::failures++; \
+        } \
+    } while (0)
@@ -0,0 +1,19 @@
+//
+//  TestMain.cpp
+//  MyEngine
+//
+//  Created by Priyanshu Kaushik on 19/10/2026.
+//
+
+#include "Test.h"
+
+int Test::failures = 0;
+
+int main()
+{
+    Test::RunBroadphase();
+
+    if (Test::failures > 0) std::printf("%d check(s) failed\n", Test::failures);
+    else std::printf("all checks passed\n");
+    return Test::failures > 0 ? 1 : 0;
+}